@@ -0,0 +1,317 @@
+#include "ClusteredLighting.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define CLUSTERED_LIGHTING_SSE 1
+#include <emmintrin.h>
+#endif
+
+const unsigned int ClusteredLighting::GridX;
+const unsigned int ClusteredLighting::GridY;
+const unsigned int ClusteredLighting::GridZ;
+const unsigned int ClusteredLighting::ClusterCount;
+
+namespace {
+    // Side plane through the eye, signed distance = x * lateral + depth * forward, positive on the +NDC side
+    struct TilePlane {
+        float lateral, forward;
+    };
+
+    // Planes between the tiles of one axis, index 0 and tiles are the frustum sides
+    void tilePlanes(float projectionScale, unsigned int tiles, std::vector<TilePlane>& planes) {
+        planes.resize(tiles + 1);
+        for (unsigned int b = 0; b <= tiles; ++b) {
+            float ndc = -1.0f + 2.0f * b / tiles;
+            float inverseLength = 1.0f / std::sqrt(projectionScale * projectionScale + ndc * ndc);
+            planes[b] = { projectionScale * inverseLength, -ndc * inverseLength };
+        }
+    }
+
+    int sliceOf(float depth, const glm::vec2& parameters) {
+        int slice = static_cast<int>(std::floor(std::log(depth) * parameters.x + parameters.y));
+        return std::min(std::max(slice, 0), static_cast<int>(ClusteredLighting::GridZ) - 1);
+    }
+}
+
+void ClusteredLighting::initialize() {
+    GLuint buffers[3], textures[3];
+    glGenBuffers(3, buffers);
+    glGenTextures(3, textures);
+    lightBuffer = buffers[0];
+    clusterBuffer = buffers[1];
+    indexBuffer = buffers[2];
+    lightTexture = textures[0];
+    clusterTexture = textures[1];
+    indexTexture = textures[2];
+
+    // Every cluster starts out empty so shading works before the first update
+    clusters.assign(ClusterCount * 2, 0u);
+    uint32_t noIndex = 0;
+    glm::vec4 noLight(0.0f);
+    upload(lightBuffer, lightCapacity, &noLight, sizeof(noLight));
+    upload(clusterBuffer, clusterCapacity, clusters.data(), clusters.size() * sizeof(uint32_t));
+    upload(indexBuffer, indexCapacity, &noIndex, sizeof(noIndex));
+
+    glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, lightBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, clusterTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, clusterBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, indexBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    sliceIndices.resize(GridZ);
+    clusterCursors.resize(ClusterCount);
+}
+
+void ClusteredLighting::cleanup() {
+    GLuint buffers[3] = { lightBuffer, clusterBuffer, indexBuffer };
+    GLuint textures[3] = { lightTexture, clusterTexture, indexTexture };
+    glDeleteTextures(3, textures);
+    glDeleteBuffers(3, buffers);
+    lightBuffer = clusterBuffer = indexBuffer = 0;
+    lightTexture = clusterTexture = indexTexture = 0;
+    lightCapacity = clusterCapacity = indexCapacity = 0;
+}
+
+glm::vec2 ClusteredLighting::sliceParameters(float nearClip, float farClip) {
+    float scale = GridZ / std::log(farClip / nearClip);
+    return glm::vec2(scale, -std::log(nearClip) * scale);
+}
+
+void ClusteredLighting::update(const PointLight* lights, size_t count, const glm::mat4& view, const glm::mat4& projection, float nearClip, float farClip) {
+    ClusterView single = { view, projection, nearClip, farClip };
+    update(lights, count, &single, 1);
+}
+
+void ClusteredLighting::update(const PointLight* lights, size_t count, const ClusterView* views, size_t viewCount) {
+    clusters.resize(ClusterCount * 2 * viewCount);
+    lightTexels.clear();
+    indices.clear();
+    viewLightCounts.resize(viewCount);
+    for (size_t v = 0; v < viewCount; ++v)
+        assignView(lights, count, views[v], v);
+
+    // Buffer textures must never be empty
+    glm::vec4 noLight(0.0f);
+    uint32_t noIndex = 0;
+    upload(lightBuffer, lightCapacity, lightTexels.empty() ? &noLight : lightTexels.data(),
+        std::max<size_t>(lightTexels.size(), 1) * sizeof(glm::vec4));
+    upload(clusterBuffer, clusterCapacity, clusters.data(), clusters.size() * sizeof(uint32_t));
+    upload(indexBuffer, indexCapacity, indices.empty() ? &noIndex : indices.data(),
+        std::max<size_t>(indices.size(), 1) * sizeof(uint32_t));
+}
+
+void ClusteredLighting::assignView(const PointLight* lights, size_t count, const ClusterView& view, size_t viewIndex) {
+    float nearClip = view.nearClip, farClip = view.farClip;
+
+    // View space, depth is the distance in front of the camera
+    viewX.resize(count);
+    viewY.resize(count);
+    depth.resize(count);
+    radius.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec4 p = view.view * glm::vec4(lights[i].position, 1.0f);
+        viewX[i] = p.x;
+        viewY[i] = p.y;
+        depth[i] = -p.z;
+        radius[i] = lights[i].radius;
+    }
+
+    computeTileBounds(view.projection, nearClip, count);
+
+    // Depth range and compaction of the lights that survived the side planes, after the previous views' lights
+    glm::vec2 parameters = sliceParameters(nearClip, farClip);
+    uint32_t lightBase = static_cast<uint32_t>(lightTexels.size() / 2);
+    bounds.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const int32_t* tile = &tileBounds[i * 4];
+        if (tile[0] < 0 || depth[i] + radius[i] < nearClip || depth[i] - radius[i] > farClip)
+            continue;
+
+        LightBounds light;
+        light.minX = static_cast<uint8_t>(tile[0]);
+        light.maxX = static_cast<uint8_t>(tile[1]);
+        light.minY = static_cast<uint8_t>(tile[2]);
+        light.maxY = static_cast<uint8_t>(tile[3]);
+        light.minZ = static_cast<uint8_t>(sliceOf(std::max(depth[i] - radius[i], nearClip), parameters));
+        light.maxZ = static_cast<uint8_t>(sliceOf(std::min(depth[i] + radius[i], farClip), parameters));
+        bounds.push_back(light);
+        lightTexels.push_back(glm::vec4(lights[i].position, lights[i].radius));
+        lightTexels.push_back(glm::vec4(lights[i].color * lights[i].intensity, 0.0f));
+    }
+    viewLightCounts[viewIndex] = bounds.size();
+
+    // Slices are independent, each thread fills whole slices
+    uint32_t* viewClusters = &clusters[viewIndex * ClusterCount * 2];
+    ThreadPool::instance().parallelFor(GridZ, [this, viewClusters, lightBase](size_t begin, size_t end) {
+        for (size_t slice = begin; slice < end; ++slice)
+            buildSlice(static_cast<unsigned int>(slice), viewClusters, lightBase);
+    });
+
+    // Concatenate the slices, cluster offsets were relative to their slice
+    const unsigned int sliceClusters = GridX * GridY;
+    size_t total = indices.size();
+    for (const std::vector<uint32_t>& slice : sliceIndices)
+        total += slice.size();
+    uint32_t base = static_cast<uint32_t>(indices.size());
+    indices.resize(total);
+    for (unsigned int slice = 0; slice < GridZ; ++slice) {
+        const std::vector<uint32_t>& sliceList = sliceIndices[slice];
+        if (!sliceList.empty())
+            std::memcpy(indices.data() + base, sliceList.data(), sliceList.size() * sizeof(uint32_t));
+        for (unsigned int c = slice * sliceClusters; c < (slice + 1) * sliceClusters; ++c)
+            viewClusters[c * 2] += base;
+        base += static_cast<uint32_t>(sliceList.size());
+    }
+}
+
+void ClusteredLighting::computeTileBounds(const glm::mat4& projection, float nearClip, size_t count) {
+    std::vector<TilePlane> planesX, planesY;
+    tilePlanes(projection[0][0], GridX, planesX);
+    tilePlanes(projection[1][1], GridY, planesY);
+    tileBounds.resize(count * 4);
+
+    // Counting planes the sphere lies fully beyond only works while the sphere is in front of the eye,
+    // spheres reaching behind the near plane get the whole screen
+    auto scalarBounds = [&](size_t i) {
+        float x = viewX[i], y = viewY[i], d = depth[i], r = radius[i];
+        int32_t* tile = &tileBounds[i * 4];
+        int right = 0, left = 0, above = 0, below = 0;
+        bool outside = false;
+        for (unsigned int b = 0; b <= GridX; ++b) {
+            float distance = planesX[b].lateral * x + planesX[b].forward * d;
+            if (b == 0) outside |= distance < -r;
+            else if (b == GridX) outside |= distance > r;
+            else { right += distance > r; left += distance < -r; }
+        }
+        for (unsigned int b = 0; b <= GridY; ++b) {
+            float distance = planesY[b].lateral * y + planesY[b].forward * d;
+            if (b == 0) outside |= distance < -r;
+            else if (b == GridY) outside |= distance > r;
+            else { above += distance > r; below += distance < -r; }
+        }
+        bool crossesNear = d - r < nearClip;
+        tile[0] = outside ? -1 : crossesNear ? 0 : right;
+        tile[1] = crossesNear ? GridX - 1 : GridX - 1 - left;
+        tile[2] = crossesNear ? 0 : above;
+        tile[3] = crossesNear ? GridY - 1 : GridY - 1 - below;
+    };
+
+    size_t i = 0;
+#ifdef CLUSTERED_LIGHTING_SSE
+    // Four lights per step, each plane comparison becomes a lane mask that is subtracted from the counters
+    const __m128 nearValue = _mm_set1_ps(nearClip);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(&viewX[i]);
+        __m128 y = _mm_loadu_ps(&viewY[i]);
+        __m128 d = _mm_loadu_ps(&depth[i]);
+        __m128 r = _mm_loadu_ps(&radius[i]);
+        __m128 negativeR = _mm_sub_ps(zero, r);
+
+        __m128i right = _mm_setzero_si128(), left = _mm_setzero_si128();
+        __m128i above = _mm_setzero_si128(), below = _mm_setzero_si128();
+        __m128 outside = _mm_setzero_ps();
+        for (unsigned int b = 0; b <= GridX; ++b) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planesX[b].lateral), x), _mm_mul_ps(_mm_set1_ps(planesX[b].forward), d));
+            if (b == 0) outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeR));
+            else if (b == GridX) outside = _mm_or_ps(outside, _mm_cmpgt_ps(distance, r));
+            else {
+                right = _mm_sub_epi32(right, _mm_castps_si128(_mm_cmpgt_ps(distance, r)));
+                left = _mm_sub_epi32(left, _mm_castps_si128(_mm_cmplt_ps(distance, negativeR)));
+            }
+        }
+        for (unsigned int b = 0; b <= GridY; ++b) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planesY[b].lateral), y), _mm_mul_ps(_mm_set1_ps(planesY[b].forward), d));
+            if (b == 0) outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeR));
+            else if (b == GridY) outside = _mm_or_ps(outside, _mm_cmpgt_ps(distance, r));
+            else {
+                above = _mm_sub_epi32(above, _mm_castps_si128(_mm_cmpgt_ps(distance, r)));
+                below = _mm_sub_epi32(below, _mm_castps_si128(_mm_cmplt_ps(distance, negativeR)));
+            }
+        }
+
+        // Spheres crossing the near plane keep the full range
+        __m128i crossesNear = _mm_castps_si128(_mm_cmplt_ps(_mm_sub_ps(d, r), nearValue));
+        __m128i lastX = _mm_set1_epi32(GridX - 1), lastY = _mm_set1_epi32(GridY - 1);
+        __m128i minX = _mm_andnot_si128(crossesNear, right);
+        __m128i maxX = _mm_or_si128(_mm_and_si128(crossesNear, lastX), _mm_andnot_si128(crossesNear, _mm_sub_epi32(lastX, left)));
+        __m128i minY = _mm_andnot_si128(crossesNear, above);
+        __m128i maxY = _mm_or_si128(_mm_and_si128(crossesNear, lastY), _mm_andnot_si128(crossesNear, _mm_sub_epi32(lastY, below)));
+        minX = _mm_or_si128(minX, _mm_castps_si128(outside)); // -1 marks a culled light
+
+        int32_t lanes[4][4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes[0]), minX);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes[1]), maxX);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes[2]), minY);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes[3]), maxY);
+        for (int lane = 0; lane < 4; ++lane) {
+            for (int k = 0; k < 4; ++k)
+                tileBounds[(i + lane) * 4 + k] = lanes[k][lane];
+        }
+    }
+#endif
+    for (; i < count; ++i)
+        scalarBounds(i);
+}
+
+void ClusteredLighting::buildSlice(unsigned int slice, uint32_t* viewClusters, uint32_t lightBase) {
+    const unsigned int sliceClusters = GridX * GridY;
+    uint32_t* sliceRanges = &viewClusters[slice * sliceClusters * 2];
+    uint32_t* cursors = &clusterCursors[slice * sliceClusters];
+    std::fill(cursors, cursors + sliceClusters, 0u);
+
+    // Count, prefix sum, then fill, so the slice's index list is allocated once
+    for (const LightBounds& light : bounds) {
+        if (slice < light.minZ || slice > light.maxZ)
+            continue;
+        for (unsigned int y = light.minY; y <= light.maxY; ++y) {
+            for (unsigned int x = light.minX; x <= light.maxX; ++x)
+                ++cursors[y * GridX + x];
+        }
+    }
+
+    uint32_t offset = 0;
+    for (unsigned int c = 0; c < sliceClusters; ++c) {
+        sliceRanges[c * 2] = offset;
+        sliceRanges[c * 2 + 1] = cursors[c];
+        offset += cursors[c];
+        cursors[c] = sliceRanges[c * 2];
+    }
+
+    std::vector<uint32_t>& sliceList = sliceIndices[slice];
+    sliceList.resize(offset);
+    for (size_t l = 0; l < bounds.size(); ++l) {
+        const LightBounds& light = bounds[l];
+        if (slice < light.minZ || slice > light.maxZ)
+            continue;
+        for (unsigned int y = light.minY; y <= light.maxY; ++y) {
+            for (unsigned int x = light.minX; x <= light.maxX; ++x)
+                sliceList[cursors[y * GridX + x]++] = lightBase + static_cast<uint32_t>(l);
+        }
+    }
+}
+
+void ClusteredLighting::bind(GLuint firstUnit) const {
+    glActiveTexture(GL_TEXTURE0 + firstUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+    glActiveTexture(GL_TEXTURE0 + firstUnit + 1);
+    glBindTexture(GL_TEXTURE_BUFFER, clusterTexture);
+    glActiveTexture(GL_TEXTURE0 + firstUnit + 2);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void ClusteredLighting::upload(GLuint buffer, size_t& capacity, const void* data, size_t size) {
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    if (size > capacity)
+        capacity = std::max(size, capacity * 2);
+    // Orphan last frame's storage so the driver does not wait for it
+    glBufferData(GL_TEXTURE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
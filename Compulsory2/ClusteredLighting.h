@@ -0,0 +1,85 @@
+#ifndef CLUSTERED_LIGHTING_H
+#define CLUSTERED_LIGHTING_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Point light in world space
+struct PointLight {
+    glm::vec3 position;
+    float radius;    // Contribution fades to zero at this distance
+    glm::vec3 color;
+    float intensity;
+};
+
+// Camera of one view the lights are assigned for
+struct ClusterView {
+    glm::mat4 view;
+    glm::mat4 projection;
+    float nearClip, farClip;
+};
+
+// Clustered forward shading: the view frustum is cut into a GridX * GridY screen tiles by GridZ
+// exponential depth slices, every visible light is assigned to the clusters its sphere touches, and
+// the fragment shader only loops over the lights of its own cluster.
+// Per frame the lights, the (offset, count) of every cluster and the compact index list are uploaded
+// to buffer textures bound on units firstUnit .. firstUnit + 2.
+// Several views share the textures: view v's clusters follow the ClusterCount clusters of view v - 1,
+// with their own light and index lists appended after the previous view's.
+class ClusteredLighting {
+public:
+    static const unsigned int GridX = 16;
+    static const unsigned int GridY = 9;
+    static const unsigned int GridZ = 24;
+    static const unsigned int ClusterCount = GridX * GridY * GridZ;
+
+    void initialize();
+    void cleanup();
+
+    // Culls and assigns lights for the camera described by view and projection, then uploads the result
+    void update(const PointLight* lights, size_t count, const glm::mat4& view, const glm::mat4& projection, float nearClip, float farClip);
+    // Same for every view at once, the shader offsets its cluster index by view * ClusterCount
+    void update(const PointLight* lights, size_t count, const ClusterView* views, size_t viewCount);
+
+    // Binds the three buffer textures, the shader samplers must use the same units
+    void bind(GLuint firstUnit) const;
+
+    // Shader maps view depth to a slice with floor(log(depth) * scale + bias)
+    static glm::vec2 sliceParameters(float nearClip, float farClip);
+
+    // Summed over the views of the last update
+    size_t getVisibleLightCount() const { return lightTexels.size() / 2; }
+    size_t getVisibleLightCount(size_t view) const { return view < viewLightCounts.size() ? viewLightCounts[view] : 0; }
+    size_t getIndexCount() const { return indices.size(); }
+
+private:
+    // Inclusive cluster ranges of one visible light
+    struct LightBounds {
+        uint8_t minX, maxX, minY, maxY, minZ, maxZ;
+    };
+
+    GLuint lightBuffer{ 0 }, clusterBuffer{ 0 }, indexBuffer{ 0 };
+    GLuint lightTexture{ 0 }, clusterTexture{ 0 }, indexTexture{ 0 };
+    size_t lightCapacity{ 0 }, clusterCapacity{ 0 }, indexCapacity{ 0 }; // Bytes
+
+    // Reused every frame
+    std::vector<float> viewX, viewY, depth, radius; // View space, depth grows away from the camera
+    std::vector<int32_t> tileBounds;                 // minX, maxX, minY, maxY per light, -1 when culled
+    std::vector<LightBounds> bounds;
+    std::vector<glm::vec4> lightTexels;              // (position, radius), (color * intensity, 0)
+    std::vector<uint32_t> clusters;                  // (offset, count) per cluster
+    std::vector<uint32_t> clusterCursors;
+    std::vector<std::vector<uint32_t>> sliceIndices; // Light indices of one depth slice, merged into indices
+    std::vector<uint32_t> indices;
+    std::vector<size_t> viewLightCounts;
+
+    // Appends one view's lights, clusters and indices
+    void assignView(const PointLight* lights, size_t count, const ClusterView& view, size_t viewIndex);
+    void computeTileBounds(const glm::mat4& projection, float nearClip, size_t count);
+    void buildSlice(unsigned int slice, uint32_t* viewClusters, uint32_t lightBase);
+    static void upload(GLuint buffer, size_t& capacity, const void* data, size_t size);
+};
+
+#endif
@@ -2,9 +2,18 @@
 #define COMPONENT_MANAGER_H
 
 #include "Components.h"
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 
+// References to one component type's storage
+template <typename T>
+struct ComponentPool {
+    std::vector<unsigned int>& entityIDs;
+    std::vector<T>& components;
+    std::unordered_map<unsigned int, size_t>& indices;
+};
+
 // Component allocation and management
 class ComponentManager {
 public:
@@ -30,6 +39,18 @@ public:
     std::vector<unsigned int> pickupEntityIDs;
     std::vector<Pickup> pickups;
 
+    std::vector<unsigned int> renderableEntityIDs;
+    std::vector<Renderable> renderables;
+
+    std::vector<unsigned int> transformEntityIDs;
+    std::vector<Transform> transforms;
+
+    std::vector<unsigned int> lightEmitterEntityIDs;
+    std::vector<LightEmitter> lightEmitters;
+
+    // Bumped whenever transforms are added, removed or re-parented, TransformSystem rebuilds its order then
+    unsigned int transformHierarchyVersion{ 0 };
+
     // Maps for quick component lookup by entity ID
     std::unordered_map<unsigned int, size_t> positionIndices;
     std::unordered_map<unsigned int, size_t> velocityIndices;
@@ -38,6 +59,9 @@ public:
     std::unordered_map<unsigned int, size_t> inventoryIndices;
     std::unordered_map<unsigned int, size_t> aiIndices;
     std::unordered_map<unsigned int, size_t> pickupIndices;
+    std::unordered_map<unsigned int, size_t> renderableIndices;
+    std::unordered_map<unsigned int, size_t> transformIndices;
+    std::unordered_map<unsigned int, size_t> lightEmitterIndices;
 
     // Add Component Methods
     void addComponent(unsigned int entityID, const Position& position) {
@@ -82,6 +106,35 @@ public:
         pickupIndices[entityID] = pickups.size() - 1;
     }
 
+    void addComponent(unsigned int entityID, const Renderable& renderable) {
+        renderableEntityIDs.push_back(entityID);
+        renderables.push_back(renderable);
+        renderableIndices[entityID] = renderables.size() - 1;
+    }
+
+    void addComponent(unsigned int entityID, const Transform& transform) {
+        transformEntityIDs.push_back(entityID);
+        transforms.push_back(transform);
+        transformIndices[entityID] = transforms.size() - 1;
+        ++transformHierarchyVersion;
+    }
+
+    void addComponent(unsigned int entityID, const LightEmitter& lightEmitter) {
+        lightEmitterEntityIDs.push_back(entityID);
+        lightEmitters.push_back(lightEmitter);
+        lightEmitterIndices[entityID] = lightEmitters.size() - 1;
+    }
+
+    // Attaches child's Transform to parent's, Transform::NoParent detaches it
+    void setParent(unsigned int childEntityID, unsigned int parentEntityID) {
+        Transform* child = getTransform(childEntityID);
+        if (!child)
+            return;
+        child->parent = parentEntityID;
+        child->dirty = true;
+        ++transformHierarchyVersion;
+    }
+
     // Get Component Methods
     Position* getPosition(unsigned int entityID) {
         auto it = positionIndices.find(entityID);
@@ -139,6 +192,66 @@ public:
         return nullptr;
     }
 
+    Renderable* getRenderable(unsigned int entityID) {
+        auto it = renderableIndices.find(entityID);
+        if (it != renderableIndices.end()) {
+            return &renderables[it->second];
+        }
+        return nullptr;
+    }
+
+    Transform* getTransform(unsigned int entityID) {
+        auto it = transformIndices.find(entityID);
+        if (it != transformIndices.end()) {
+            return &transforms[it->second];
+        }
+        return nullptr;
+    }
+
+    LightEmitter* getLightEmitter(unsigned int entityID) {
+        auto it = lightEmitterIndices.find(entityID);
+        if (it != lightEmitterIndices.end()) {
+            return &lightEmitters[it->second];
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    ComponentPool<T> pool();
+
+    // Calls fn(entityID, indexInA, A&, B&) for every entity that has both components.
+    // Pools keep insertion order and entity IDs only grow, so normally this is a merge of two
+    // sorted ID lists without any hashing; out-of-order pools fall back to index lookups.
+    template <typename A, typename B, typename Fn>
+    void view(Fn fn) {
+        ComponentPool<A> a = pool<A>();
+        ComponentPool<B> b = pool<B>();
+
+        if (std::is_sorted(a.entityIDs.begin(), a.entityIDs.end()) && std::is_sorted(b.entityIDs.begin(), b.entityIDs.end())) {
+            size_t i = 0, j = 0;
+            while (i < a.entityIDs.size() && j < b.entityIDs.size()) {
+                if (a.entityIDs[i] < b.entityIDs[j]) {
+                    ++i;
+                }
+                else if (b.entityIDs[j] < a.entityIDs[i]) {
+                    ++j;
+                }
+                else {
+                    fn(a.entityIDs[i], i, a.components[i], b.components[j]);
+                    ++i;
+                    ++j;
+                }
+            }
+            return;
+        }
+
+        for (size_t j = 0; j < b.entityIDs.size(); ++j) {
+            auto it = a.indices.find(b.entityIDs[j]);
+            if (it != a.indices.end())
+                fn(b.entityIDs[j], it->second, a.components[it->second], b.components[j]);
+        }
+    }
+
     // Remove Component Methods
     void removePosition(unsigned int entityID) {
         auto it = positionIndices.find(entityID);
@@ -200,6 +313,21 @@ public:
         }
     }
 
+    void removeInventory(unsigned int entityID) {
+        auto it = inventoryIndices.find(entityID);
+        if (it != inventoryIndices.end()) {
+            size_t index = it->second;
+            inventories.erase(inventories.begin() + index);
+            inventoryEntityIDs.erase(inventoryEntityIDs.begin() + index);
+            inventoryIndices.erase(it);
+
+            // Update indices
+            for (size_t i = index; i < inventories.size(); ++i) {
+                inventoryIndices[inventoryEntityIDs[i]] = i;
+            }
+        }
+    }
+
     void removeAI(unsigned int entityID) {
         auto it = aiIndices.find(entityID);
         if (it != aiIndices.end()) {
@@ -229,5 +357,94 @@ public:
             }
         }
     }
+
+    void removeRenderable(unsigned int entityID) {
+        auto it = renderableIndices.find(entityID);
+        if (it != renderableIndices.end()) {
+            size_t index = it->second;
+            renderables.erase(renderables.begin() + index);
+            renderableEntityIDs.erase(renderableEntityIDs.begin() + index);
+            renderableIndices.erase(it);
+
+            // Update indices
+            for (size_t i = index; i < renderables.size(); ++i) {
+                renderableIndices[renderableEntityIDs[i]] = i;
+            }
+        }
+    }
+
+    void removeLightEmitter(unsigned int entityID) {
+        auto it = lightEmitterIndices.find(entityID);
+        if (it != lightEmitterIndices.end()) {
+            size_t index = it->second;
+            lightEmitters.erase(lightEmitters.begin() + index);
+            lightEmitterEntityIDs.erase(lightEmitterEntityIDs.begin() + index);
+            lightEmitterIndices.erase(it);
+
+            // Update indices
+            for (size_t i = index; i < lightEmitters.size(); ++i) {
+                lightEmitterIndices[lightEmitterEntityIDs[i]] = i;
+            }
+        }
+    }
+
+    // Children of a removed transform become roots
+    void removeTransform(unsigned int entityID) {
+        auto it = transformIndices.find(entityID);
+        if (it != transformIndices.end()) {
+            size_t index = it->second;
+            transforms.erase(transforms.begin() + index);
+            transformEntityIDs.erase(transformEntityIDs.begin() + index);
+            transformIndices.erase(it);
+
+            // Update indices
+            for (size_t i = index; i < transforms.size(); ++i) {
+                transformIndices[transformEntityIDs[i]] = i;
+            }
+            for (Transform& transform : transforms) {
+                if (transform.parent == entityID) {
+                    transform.parent = Transform::NoParent;
+                    transform.dirty = true;
+                }
+            }
+            ++transformHierarchyVersion;
+        }
+    }
+
+    // Removes every component of a destroyed entity, entities attached below it are destroyed with it
+    void removeEntity(unsigned int entityID) {
+        std::vector<unsigned int> children;
+        for (size_t i = 0; i < transforms.size(); ++i) {
+            if (transforms[i].parent == entityID)
+                children.push_back(transformEntityIDs[i]);
+        }
+
+        removePosition(entityID);
+        removeVelocity(entityID);
+        removeHealth(entityID);
+        removeDamage(entityID);
+        removeInventory(entityID);
+        removeAI(entityID);
+        removePickup(entityID);
+        removeRenderable(entityID);
+        removeLightEmitter(entityID);
+        removeTransform(entityID);
+
+        // After removeTransform, so a cycle cannot lead back here
+        for (unsigned int child : children)
+            removeEntity(child);
+    }
 };
+
+template <> inline ComponentPool<Position> ComponentManager::pool<Position>() { return { positionEntityIDs, positions, positionIndices }; }
+template <> inline ComponentPool<Velocity> ComponentManager::pool<Velocity>() { return { velocityEntityIDs, velocities, velocityIndices }; }
+template <> inline ComponentPool<Health> ComponentManager::pool<Health>() { return { healthEntityIDs, healths, healthIndices }; }
+template <> inline ComponentPool<Damage> ComponentManager::pool<Damage>() { return { damageEntityIDs, damages, damageIndices }; }
+template <> inline ComponentPool<Inventory> ComponentManager::pool<Inventory>() { return { inventoryEntityIDs, inventories, inventoryIndices }; }
+template <> inline ComponentPool<AI> ComponentManager::pool<AI>() { return { aiEntityIDs, ais, aiIndices }; }
+template <> inline ComponentPool<Pickup> ComponentManager::pool<Pickup>() { return { pickupEntityIDs, pickups, pickupIndices }; }
+template <> inline ComponentPool<Renderable> ComponentManager::pool<Renderable>() { return { renderableEntityIDs, renderables, renderableIndices }; }
+template <> inline ComponentPool<Transform> ComponentManager::pool<Transform>() { return { transformEntityIDs, transforms, transformIndices }; }
+template <> inline ComponentPool<LightEmitter> ComponentManager::pool<LightEmitter>() { return { lightEmitterEntityIDs, lightEmitters, lightEmitterIndices }; }
+
 #endif
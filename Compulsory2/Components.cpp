@@ -1 +1,3 @@
 #include "Components.h"
+
+const unsigned int Transform::NoParent;
@@ -3,11 +3,16 @@
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+class GPUMeshLOD;
 
 // Base Arbitrary Component class
+// Not polymorphic: components stay plain data so pools can be uploaded to the GPU as-is
 class Component {
-public:
-    virtual ~Component() {}
 };
 
 // Position Component (2D)
@@ -66,5 +71,48 @@ public:
         : itemName(itemName) {}
 };
 
+// Renderable Component, drawn at the entity's Position by RenderSystem
+class Renderable : public Component {
+public:
+    std::shared_ptr<GPUMeshLOD> mesh; // Single meshes are one-level chains
+    glm::vec4 tint;                   // Multiplies the mesh's base color
+    float scale;
+
+    Renderable(const std::shared_ptr<GPUMeshLOD>& mesh, const glm::vec4& tint = glm::vec4(1.f), float scale = 1.f)
+        : mesh(mesh), tint(tint), scale(scale) {}
+};
+
+// LightEmitter Component, a point light at the entity's Position gathered by RenderSystem
+class LightEmitter : public Component {
+public:
+    glm::vec3 color;
+    float radius;    // Light reaches zero at this distance
+    float intensity;
+    float height;    // Above the ground plane
+
+    LightEmitter(const glm::vec3& color = glm::vec3(1.f), float radius = 5.f, float intensity = 1.f, float height = 0.5f)
+        : color(color), radius(radius), intensity(intensity), height(height) {}
+};
+
+// Transform Component (3D), local TRS relative to the parent entity.
+// TransformSystem caches the world matrix and only recomputes it when this node or a parent changed.
+class Transform : public Component {
+public:
+    static const unsigned int NoParent = ~0u;
+
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+    unsigned int parent;  // Entity ID, set through ComponentManager::setParent
+    glm::mat4 world;      // Valid after TransformSystem::Update
+    bool dirty;           // Local TRS changed since the last update
+
+    Transform(const glm::vec3& position = glm::vec3(0.f), const glm::quat& rotation = glm::quat(1.f, 0.f, 0.f, 0.f), const glm::vec3& scale = glm::vec3(1.f))
+        : position(position), rotation(rotation), scale(scale), parent(NoParent), world(1.f), dirty(true) {}
+
+    void setPosition(const glm::vec3& value) { position = value; dirty = true; }
+    void setRotation(const glm::quat& value) { rotation = value; dirty = true; }
+    void setScale(const glm::vec3& value) { scale = value; dirty = true; }
+};
 
 #endif
@@ -3,13 +3,32 @@
 #include "Renderer.h"
 #include "PrimitiveGenerator.h"
 #include "Camera.h"
-#include "WorldObject.h"
 #include "Components.h"
 #include "EntityManager.h"
 #include "ComponentManager.h"
 #include "Systems.h"
 #include "UIManager.h"
 #include "Level.h"
+#include "MeshPack.h"
+#include "GLExtensions.h"
+#include "GPUCulling.h"
+#include "MeshLOD.h"
+#include "RenderGraph.h"
+#include "Terrain.h"
+#include "HealthBars.h"
+#include "DebugDraw.h"
+#include "FrameCapture.h"
+#include "NullGL.h"
+#include "GLTrace.h"
+#include "FramePacer.h"
+#include "MultiView.h"
+#include "SoftwareRenderer.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 
@@ -17,31 +36,498 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
+namespace {
+    // Prefers a 4.3 core context for GPU culling and drops back to the 3.3 baseline, loads GL on success
+    GLFWwindow* createWindow(const char* title, bool visible) {
+        glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+        const int versions[2][2] = { { 4, 3 }, { 3, 3 } };
+        GLFWwindow* window = nullptr;
+        for (const int* version : versions) {
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version[0]);
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version[1]);
+            window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, title, nullptr, nullptr);
+            if (window)
+                break;
+        }
+        if (!window) {
+            std::cout << "Failed to create GLFW window\n";
+            return nullptr;
+        }
+        glfwMakeContextCurrent(window);
+
+        // Initialize GLAD
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            std::cout << "Failed to initialize GLAD\n";
+            glfwDestroyWindow(window);
+            return nullptr;
+        }
+        GLExtensions::load();
+        return window;
+    }
+
+    Mesh3D createPlayerMesh() {
+        return PrimitiveGenerator::createBox(1.0f, 2.0f, 1.0f, glm::vec3(0.f, 0.f, 1.f));
+    }
+
+    Mesh3D createWeaponMesh() {
+        return PrimitiveGenerator::createBox(0.15f, 1.2f, 0.15f, glm::vec3(0.7f, 0.7f, 0.75f));
+    }
+
+    // Offline step, writes every mesh the game uses to a pack and exits without opening a window
+    int cookMeshPack(const char* path) {
+        MeshPackWriter writer;
+        writer.addMesh("player", { createPlayerMesh() });
+        writer.addMesh("weapon", { createWeaponMesh() });
+        Level::cookMeshes(writer);
+        return writer.write(path) ? 0 : -1;
+    }
+
+    // Times TransformBatch on count yaw + uniform scale transforms, no window needed
+    int benchmarkTransforms(size_t count) {
+        std::mt19937 rng(12345);
+        std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
+        std::vector<float> x(count), z(count), yaw(count), scale(count);
+        for (size_t i = 0; i < count; ++i) {
+            x[i] = dist(rng);
+            z[i] = dist(rng);
+            yaw[i] = dist(rng);
+            scale[i] = 1.0f + dist(rng) * 0.01f;
+        }
+
+        TransformSoA input;
+        input.x = x.data();
+        input.z = z.data();
+        input.yaw = yaw.data();
+        input.scale = scale.data();
+        input.count = count;
+        std::vector<InstanceData> output(count);
+
+        using Clock = std::chrono::high_resolution_clock;
+        for (int run = 0; run < 2; ++run) {
+            bool vectorized = run == 0 && TransformBatch::hasAVX2();
+            if (run == 0 && !vectorized)
+                continue;
+            double best = 1e30;
+            for (int repeat = 0; repeat < 5; ++repeat) {
+                Clock::time_point start = Clock::now();
+                if (vectorized)
+                    TransformBatch::compose(input, output.data());
+                else
+                    TransformBatch::composeScalar(input, 0, count, output.data(), ColorRGBA8{ 255, 255, 255, 255 });
+                best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            }
+            std::cout << (vectorized ? "AVX2" : "Scalar") << ": " << count << " transforms in " << best << " ms\n";
+        }
+        return 0;
+    }
+
+    // Keeps count particles alive and times the update, no window needed.
+    // Fails if the pool had to allocate after the first frame.
+    int benchmarkParticles(size_t count) {
+        ParticleEffect effect{ glm::vec3(1.0f), 6.0f, 2.0f, 9.8f, 0.05f, 0, count };
+        ParticlePool pool(count);
+        std::mt19937 rng(12345);
+        const float* storage = pool.x.data();
+
+        using Clock = std::chrono::high_resolution_clock;
+        const float deltaTime = 1.0f / 60.0f;
+        const int frames = 120;
+        double total = 0.0;
+        for (int frame = 0; frame <= frames; ++frame) {
+            // Top the pool back up as particles expire
+            pool.emit(glm::vec3(0.0f, 1.0f, 0.0f), effect, count - pool.size(), rng);
+            Clock::time_point start = Clock::now();
+            pool.update(deltaTime, effect.gravity);
+            if (frame > 0)
+                total += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+        std::cout << "Particles: " << pool.size() << " live after " << frames << " frames, "
+            << total / frames << " ms per update\n";
+        return pool.x.data() == storage ? 0 : -1;
+    }
+
+    // Draws count cubes scattered around the camera through GPUCulling, once culled by the compute shader
+    // and once by the CPU fallback, and checks that both agree. Works on any driver, e.g. Mesa llvmpipe
+    // with LIBGL_ALWAYS_SOFTWARE=1; without GL 4.3 only the fallback is timed.
+    int benchmarkCulling(size_t count) {
+        if (!glfwInit()) {
+            std::cout << "Failed to initialize GLFW\n";
+            return -1;
+        }
+        GLFWwindow* window = createWindow("Culling benchmark", false);
+        if (!window) {
+            glfwTerminate();
+            return -1;
+        }
+
+        int result = 0;
+        {
+            Renderer renderer;
+            renderer.setAspect(SCR_WIDTH, SCR_HEIGHT);
+
+            Mesh3D cubeMesh = PrimitiveGenerator::createCube(1.0f, glm::vec3(1.0f, 0.5f, 0.2f));
+            GPUMesh cube(cubeMesh);
+            GPUCulling culling;
+            culling.initialize();
+            unsigned int mesh = culling.addMesh(cube.getAllocation(), MeshLOD::boundingRadius(cubeMesh));
+
+            std::mt19937 rng(12345);
+            std::uniform_real_distribution<float> dist(-200.0f, 200.0f);
+            for (size_t i = 0; i < count; ++i)
+                culling.addObject(mesh, glm::translate(glm::mat4(1.0f), glm::vec3(dist(rng), 0.0f, dist(rng))), glm::vec4(1.0f));
+
+            Camera camera;
+            camera.position = glm::vec3(0.0f, 10.0f, 10.0f);
+            camera.front = glm::normalize(-camera.position);
+            glEnable(GL_DEPTH_TEST);
+
+            using Clock = std::chrono::high_resolution_clock;
+            const int frames = 50;
+            for (int run = 0; run < 2; ++run) {
+                bool gpu = run == 0;
+                culling.setEnabled(gpu);
+                if (gpu && !culling.isActive())
+                    continue;
+
+                double total = 0.0;
+                for (int frame = 0; frame <= frames; ++frame) {
+                    Clock::time_point start = Clock::now();
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                    renderer.beginFrame(camera);
+                    renderer.drawCulled(culling);
+                    renderer.endFrame();
+                    glFinish();
+                    if (frame > 0) // The first frame uploads the objects
+                        total += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                }
+
+                size_t expected = 0;
+                culling.forEachVisible(renderer.getViewProjection(), [&](const MeshAllocation&, const glm::mat4&, ColorRGBA8) { ++expected; });
+                size_t visible = gpu ? culling.readVisibleCount() : expected;
+                std::cout << (gpu ? "GPU culling" : "CPU culling") << ": " << visible << " of " << count << " visible, "
+                    << total / frames << " ms per frame\n";
+                if (visible != expected) {
+                    std::cout << "Mismatch, CPU reference found " << expected << " visible\n";
+                    result = -1;
+                }
+            }
+
+            culling.cleanup();
+            renderer.cleanup();
+        }
+
+        MeshArena::instance().release();
+        glfwTerminate();
+        return result;
+    }
+
+    // Drives the real Renderer against NullGL, so only the CPU side of submission is timed and no GPU or window
+    // is needed. For 1k objects up to count, each submission path is run for several frames and reported in
+    // nanoseconds per object along with the GL calls it made.
+    int benchmarkSubmission(size_t maxCount) {
+        if (!NullGL::load())
+            return -1;
+
+        Renderer renderer;
+        renderer.setAspect(SCR_WIDTH, SCR_HEIGHT);
+
+        // A few meshes so objects spread over several buckets like in the game
+        std::vector<std::unique_ptr<GPUMesh>> meshes;
+        meshes.emplace_back(new GPUMesh(PrimitiveGenerator::createCube(1.0f, glm::vec3(1.0f, 0.5f, 0.2f))));
+        meshes.emplace_back(new GPUMesh(PrimitiveGenerator::createSphere(0.5f, 8, 12, glm::vec3(0.2f, 0.5f, 1.0f))));
+        meshes.emplace_back(new GPUMesh(PrimitiveGenerator::createCylinder(0.5f, 1.0f, 12, glm::vec3(0.2f, 1.0f, 0.5f))));
+        meshes.emplace_back(new GPUMesh(createPlayerMesh()));
+
+        Camera camera;
+        camera.position = glm::vec3(0.0f, 10.0f, 10.0f);
+        camera.front = glm::normalize(-camera.position);
+        const glm::vec4 color(1.0f);
+        const InstanceStyle style{ 1.0f, packColor(color) };
+
+        using Clock = std::chrono::high_resolution_clock;
+        const char* pathNames[3] = { "submit(matrix)", "submit(TransformSoA)", "drawPositionRange" };
+        for (size_t count = 1000; count <= maxCount; count *= 10) {
+            std::mt19937 rng(12345);
+            std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+            std::vector<float> x(count), z(count), yaw(count);
+            std::vector<Position> positions(count);
+            std::vector<glm::mat4> matrices(count);
+            for (size_t i = 0; i < count; ++i) {
+                x[i] = dist(rng);
+                z[i] = dist(rng);
+                yaw[i] = dist(rng);
+                positions[i] = Position{ x[i], z[i] };
+                matrices[i] = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(x[i], 0.0f, z[i])), yaw[i], glm::vec3(0.0f, 1.0f, 0.0f));
+            }
+
+            // Objects of one mesh are contiguous: [meshFirst[m], meshFirst[m + 1])
+            std::vector<size_t> meshFirst;
+            for (size_t m = 0; m <= meshes.size(); ++m)
+                meshFirst.push_back(count * m / meshes.size());
+
+            // Enough frames for a stable average, the first one is warm-up
+            const int frames = static_cast<int>(std::max<size_t>(3, 2000000 / count));
+            for (int path = 0; path < 3; ++path) {
+                double total = 0.0;
+                for (int frame = 0; frame <= frames; ++frame) {
+                    if (frame == 1)
+                        NullGL::resetCounters();
+                    Clock::time_point start = Clock::now();
+                    renderer.beginFrame(camera);
+                    if (path == 2)
+                        renderer.setPositionStream(positions.data(), count);
+                    for (size_t m = 0; m < meshes.size(); ++m) {
+                        const MeshAllocation& mesh = meshes[m]->getAllocation();
+                        size_t first = meshFirst[m], objects = meshFirst[m + 1] - meshFirst[m];
+                        if (path == 0) {
+                            for (size_t i = first; i < first + objects; ++i)
+                                renderer.submit(mesh, matrices[i], color);
+                        }
+                        else if (path == 1) {
+                            TransformSoA transforms;
+                            transforms.x = x.data() + first;
+                            transforms.z = z.data() + first;
+                            transforms.yaw = yaw.data() + first;
+                            transforms.count = objects;
+                            renderer.submit(mesh, transforms, color);
+                        }
+                        else {
+                            renderer.drawPositionRange(mesh, first, objects, style);
+                        }
+                    }
+                    renderer.endFrame();
+                    if (frame > 0)
+                        total += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                }
+
+                double frameMs = total / frames;
+                std::cout << pathNames[path] << ": " << count << " objects, " << frameMs * 1e6 / count << " ns per object, "
+                    << frameMs << " ms per frame, " << NullGL::getTotalCalls() / frames << " GL calls ("
+                    << NullGL::getDrawCalls() / frames << " draws) per frame\n";
+            }
+        }
+
+        renderer.cleanup();
+        return 0;
+    }
+
+    // Renders a fixed-seed scene with SoftwareRenderer and writes it to path, no GPU or window needed.
+    // The frame is rendered on one thread and on several, with the AVX2 and the scalar kernels,
+    // and fails unless all of them give the same image. Stage timings and counters of each are printed as
+    // a CPU cost model of the scene.
+    int renderSoftware(const char* path) {
+        SoftwareRenderer renderer(SCR_WIDTH, SCR_HEIGHT);
+        MeshAllocation ground = renderer.upload(PrimitiveGenerator::createPlane(48.0f, 48.0f, glm::vec3(0.45f, 0.5f, 0.4f)));
+        MeshAllocation player = renderer.upload(createPlayerMesh());
+        MeshAllocation weapon = renderer.upload(createWeaponMesh());
+        MeshAllocation enemy = renderer.upload(PrimitiveGenerator::createBox(1.0f, 2.0f, 1.0f, glm::vec3(1.f, 0.f, 0.f)));
+        MeshAllocation pickup = renderer.upload(PrimitiveGenerator::createBox(0.5f, 0.5f, 0.5f, glm::vec3(0.f, 1.f, 0.f)));
+        MeshAllocation pillar = renderer.upload(PrimitiveGenerator::createSphere(0.5f, 16, 24, glm::vec3(0.6f, 0.58f, 0.55f)));
+
+        // Enemies and spheres are placed with matrices, pickups through the TransformSoA path
+        std::mt19937 rng(12345);
+        std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
+        std::vector<glm::mat4> enemies, pillars;
+        for (int i = 0; i < 60; ++i)
+            enemies.push_back(glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(dist(rng), 0.0f, dist(rng))), dist(rng), glm::vec3(0.0f, 1.0f, 0.0f)));
+        for (int i = 0; i < 20; ++i)
+            pillars.push_back(glm::translate(glm::mat4(1.0f), glm::vec3(dist(rng), -0.5f, dist(rng))));
+        std::vector<float> pickupX, pickupZ, pickupYaw, pickupScale;
+        std::vector<PointLight> lights;
+        for (int i = 0; i < 40; ++i) {
+            pickupX.push_back(dist(rng));
+            pickupZ.push_back(dist(rng));
+            pickupYaw.push_back(dist(rng));
+            pickupScale.push_back(1.0f);
+            lights.push_back({ glm::vec3(pickupX.back(), 1.5f, pickupZ.back()), 4.0f, glm::vec3(0.2f, 1.0f, 0.3f), 1.5f });
+        }
+        TransformSoA pickups;
+        pickups.x = pickupX.data();
+        pickups.z = pickupZ.data();
+        pickups.yaw = pickupYaw.data();
+        pickups.scale = pickupScale.data();
+        pickups.count = pickupX.size();
+
+        Camera camera;
+        camera.position = glm::vec3(0.0f, 10.0f, 10.0f);
+        camera.front = glm::normalize(-camera.position);
+
+        auto renderFrame = [&]() {
+            renderer.clear(glm::vec4(0.2f, 0.3f, 0.3f, 1.0f));
+            renderer.beginFrame(camera);
+            renderer.setLights(lights);
+            renderer.submit(ground, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -1.0f, 0.0f)), glm::vec4(1.0f));
+            renderer.submit(player, glm::mat4(1.0f), glm::vec4(1.0f));
+            renderer.submit(weapon, glm::translate(glm::mat4(1.0f), glm::vec3(0.7f, 0.2f, 0.0f)), glm::vec4(1.0f));
+            for (const glm::mat4& model : enemies)
+                renderer.submit(enemy, model, glm::vec4(1.0f));
+            for (const glm::mat4& model : pillars)
+                renderer.submit(pillar, model, glm::vec4(1.0f));
+            renderer.submit(pickup, pickups, glm::vec4(1.0f));
+            renderer.endFrame();
+        };
+
+        struct Configuration {
+            size_t threads;
+            bool vectorized;
+        };
+        // At least four threads, so bins are split across threads even on small machines
+        size_t threads = std::max(4u, std::thread::hardware_concurrency());
+        const Configuration configurations[] = { { threads, true }, { threads, false }, { 1, true }, { 1, false } };
+
+        int result = 0;
+        std::vector<uint8_t> reference;
+        for (const Configuration& configuration : configurations) {
+            ThreadPool pool(configuration.threads - 1);
+            renderer.setThreadPool(&pool);
+            renderer.setVectorized(configuration.vectorized);
+
+            // Best of a few frames, the first one also sizes the job and bin storage
+            float geometryMs = 1e30f, rasterMs = 1e30f;
+            for (int frame = 0; frame < 5; ++frame) {
+                renderFrame();
+                geometryMs = std::min(geometryMs, renderer.getStats().geometryMs);
+                rasterMs = std::min(rasterMs, renderer.getStats().rasterMs);
+            }
+            renderer.setThreadPool(nullptr);
+
+            const SoftwareRenderStats& stats = renderer.getStats();
+            std::cout << (renderer.isVectorized() ? "AVX2" : "Scalar") << ", " << configuration.threads << " threads: "
+                << geometryMs << " ms geometry, " << rasterMs << " ms raster, " << stats.triangles << " triangles ("
+                << stats.trianglesRasterized << " rasterized), " << stats.blocksTested << " blocks ("
+                << stats.blocksHiZRejected << " Hi-Z rejected), " << stats.pixelsShaded << " pixels shaded\n";
+
+            if (reference.empty())
+                reference = renderer.getColorBuffer();
+            else if (renderer.getColorBuffer() != reference) {
+                std::cout << "Image differs from the first configuration\n";
+                result = -1;
+            }
+        }
+
+        if (!renderer.savePNG(path)) {
+            std::cout << "Failed to write " << path << "\n";
+            return -1;
+        }
+        return result;
+    }
+
+    // Checks that changing a transform recomputes exactly the transforms below it, no window needed
+    int testTransforms() {
+        EntityManager entityManager;
+        ComponentManager componentManager;
+        TransformSystem transformSystem;
+
+        // root -> middle -> leaf, and an unrelated root
+        unsigned int root = entityManager.createEntity();
+        unsigned int middle = entityManager.createEntity();
+        unsigned int leaf = entityManager.createEntity();
+        unsigned int other = entityManager.createEntity();
+        componentManager.addComponent(root, Transform());
+        componentManager.addComponent(middle, Transform(glm::vec3(1.f, 0.f, 0.f)));
+        componentManager.addComponent(leaf, Transform(glm::vec3(0.f, 1.f, 0.f)));
+        componentManager.addComponent(other, Transform(glm::vec3(5.f, 0.f, 0.f)));
+        componentManager.setParent(middle, root);
+        componentManager.setParent(leaf, middle);
+
+        int failures = 0;
+        auto check = [&](bool condition, const char* what) {
+            if (!condition) {
+                std::cout << "FAILED: " << what << "\n";
+                ++failures;
+            }
+        };
+        auto worldPosition = [&](unsigned int entity) { return glm::vec3(componentManager.getTransform(entity)->world[3]); };
+        auto update = [&]() {
+            transformSystem.Update(0.f, componentManager);
+            return transformSystem.getUpdatedCount();
+        };
+
+        check(update() == 4, "first update computes every transform");
+        check(worldPosition(leaf) == glm::vec3(1.f, 1.f, 0.f), "leaf composes both parents");
+        check(update() == 0, "unchanged hierarchy is skipped");
+
+        componentManager.getTransform(root)->setPosition(glm::vec3(0.f, 0.f, 2.f));
+        check(update() == 3, "moving the root updates it and both descendants");
+        check(worldPosition(leaf) == glm::vec3(1.f, 1.f, 2.f), "leaf follows the moved root");
+        check(worldPosition(other) == glm::vec3(5.f, 0.f, 0.f), "unrelated root stays put");
+
+        componentManager.getTransform(middle)->setPosition(glm::vec3(2.f, 0.f, 0.f));
+        check(update() == 2, "moving the middle updates it and the leaf");
+        check(worldPosition(leaf) == glm::vec3(2.f, 1.f, 2.f), "leaf follows the moved middle");
+
+        componentManager.getTransform(leaf)->setScale(glm::vec3(2.f));
+        check(update() == 1, "changing the leaf updates only the leaf");
+
+        componentManager.removeEntity(middle);
+        update();
+        check(!componentManager.getTransform(leaf), "destroying the middle drops the leaf");
+        check(worldPosition(root) == glm::vec3(0.f, 0.f, 2.f), "root survives its child");
+
+        std::cout << (failures ? "Transform tests failed\n" : "Transform tests passed\n");
+        return failures ? 1 : 0;
+    }
+}
+
 int main(int argc, char** argv) {
+    // Compulsory2 --cook [path]
+    if (argc > 1 && std::strcmp(argv[1], "--cook") == 0)
+        return cookMeshPack(argc > 2 ? argv[2] : DEFAULT_MESH_PACK_PATH);
+    // Compulsory2 --render-software [out.png]
+    if (argc > 1 && std::strcmp(argv[1], "--render-software") == 0)
+        return renderSoftware(argc > 2 ? argv[2] : "software.png");
+    // Compulsory2 --test-transforms
+    if (argc > 1 && std::strcmp(argv[1], "--test-transforms") == 0)
+        return testTransforms();
+    // Compulsory2 --bench-transforms [count]
+    if (argc > 1 && std::strcmp(argv[1], "--bench-transforms") == 0)
+        return benchmarkTransforms(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000);
+    // Compulsory2 --bench-particles [count]
+    if (argc > 1 && std::strcmp(argv[1], "--bench-particles") == 0)
+        return benchmarkParticles(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000);
+    // Compulsory2 --bench-culling [count]
+    if (argc > 1 && std::strcmp(argv[1], "--bench-culling") == 0)
+        return benchmarkCulling(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100000);
+    // Compulsory2 --bench-submission [max count]
+    if (argc > 1 && std::strcmp(argv[1], "--bench-submission") == 0)
+        return benchmarkSubmission(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000);
+
+    // Compulsory2 --gl-trace counts every GL call and adds a panel with per-frame statistics
+    // Compulsory2 --dump-render-graph prints the compiled pass order and resource lifetimes
+    // Compulsory2 --players N plays split-screen with 2 to 4 local players
+    bool traceGL = false;
+    bool dumpRenderGraph = false;
+    int playerCount = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--gl-trace") == 0)
+            traceGL = true;
+        else if (std::strcmp(argv[i], "--dump-render-graph") == 0)
+            dumpRenderGraph = true;
+        else if (std::strcmp(argv[i], "--players") == 0 && i + 1 < argc)
+            playerCount = std::min(std::max(std::atoi(argv[++i]), 1), static_cast<int>(ViewFrustums::MaxViews));
+    }
+
     // Initialize GLFW
     if (!glfwInit()) {
         std::cout << "Failed to initialize GLFW\n";
         return -1;
     }
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
     // Create GLFWwindow object
-    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Compulsory 2 | 2SPIM131", nullptr, nullptr);
+    GLFWwindow* window = createWindow("Compulsory 2 | 2SPIM131", true);
     if (!window) {
-        std::cout << "Failed to create GLFW window\n";
         glfwTerminate();
         return -1;
     }
-    glfwMakeContextCurrent(window);
+    if (traceGL)
+        GLTrace::install();
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
-    // Initialize GLAD
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        std::cout << "Failed to initialize GLAD\n";
-        return -1;
-    }
+    // Only redraws when something on screen changed, hooked before ImGui so its callbacks chain to these
+    FramePacer framePacer;
+    framePacer.initialize(window);
 
     // Initialize renderer
     Renderer renderer;
@@ -65,12 +551,50 @@ int main(int argc, char** argv) {
         playerInventory->items.push_back("Potion");
     }
 
+    // Cooked meshes are uploaded straight from the mapped file, the pack is optional
+    MeshPack meshPack;
+    meshPack.open(DEFAULT_MESH_PACK_PATH);
+
     // Create player mesh
-    Mesh3D playerMesh = PrimitiveGenerator::createBox(1.0f, 2.0f, 1.0f, glm::vec3(0.f, 0.f, 1.f));
-    std::shared_ptr<WorldObject> playerObject = std::make_shared<WorldObject>(playerMesh);
+    std::shared_ptr<GPUMeshLOD> playerMesh = meshPack.loadLOD("player");
+    if (!playerMesh)
+        playerMesh = std::make_shared<GPUMeshLOD>(std::vector<Mesh3D>{ createPlayerMesh() });
+    componentManager.addComponent(playerEntity, Renderable(playerMesh));
+
+    // Split-screen players join next to player one with their own keys, tinted to tell them apart.
+    // Enemies, combat and pickups only know player one.
+    const InputSystem::KeyBindings playerKeys[ViewFrustums::MaxViews] = {
+        { GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D },
+        { GLFW_KEY_UP, GLFW_KEY_DOWN, GLFW_KEY_LEFT, GLFW_KEY_RIGHT },
+        { GLFW_KEY_I, GLFW_KEY_K, GLFW_KEY_J, GLFW_KEY_L },
+        { GLFW_KEY_KP_8, GLFW_KEY_KP_5, GLFW_KEY_KP_4, GLFW_KEY_KP_6 } };
+    const glm::vec4 playerTints[ViewFrustums::MaxViews] = {
+        glm::vec4(1.f), glm::vec4(0.5f, 0.7f, 1.f, 1.f), glm::vec4(0.6f, 1.f, 0.5f, 1.f), glm::vec4(1.f, 0.9f, 0.4f, 1.f) };
+    std::vector<unsigned int> players(1, playerEntity);
+    for (int i = 1; i < playerCount; ++i) {
+        unsigned int entity = entityManager.createEntity();
+        componentManager.addComponent(entity, Position(1.5f * i, 0.f));
+        componentManager.addComponent(entity, Velocity(0.f, 0.f));
+        componentManager.addComponent(entity, Health(100, 100));
+        componentManager.addComponent(entity, Renderable(playerMesh, playerTints[i]));
+        players.push_back(entity);
+    }
+
+    // Every player carries a sword at their side, attached through the Transform hierarchy so it follows them
+    std::shared_ptr<GPUMeshLOD> weaponMesh = meshPack.loadLOD("weapon");
+    if (!weaponMesh)
+        weaponMesh = std::make_shared<GPUMeshLOD>(std::vector<Mesh3D>{ createWeaponMesh() });
+    for (unsigned int player : players) {
+        componentManager.addComponent(player, Transform());
+        unsigned int weapon = entityManager.createEntity();
+        componentManager.addComponent(weapon, Transform(glm::vec3(0.7f, 0.2f, 0.f), glm::angleAxis(glm::radians(-20.f), glm::vec3(0.f, 0.f, 1.f))));
+        componentManager.addComponent(weapon, Renderable(weaponMesh));
+        componentManager.setParent(weapon, player);
+    }
 
     // Initialize Level
-    Level level(entityManager, componentManager);
+    Level level(entityManager, componentManager, &meshPack);
+    meshPack.close();
 
     // Generate level with specified number of enemies and pickups
     int numEnemies = 1;
@@ -78,47 +602,149 @@ int main(int argc, char** argv) {
     unsigned int seed = 12345; // First level is always the same
     level.generateLevel(numEnemies, numPickups, seed);
 
+    // Outdoor terrain around the arena, flat just under the level's ground tiles
+    Terrain terrain;
+    terrain.generate(seed, 26.0f, -1.05f);
+    terrain.initialize();
+
     // Initialize systems
-    InputSystem inputSystem(window /*Client Input*/, playerEntity /*Affected player*/);
+    std::vector<InputSystem> inputSystems;
+    for (size_t i = 0; i < players.size(); ++i)
+        inputSystems.emplace_back(window /*Client Input*/, players[i] /*Affected player*/, playerKeys[i]);
     AISystem aiSystem(playerEntity         /*Target player for enemy AI*/);
-    CombatSystem combatSystem(playerEntity /*Target player for enemy AI*/, level.getEnemyEntities(), level.getEnemyObjects());
+    ParticleSystem particleSystem;
+    particleSystem.initialize();
+    HealthBarRenderer healthBars;
+    healthBars.initialize();
+    DebugDraw::initialize();
+    bool debugKeyDown = false;
+
+    // F12 records PNG frames, F11 saves a single screenshot
+    FrameCapture frameCapture;
+    frameCapture.initialize();
+    bool recordKeyDown = false, screenshotKeyDown = false;
+    CombatSystem combatSystem(playerEntity /*Target player for enemy AI*/, &particleSystem);
     MovementSystem movementSystem;
-    PickupSystem pickupSystem(playerEntity /*Player able to pick up*/, level.getPickupEntities(), level.getPickupObjects());
+    PickupSystem pickupSystem(playerEntity /*Player able to pick up*/, &particleSystem);
+    TransformSystem transformSystem;
+    // With GL 4.3 enemies and pickups are culled and pick their LOD level in a compute shader and drawn with
+    // glMultiDrawElementsIndirect, otherwise RenderSystem instances them from the Position pool
+    GPUCulling culling;
+    culling.initialize();
+    RenderSystem renderSystem(renderer, GPUCulling::isSupported() ? &culling : nullptr);
 
-    // Initialize Camera
-    Camera camera;
+    // A camera and screen area per player, laid out when the scene is drawn
+    std::vector<RenderView> views(players.size());
 
     // Initialize UI Manager
     UIManager uiManager(window, componentManager, playerEntity);
 
+    // Scene resolution follows the measured GPU frame time
+    DynamicResolution dynamicResolution;
+    dynamicResolution.initialize();
+    uiManager.setDynamicResolution(&dynamicResolution);
+    uiManager.setFramePacer(&framePacer);
+    if (players.size() > 1)
+        uiManager.setMultiViewStats(&renderer.getStats().multiView, &renderer.singlePassViews);
+
     // Initialize frame time tracking
     float deltaTime = 0.0f;
     float lastFrame = 0.0f;
 
     glEnable(GL_DEPTH_TEST);
 
+    // The frame as a render graph: the scene renders offscreen, is copied to the window and the UI goes on top
+    RenderGraph renderGraph;
+    unsigned int backbuffer = renderGraph.importBackbuffer("Backbuffer");
+    // The scene renders at the dynamic resolution scale and is upscaled when presented, the UI stays sharp
+    unsigned int sceneColor = renderGraph.createTexture("SceneColor", { GL_RGBA8, 0, 0, true });
+    unsigned int sceneDepth = renderGraph.createTexture("SceneDepth", { GL_DEPTH_COMPONENT24, 0, 0, true });
+
+    renderGraph.addPass("Scene", {}, { sceneColor, sceneDepth }, [&](const RenderGraphContext& context) {
+        renderer.setAspect(context.getWidth(), context.getHeight());
+        layoutSplitScreen(views, context.getWidth(), context.getHeight());
+
+        // Clear screen
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // Draw every entity with a Renderable, culled and submitted once for all players' views
+        renderer.beginFrame(views);
+        level.drawStatic(renderer);
+        renderSystem.Update(deltaTime, componentManager);
+        renderer.drawTerrain(terrain);
+        renderer.endFrame();
+
+        // Overlays face each view's camera, so they are drawn per view; debug shapes only in player one's
+        for (size_t v = 0; v < views.size(); ++v) {
+            glViewport(views[v].x, views[v].y, views[v].width, views[v].height);
+            healthBars.draw(componentManager, renderer.getViewMatrix(v), renderer.getProjectionMatrix(v));
+            particleSystem.draw(renderer.getViewMatrix(v), renderer.getProjectionMatrix(v));
+            if (v == 0) {
+                glm::vec2 size(context.getWidth(), context.getHeight());
+                glm::vec4 viewport(views[v].x / size.x, views[v].y / size.y, views[v].width / size.x, views[v].height / size.y);
+                DebugDraw::flush(renderer.getViewMatrix(v), renderer.getProjectionMatrix(v), viewport);
+            }
+        }
+        glViewport(0, 0, context.getWidth(), context.getHeight());
+    });
+    renderGraph.addPass("Present", { sceneColor }, { backbuffer }, [&](const RenderGraphContext& context) {
+        context.blit(sceneColor);
+    });
+    renderGraph.addPass("UI", {}, { backbuffer }, [&](const RenderGraphContext&) {
+        // Render UI
+        uiManager.render();
+
+        // End ImGui frame
+        uiManager.endFrame();
+    });
+    renderGraph.resize(SCR_WIDTH, SCR_HEIGHT);
+    if (renderGraph.compile() && dumpRenderGraph)
+        std::cout << renderGraph.dump();
+
     while (!glfwWindowShouldClose(window))
     {
+        // Process window input, sleeping while nothing changes. Nothing moved then, so that time is skipped.
+        lastFrame += static_cast<float>(framePacer.waitEvents());
+
         // Update deltaTime
         float currentFrame = static_cast<float>(glfwGetTime());
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
-        // Process window input
-        glfwPollEvents();
+        // F3 toggles debug drawing
+        bool debugKey = glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS;
+        if (debugKey && !debugKeyDown)
+            DebugDraw::setEnabled(!DebugDraw::isEnabled());
+        debugKeyDown = debugKey;
+
+        bool recordKey = glfwGetKey(window, GLFW_KEY_F12) == GLFW_PRESS;
+        if (recordKey && !recordKeyDown) {
+            if (frameCapture.isRecording())
+                frameCapture.stopRecording();
+            else
+                frameCapture.startRecording("capture", CaptureFormat::PNG);
+        }
+        recordKeyDown = recordKey;
 
-        // Start ImGui frame
-        uiManager.beginFrame();
+        bool screenshotKey = glfwGetKey(window, GLFW_KEY_F11) == GLFW_PRESS;
+        if (screenshotKey && !screenshotKeyDown)
+            frameCapture.requestScreenshot("screenshot.png");
+        screenshotKeyDown = screenshotKey;
 
         // Update Systems
         pickupSystem.Update(deltaTime, componentManager);
-        inputSystem.Update(deltaTime, componentManager);
+        for (InputSystem& inputSystem : inputSystems)
+            inputSystem.Update(deltaTime, componentManager);
         aiSystem.Update(deltaTime, componentManager);
         combatSystem.Update(deltaTime, componentManager);
         movementSystem.Update(deltaTime, componentManager);
+        level.resolveCollisions();
+        transformSystem.Update(deltaTime, componentManager);
+        particleSystem.Update(deltaTime);
 
         // Check if all enemies are defeated
-        if (level.getEnemyEntities().empty()) {
+        if (level.isCleared()) {
             std::cout << "You have cleared the level!" << std::endl;
 
             // Increase difficulty: More enemies
@@ -130,68 +756,62 @@ int main(int argc, char** argv) {
             level.generateLevel(numEnemies, numPickups /*, Random Seed */);
         }
 
-        // Update camera to follow player
-        Position* playerPos = componentManager.getPosition(playerEntity);
-        if (playerPos) {
-            glm::vec3 camOffset(0.f, 10.f, 10.f);
-            camera.position = glm::vec3(playerPos->x, 0.f /* Fixed Y */, playerPos->z) + camOffset;
-            camera.front = glm::normalize(glm::vec3(playerPos->x, 0.f /* Fixed Y */, playerPos->z) - camera.position);
-            camera.up = glm::vec3(0.f, 1.f, 0.f);
-        }
-
-        // Clear screen
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        // Update WorldObject positions from ECS positions
-        if (playerPos) {
-            playerObject->position = glm::vec3(playerPos->x, 0.f /* Fixed Y */, playerPos->z);
-        }
-
-        // Update enemy positions and render
-        const auto& enemyEntities = level.getEnemyEntities();
-        const auto& enemyObjects = level.getEnemyObjects();
-
-        for (size_t i = 0; i < enemyEntities.size(); ++i) {
-            unsigned int enemyEntityID = enemyEntities[i];
-            Position* enemyPos = componentManager.getPosition(enemyEntityID);
-            if (enemyPos) {
-                enemyObjects[i]->position = glm::vec3(enemyPos->x, 0.f /* Fixed Y */, enemyPos->z);
+        // Update cameras to follow their players
+        for (size_t i = 0; i < players.size(); ++i) {
+            Camera& camera = views[i].camera;
+            Position* playerPos = componentManager.getPosition(players[i]);
+            if (playerPos) {
+                glm::vec3 camOffset(0.f, 10.f, 10.f);
+                camera.position = glm::vec3(playerPos->x, 0.f /* Fixed Y */, playerPos->z) + camOffset;
+                camera.front = glm::normalize(glm::vec3(playerPos->x, 0.f /* Fixed Y */, playerPos->z) - camera.position);
+                camera.up = glm::vec3(0.f, 1.f, 0.f);
             }
-        }
 
-        for (const auto& enemyObj : enemyObjects) {
-            renderer.render(enemyObj, camera);
+            // Anything visible that changed since the last iteration triggers a redraw
+            framePacer.watch(camera.position);
+            framePacer.watch(camera.front);
         }
-
-        // Update pickup positions and render
-        const auto& pickupEntities = level.getPickupEntities();
-        const auto& pickupObjects = level.getPickupObjects();
-
-        for (size_t i = 0; i < pickupEntities.size(); ++i) {
-            unsigned int pickupEntityID = pickupEntities[i];
-            Position* pickupPos = componentManager.getPosition(pickupEntityID);
-            if (pickupPos) {
-                pickupObjects[i]->position = glm::vec3(pickupPos->x, 0.f /* Fixed Y */, pickupPos->z);
-            }
+        framePacer.watch(componentManager.positions);
+        framePacer.watch(componentManager.healths);
+        if (transformSystem.getUpdatedCount() > 0 || particleSystem.getLiveCount() > 0 || frameCapture.isRecording())
+            framePacer.markChanged();
+
+        // Targets follow the window size
+        int framebufferWidth = 0, framebufferHeight = 0;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        if (framePacer.shouldRender() && framebufferWidth > 0 && framebufferHeight > 0) {
+            // Start ImGui frame
+            uiManager.beginFrame();
+
+            renderGraph.resize(framebufferWidth, framebufferHeight);
+            renderGraph.setRenderScale(dynamicResolution.getScale());
+            dynamicResolution.beginFrame();
+            renderGraph.execute();
+            dynamicResolution.endFrame();
+            frameCapture.captureFrame(framebufferWidth, framebufferHeight);
+            GLTrace::endFrame();
+
+            glfwSwapBuffers(window);
         }
-
-        for (const auto& pickupObj : pickupObjects) {
-            renderer.render(pickupObj, camera);
+        else {
+            // The last frame stays on screen
+            DebugDraw::discard();
         }
-
-        // Render player
-        renderer.render(playerObject, camera);
-
-        // Render UI
-        uiManager.render();
-
-        // End ImGui frame
-        uiManager.endFrame();
-
-        glfwSwapBuffers(window);
     }
 
+    // Free GL objects while the context is still alive, in reverse order of creation. Captured frames finish
+    // writing here; the mesh arena goes last, every renderer draws from it.
+    renderGraph.release();
+    dynamicResolution.cleanup();
+    culling.cleanup();
+    frameCapture.cleanup();
+    DebugDraw::cleanup();
+    healthBars.cleanup();
+    particleSystem.cleanup();
+    terrain.cleanup();
+    renderer.cleanup();
+    MeshArena::instance().release();
+
     // Terminate GLFW
     glfwTerminate();
 }
@@ -0,0 +1,263 @@
+#include "DebugDraw.h"
+
+#if DEBUG_DRAW_ENABLED
+#include <glad/glad.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "ImGui/imgui.h"
+#include "ShaderHelper.h"
+#include "Vertex.h"
+
+namespace {
+    struct DebugVertex {
+        glm::vec3 position;
+        ColorRGBA8 color;
+    };
+
+    struct TextMarker {
+        glm::vec3 position;
+        ColorRGBA8 color;
+        std::string text;
+    };
+
+    // Shapes queued by one thread since the last flush
+    struct ThreadBuffer {
+        std::vector<DebugVertex> lines; // Pairs of endpoints
+        std::vector<TextMarker> texts;
+    };
+
+    // Buffers are owned here and never freed, so a thread that exits leaves nothing dangling
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+
+    std::atomic<bool> enabled{ false };
+
+    ShaderProgram program;
+    GLint viewProjectionLoc{ -1 };
+    GLuint vao{ 0 }, vbo{ 0 };
+    size_t capacity{ 0 }; // Bytes
+    size_t lastLineCount{ 0 };
+
+    const int CircleSegments = 32;
+
+    // Unit circle, computed once so circles cost no trigonometry
+    const glm::vec2* unitCircle() {
+        static const std::vector<glm::vec2> points = [] {
+            std::vector<glm::vec2> result(CircleSegments + 1);
+            for (int i = 0; i <= CircleSegments; ++i) {
+                float angle = 6.28318531f * i / CircleSegments;
+                result[i] = glm::vec2(std::cos(angle), std::sin(angle));
+            }
+            return result;
+        }();
+        return points.data();
+    }
+
+    ThreadBuffer& localBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registry.push_back(std::make_unique<ThreadBuffer>());
+            buffer = registry.back().get();
+        }
+        return *buffer;
+    }
+
+    inline void pushLine(ThreadBuffer& buffer, const glm::vec3& from, const glm::vec3& to, ColorRGBA8 color) {
+        buffer.lines.push_back({ from, color });
+        buffer.lines.push_back({ to, color });
+    }
+}
+
+void DebugDraw::initialize() {
+    program = ShaderProgram(ShaderHelper::createCachedProgram({
+        { GL_VERTEX_SHADER, ShaderHelper::readFile("DebugDraw.vs") },
+        { GL_FRAGMENT_SHADER, ShaderHelper::readFile("DebugDraw.fs") } }));
+    if (!program.isValid()) {
+        std::cerr << "ERROR::SHADER::PROGRAM::CREATION_FAILED (debug draw)\n";
+        return;
+    }
+    viewProjectionLoc = program.getUniformLocation("viewProjection");
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(PositionLocation);
+    glVertexAttribPointer(PositionLocation, 3, GL_FLOAT, GL_FALSE, sizeof(DebugVertex),
+        reinterpret_cast<const void*>(offsetof(DebugVertex, position)));
+    glEnableVertexAttribArray(ColorLocation);
+    glVertexAttribPointer(ColorLocation, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DebugVertex),
+        reinterpret_cast<const void*>(offsetof(DebugVertex, color)));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void DebugDraw::cleanup() {
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    vao = vbo = 0;
+    capacity = 0;
+    program.destroy();
+}
+
+void DebugDraw::setEnabled(bool value) {
+    enabled = value;
+}
+
+bool DebugDraw::isEnabled() {
+    return enabled;
+}
+
+void DebugDraw::line(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color) {
+    if (!enabled)
+        return;
+    pushLine(localBuffer(), from, to, packColor(color));
+}
+
+void DebugDraw::circle(const glm::vec3& center, float radius, const glm::vec3& color) {
+    if (!enabled)
+        return;
+    ThreadBuffer& buffer = localBuffer();
+    ColorRGBA8 packed = packColor(color);
+    const glm::vec2* points = unitCircle();
+    for (int i = 0; i < CircleSegments; ++i) {
+        pushLine(buffer, center + glm::vec3(points[i].x, 0.0f, points[i].y) * radius,
+            center + glm::vec3(points[i + 1].x, 0.0f, points[i + 1].y) * radius, packed);
+    }
+}
+
+void DebugDraw::box(const glm::vec3& min, const glm::vec3& max, const glm::vec3& color) {
+    if (!enabled)
+        return;
+    ThreadBuffer& buffer = localBuffer();
+    ColorRGBA8 packed = packColor(color);
+    glm::vec3 corners[8];
+    for (int i = 0; i < 8; ++i)
+        corners[i] = glm::vec3(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z);
+    // Each edge joins corners that differ in one axis bit
+    for (int i = 0; i < 8; ++i) {
+        for (int axis = 1; axis < 8; axis <<= 1) {
+            if (!(i & axis))
+                pushLine(buffer, corners[i], corners[i | axis], packed);
+        }
+    }
+}
+
+void DebugDraw::arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color, float headSize) {
+    if (!enabled)
+        return;
+    ThreadBuffer& buffer = localBuffer();
+    ColorRGBA8 packed = packColor(color);
+    pushLine(buffer, from, to, packed);
+
+    glm::vec3 direction = to - from;
+    float length = glm::length(direction);
+    if (length <= 0.0f)
+        return;
+    direction /= length;
+
+    // Head in the plane holding the shaft and the most perpendicular world axis
+    glm::vec3 up = std::fabs(direction.y) < 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+    glm::vec3 side = glm::normalize(glm::cross(direction, up));
+    float size = std::min(headSize, length * 0.5f);
+    glm::vec3 back = to - direction * size;
+    pushLine(buffer, to, back + side * size * 0.5f, packed);
+    pushLine(buffer, to, back - side * size * 0.5f, packed);
+}
+
+void DebugDraw::grid(const glm::vec3& center, float halfExtent, float spacing, const glm::vec3& color) {
+    if (!enabled || spacing <= 0.0f)
+        return;
+    ThreadBuffer& buffer = localBuffer();
+    ColorRGBA8 packed = packColor(color);
+    int lines = static_cast<int>(halfExtent / spacing);
+    for (int i = -lines; i <= lines; ++i) {
+        float offset = i * spacing;
+        pushLine(buffer, center + glm::vec3(offset, 0.0f, -halfExtent), center + glm::vec3(offset, 0.0f, halfExtent), packed);
+        pushLine(buffer, center + glm::vec3(-halfExtent, 0.0f, offset), center + glm::vec3(halfExtent, 0.0f, offset), packed);
+    }
+}
+
+void DebugDraw::text(const glm::vec3& position, const char* text, const glm::vec3& color) {
+    if (!enabled || !text)
+        return;
+    localBuffer().texts.push_back({ position, packColor(color), text });
+}
+
+void DebugDraw::flush(const glm::mat4& view, const glm::mat4& projection, const glm::vec4& viewport) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    size_t vertexCount = 0;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry)
+        vertexCount += buffer->lines.size();
+    lastLineCount = vertexCount / 2;
+
+    glm::mat4 viewProjection = projection * view;
+    if (vertexCount > 0 && program.isValid()) {
+        // Orphan, then append every thread's lines
+        size_t bytes = vertexCount * sizeof(DebugVertex);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        if (bytes > capacity)
+            capacity = std::max(bytes, capacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        size_t offset = 0;
+        for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+            size_t size = buffer->lines.size() * sizeof(DebugVertex);
+            if (size > 0)
+                glBufferSubData(GL_ARRAY_BUFFER, offset, size, buffer->lines.data());
+            offset += size;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glUseProgram(program.getId());
+        glUniformMatrix4fv(viewProjectionLoc, 1, GL_FALSE, &viewProjection[0][0]);
+        glBindVertexArray(vao);
+        glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertexCount));
+        glBindVertexArray(0);
+    }
+
+    // Labels go on top of everything through ImGui, in its window coordinates
+    if (ImGui::GetCurrentContext()) {
+        ImDrawList* drawList = ImGui::GetForegroundDrawList();
+        ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+        for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+            for (const TextMarker& marker : buffer->texts) {
+                glm::vec4 clip = viewProjection * glm::vec4(marker.position, 1.0f);
+                if (clip.w <= 0.0f)
+                    continue;
+                glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                if (std::fabs(ndc.x) > 1.0f || std::fabs(ndc.y) > 1.0f)
+                    continue;
+                // ImGui's origin is the top left
+                glm::vec2 target = glm::vec2(viewport) + (ndc * 0.5f + 0.5f) * glm::vec2(viewport.z, viewport.w);
+                ImVec2 screen(target.x * displaySize.x, (1.0f - target.y) * displaySize.y);
+                drawList->AddText(screen, IM_COL32(marker.color.r, marker.color.g, marker.color.b, 255), marker.text.c_str());
+            }
+        }
+    }
+
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+        buffer->lines.clear();
+        buffer->texts.clear();
+    }
+}
+
+void DebugDraw::discard() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry) {
+        buffer->lines.clear();
+        buffer->texts.clear();
+    }
+}
+
+size_t DebugDraw::getLineCount() {
+    return lastLineCount;
+}
+#endif
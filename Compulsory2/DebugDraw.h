@@ -0,0 +1,68 @@
+#ifndef DEBUG_DRAW_H
+#define DEBUG_DRAW_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+
+// On in debug builds, define DEBUG_DRAW_ENABLED to 0 or 1 to override
+#ifndef DEBUG_DRAW_ENABLED
+#ifdef NDEBUG
+#define DEBUG_DRAW_ENABLED 0
+#else
+#define DEBUG_DRAW_ENABLED 1
+#endif
+#endif
+
+// Immediate-mode debug shapes, callable from any system or thread during the frame.
+// Every thread appends to a buffer of its own without locking; flush merges them into one upload and draws
+// all lines with a single call and all text markers into one ImGui draw list.
+// With DEBUG_DRAW_ENABLED 0 every function is empty and inline, so calls compile to nothing.
+class DebugDraw {
+public:
+#if DEBUG_DRAW_ENABLED
+    // Creates the program and buffer, needs a current GL context
+    static void initialize();
+    static void cleanup();
+
+    // Runtime switch, off until toggled (F3 in game). Shapes queued while off are dropped.
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    static void line(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color);
+    // Circles lie in the XZ plane, the ground plane of the game
+    static void circle(const glm::vec3& center, float radius, const glm::vec3& color);
+    static void box(const glm::vec3& min, const glm::vec3& max, const glm::vec3& color);
+    static void arrow(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color, float headSize = 0.25f);
+    // Square grid in the XZ plane, lines every spacing units out to halfExtent
+    static void grid(const glm::vec3& center, float halfExtent, float spacing, const glm::vec3& color);
+    // Label drawn at the projected position, text is copied
+    static void text(const glm::vec3& position, const char* text, const glm::vec3& color);
+
+    // Draws and clears everything queued since the last flush. Call on the render thread while no other
+    // thread is drawing, with an ImGui frame in progress for the text markers.
+    // viewport is the GL viewport the lines go to as x, y, width, height in fractions of the target, from the
+    // bottom left; text markers are placed in the same part of the ImGui display.
+    static void flush(const glm::mat4& view, const glm::mat4& projection, const glm::vec4& viewport = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f));
+    // Drops everything queued since the last flush, for frames that are not drawn
+    static void discard();
+
+    // Segments drawn by the last flush
+    static size_t getLineCount();
+#else
+    static void initialize() {}
+    static void cleanup() {}
+    static void setEnabled(bool) {}
+    static bool isEnabled() { return false; }
+    static void line(const glm::vec3&, const glm::vec3&, const glm::vec3&) {}
+    static void circle(const glm::vec3&, float, const glm::vec3&) {}
+    static void box(const glm::vec3&, const glm::vec3&, const glm::vec3&) {}
+    static void arrow(const glm::vec3&, const glm::vec3&, const glm::vec3&, float = 0.25f) {}
+    static void grid(const glm::vec3&, float, float, const glm::vec3&) {}
+    static void text(const glm::vec3&, const char*, const glm::vec3&) {}
+    static void flush(const glm::mat4&, const glm::mat4&, const glm::vec4& = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)) {}
+    static void discard() {}
+    static size_t getLineCount() { return 0; }
+#endif
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "DynamicResolution.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    const float Smoothing = 0.2f;       // Weight of a new measurement
+    const float Headroom = 0.85f;       // Scale up only below this fraction of the target, avoids oscillating
+    const float MaxStepDown = 0.1f;     // Per adjustment, dropping fast avoids long runs of slow frames
+    const float MaxStepUp = 0.05f;
+    const float MaxSampleMs = 250.0f;   // Longer frames are hitches (shader compiles, uploads), not load
+}
+
+void DynamicResolution::initialize() {
+    glGenQueries(QueryCount, queries);
+    std::fill(pending, pending + QueryCount, false);
+}
+
+void DynamicResolution::cleanup() {
+    glDeleteQueries(QueryCount, queries);
+    std::fill(queries, queries + QueryCount, 0u);
+}
+
+void DynamicResolution::beginFrame() {
+    // Skip measuring when the GPU is so far behind that this slot is still waiting
+    measuring = queries[current] != 0 && !pending[current];
+    if (measuring)
+        glBeginQuery(GL_TIME_ELAPSED, queries[current]);
+}
+
+void DynamicResolution::endFrame() {
+    if (measuring) {
+        glEndQuery(GL_TIME_ELAPSED);
+        pending[current] = true;
+    }
+    current = (current + 1) % QueryCount;
+    ++framesSinceChange;
+    collectResults();
+}
+
+void DynamicResolution::collectResults() {
+    // Oldest first, stop at the first one still in flight
+    for (int i = 0; i < QueryCount; ++i) {
+        int slot = (current + i) % QueryCount;
+        if (!pending[slot])
+            continue;
+        GLint available = 0;
+        glGetQueryObjectiv(queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(queries[slot], GL_QUERY_RESULT, &nanoseconds);
+        pending[slot] = false;
+        adjust(static_cast<float>(nanoseconds) * 1e-6f);
+    }
+}
+
+void DynamicResolution::adjust(float gpuMs) {
+    lastMs = gpuMs;
+    if (gpuMs > MaxSampleMs)
+        return;
+    smoothedMs = smoothedMs > 0.0f ? smoothedMs + (gpuMs - smoothedMs) * Smoothing : gpuMs;
+
+    float target = std::max(minScale, std::min(scale, maxScale));
+    // Results lag by up to QueryCount frames, wait until they reflect the last change
+    if (enabled && framesSinceChange > QueryCount && targetMs > 0.0f) {
+        if (smoothedMs > targetMs || smoothedMs < targetMs * Headroom) {
+            // Cost follows the pixel count, which goes with the square of the scale
+            float wanted = scale * std::sqrt(targetMs * (smoothedMs > targetMs ? 1.0f : Headroom) / smoothedMs);
+            target = std::max(scale - MaxStepDown, std::min(wanted, scale + MaxStepUp));
+        }
+    }
+    else if (!enabled) {
+        target = maxScale;
+    }
+
+    target = std::max(minScale, std::min(target, maxScale));
+    if (target != scale) {
+        scale = target;
+        framesSinceChange = 0;
+    }
+}
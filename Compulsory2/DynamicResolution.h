@@ -0,0 +1,47 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+// Picks the scene's render scale from the measured GPU frame time.
+// Each frame is bracketed with a GL_TIME_ELAPSED query; results are read once the driver reports them
+// available, a few frames later, so measuring never stalls the pipeline.
+class DynamicResolution {
+public:
+    // Creates the queries, needs a current GL context
+    void initialize();
+    void cleanup();
+
+    // Bracket the GPU work of one frame
+    void beginFrame();
+    void endFrame();
+
+    // Scale to render the next frame at, per axis
+    float getScale() const { return scale; }
+
+    // Smoothed and latest measured GPU time of a whole frame
+    float getGpuTimeMs() const { return smoothedMs; }
+    float getLastGpuTimeMs() const { return lastMs; }
+
+    // Settings, editable at runtime
+    bool enabled{ true };
+    float targetMs{ 16.0f };
+    float minScale{ 0.5f };
+    float maxScale{ 1.0f };
+
+private:
+    static const int QueryCount = 4; // Frames in flight before a measurement is dropped
+
+    unsigned int queries[QueryCount]{}; // GL query names, kept GL-free so UI code can include this
+    bool pending[QueryCount]{};
+    int current{ 0 };        // Slot of this frame
+    bool measuring{ false }; // This frame's query was started
+    int framesSinceChange{ 0 };
+
+    float scale{ 1.0f };
+    float smoothedMs{ 0.0f };
+    float lastMs{ 0.0f };
+
+    void collectResults();
+    void adjust(float gpuMs);
+};
+
+#endif
@@ -0,0 +1,336 @@
+#include "FrameCapture.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+FrameCapture::~FrameCapture() {
+    cleanup();
+}
+
+void FrameCapture::initialize() {
+    if (running)
+        return;
+    stopping = false;
+    running = true;
+    writer = std::thread(&FrameCapture::writerLoop, this);
+}
+
+void FrameCapture::cleanup() {
+    if (!running)
+        return;
+    recording = false;
+    screenshotPath.clear();
+
+    // Drain everything in flight, this may block but only at shutdown
+    collect(true);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return jobs.empty() && busy == 0; });
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+    running = false;
+
+    for (Slot& slot : slots) {
+        if (slot.state == SlotState::Mapped) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        if (slot.fence)
+            glDeleteSync(slot.fence);
+        glDeleteBuffers(1, &slot.pbo);
+        slot.pbo = 0;
+        slot.bytes = 0;
+        slot.fence = nullptr;
+        slot.state = SlotState::Free;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void FrameCapture::startRecording(const std::string& prefix, CaptureFormat format) {
+    recordPrefix = prefix;
+    recordFormat = format;
+    recordIndex = 0;
+    recording = true;
+    std::cout << "Capture: recording to " << prefix << "_*\n";
+}
+
+void FrameCapture::stopRecording() {
+    if (!recording)
+        return;
+    recording = false;
+    std::cout << "Capture: stopped after " << recordIndex << " frames, " << framesDropped << " dropped, "
+        << captureCpuMs << " ms per frame on the render thread\n";
+}
+
+void FrameCapture::requestScreenshot(const std::string& path) {
+    screenshotPath = path;
+}
+
+void FrameCapture::captureFrame(int width, int height) {
+    if (!running)
+        return;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    collect(false);
+
+    bool wanted = recording || !screenshotPath.empty();
+    if (wanted && width > 0 && height > 0) {
+        Slot& slot = slots[nextWrite];
+        if (slot.state != SlotState::Free) {
+            ++framesDropped; // Every buffer is in flight, never wait for one
+        }
+        else {
+            if (!slot.pbo)
+                glGenBuffers(1, &slot.pbo);
+            size_t bytes = static_cast<size_t>(width) * height * 4;
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+            if (slot.bytes != bytes) {
+                glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+                slot.bytes = bytes;
+            }
+
+            // Asynchronous: with a pack buffer bound the call only queues the copy
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+            slot.width = width;
+            slot.height = height;
+            if (!screenshotPath.empty()) {
+                slot.path = screenshotPath;
+                slot.format = CaptureFormat::PNG;
+                screenshotPath.clear();
+            }
+            else {
+                char number[16];
+                std::snprintf(number, sizeof(number), "_%06zu", recordIndex++);
+                slot.path = recordPrefix + number;
+                if (recordFormat == CaptureFormat::Raw)
+                    slot.path += "_" + std::to_string(width) + "x" + std::to_string(height) + ".rgba";
+                else
+                    slot.path += ".png";
+                slot.format = recordFormat;
+            }
+            slot.state = SlotState::Reading;
+            nextWrite = (nextWrite + 1) % SlotCount;
+        }
+    }
+
+    float elapsed = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    captureCpuMs += (elapsed - captureCpuMs) * 0.1f;
+}
+
+void FrameCapture::collect(bool wait) {
+    // Mapped slots the writer is done with become free again
+    for (Slot& slot : slots) {
+        if (slot.state == SlotState::Mapped && slot.released) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            slot.state = SlotState::Free;
+        }
+    }
+
+    // Readbacks complete in order, hand each finished one to the writer
+    while (slots[nextRead].state == SlotState::Reading) {
+        Slot& slot = slots[nextRead];
+        GLenum status = glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? GL_TIMEOUT_IGNORED : 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            break;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.bytes, GL_MAP_READ_BIT);
+        if (!mapped) {
+            std::cerr << "Capture: mapping the readback buffer failed\n";
+            slot.state = SlotState::Free;
+            ++framesDropped;
+        }
+        else {
+            slot.released = false;
+            slot.state = SlotState::Mapped;
+
+            Job job;
+            job.slot = &slot;
+            job.mapped = static_cast<const unsigned char*>(mapped);
+            job.width = slot.width;
+            job.height = slot.height;
+            job.path = slot.path;
+            job.format = slot.format;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                jobs.push_back(std::move(job));
+            }
+            wake.notify_one();
+        }
+        nextRead = (nextRead + 1) % SlotCount;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (wait) {
+        // Shutdown: keep returning buffers until the writer has released all of them
+        for (Slot& slot : slots) {
+            while (slot.state == SlotState::Mapped && !slot.released)
+                std::this_thread::yield();
+        }
+        collect(false);
+    }
+}
+
+void FrameCapture::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+            if (stopping)
+                return;
+            continue;
+        }
+
+        // Mapped slots first: copying them out frees the GPU buffer for the render thread
+        auto next = std::find_if(jobs.begin(), jobs.end(), [](const Job& job) { return job.slot != nullptr; });
+        if (next != jobs.end()) {
+            Job job = std::move(*next);
+            jobs.erase(next);
+            size_t queued = jobs.size();
+            lock.unlock();
+
+            // Copy out flipped to top-down, unless the backlog is full
+            bool keep = queued < MaxQueued;
+            if (keep) {
+                size_t row = static_cast<size_t>(job.width) * 4;
+                job.pixels.resize(row * job.height);
+                for (int y = 0; y < job.height; ++y)
+                    std::memcpy(&job.pixels[(job.height - 1 - y) * row], job.mapped + y * row, row);
+            }
+            job.slot->released = true;
+            job.slot = nullptr;
+            job.mapped = nullptr;
+
+            lock.lock();
+            if (keep)
+                jobs.push_back(std::move(job));
+            else
+                ++framesDropped;
+            continue;
+        }
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        ++busy;
+        lock.unlock();
+
+        bool written = job.format == CaptureFormat::Raw ? writeRaw(job.path, job.pixels) : writePNG(job.path, job.width, job.height, job.pixels);
+        if (written)
+            ++framesWritten;
+        else
+            std::cerr << "Capture: could not write " << job.path << "\n";
+
+        lock.lock();
+        --busy;
+        if (jobs.empty() && busy == 0)
+            idle.notify_all();
+    }
+}
+
+bool FrameCapture::writeRaw(const std::string& path, const std::vector<unsigned char>& pixels) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+    return static_cast<bool>(file);
+}
+
+namespace {
+    uint32_t crc32(uint32_t crc, const unsigned char* data, size_t size) {
+        static uint32_t table[256];
+        static bool initialized = [] {
+            for (uint32_t n = 0; n < 256; ++n) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k)
+                    c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+            return true;
+        }();
+        (void)initialized;
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void appendBigEndian(std::vector<unsigned char>& out, uint32_t value) {
+        out.push_back(static_cast<unsigned char>(value >> 24));
+        out.push_back(static_cast<unsigned char>(value >> 16));
+        out.push_back(static_cast<unsigned char>(value >> 8));
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    void writeChunk(std::ofstream& file, const char* type, const std::vector<unsigned char>& data) {
+        std::vector<unsigned char> chunk;
+        chunk.reserve(data.size() + 12);
+        appendBigEndian(chunk, static_cast<uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        appendBigEndian(chunk, crc32(0, chunk.data() + 4, data.size() + 4));
+        file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    }
+}
+
+bool FrameCapture::writePNG(const std::string& path, int width, int height, const std::vector<unsigned char>& pixels) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<unsigned char> header;
+    appendBigEndian(header, static_cast<uint32_t>(width));
+    appendBigEndian(header, static_cast<uint32_t>(height));
+    header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8-bit RGBA, no interlace
+    writeChunk(file, "IHDR", header);
+
+    // Scanlines with filter type 0, stored in uncompressed deflate blocks: fast to write, readable everywhere
+    size_t row = static_cast<size_t>(width) * 4;
+    std::vector<unsigned char> raw;
+    raw.reserve((row + 1) * height);
+    for (int y = 0; y < height; ++y) {
+        raw.push_back(0);
+        raw.insert(raw.end(), pixels.begin() + y * row, pixels.begin() + (y + 1) * row);
+    }
+
+    std::vector<unsigned char> zlib;
+    zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    uint32_t a = 1, b = 0;
+    size_t offset = 0;
+    while (true) {
+        size_t size = std::min<size_t>(65535, raw.size() - offset);
+        bool last = offset + size >= raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<unsigned char>(size));
+        zlib.push_back(static_cast<unsigned char>(size >> 8));
+        zlib.push_back(static_cast<unsigned char>(~size));
+        zlib.push_back(static_cast<unsigned char>(~size >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+        for (size_t i = offset; i < offset + size; ++i) {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        offset += size;
+        if (last)
+            break;
+    }
+    appendBigEndian(zlib, (b << 16) | a);
+    writeChunk(file, "IDAT", zlib);
+    writeChunk(file, "IEND", {});
+    return static_cast<bool>(file);
+}
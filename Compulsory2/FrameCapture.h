@@ -0,0 +1,112 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <glad/glad.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class CaptureFormat {
+    Raw, // Tightly packed top-down RGBA8, size in the file name
+    PNG  // Uncompressed PNG, readable anywhere without extra libraries
+};
+
+// In-engine capture of the backbuffer without stalling the GPU.
+// Each captured frame is read into one of a ring of pixel buffer objects and fenced; a few frames later,
+// once the fence has signaled, the buffer is mapped and handed to a background thread that copies the
+// pixels out and writes the file. The render thread only issues GL calls, it never waits or copies.
+// Frames are dropped, not waited for, when every buffer is still busy.
+class FrameCapture {
+public:
+    FrameCapture() = default;
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Starts the writer thread, needs a current GL context for the buffers created later
+    void initialize();
+    // Writes everything still queued, then releases the buffers and joins the writer
+    void cleanup();
+
+    // Every frame from now on goes to prefix_NNNNNN with the format's extension
+    void startRecording(const std::string& prefix, CaptureFormat format);
+    void stopRecording();
+    bool isRecording() const { return recording; }
+
+    // Captures the next frame as a single PNG, e.g. a level thumbnail
+    void requestScreenshot(const std::string& path);
+
+    // Call once per frame after everything is drawn and before swapping, size of the backbuffer
+    void captureFrame(int width, int height);
+
+    size_t getFramesWritten() const { return framesWritten; }
+    size_t getFramesDropped() const { return framesDropped; }
+    // Render thread time spent in captureFrame, smoothed
+    float getCaptureCpuMs() const { return captureCpuMs; }
+
+    // Top-down RGBA8 to an uncompressed PNG, also used for software rendered frames
+    static bool writePNG(const std::string& path, int width, int height, const std::vector<unsigned char>& pixels);
+
+private:
+    static const size_t SlotCount = 4;   // Frames in flight between readback and the writer
+    static const size_t MaxQueued = 8;   // Copied frames waiting to be written before new ones are dropped
+
+    enum class SlotState { Free, Reading, Mapped };
+
+    struct Slot {
+        GLuint pbo{ 0 };
+        size_t bytes{ 0 };
+        GLsync fence{ nullptr };
+        SlotState state{ SlotState::Free };
+        std::atomic<bool> released{ false }; // Writer finished reading the mapped memory
+        int width{ 0 }, height{ 0 };
+        std::string path;
+        CaptureFormat format{ CaptureFormat::PNG };
+    };
+
+    // A mapped slot to copy out, or a copied frame to write
+    struct Job {
+        Slot* slot{ nullptr };
+        const unsigned char* mapped{ nullptr };
+        std::vector<unsigned char> pixels; // Top-down RGBA8
+        int width{ 0 }, height{ 0 };
+        std::string path;
+        CaptureFormat format{ CaptureFormat::PNG };
+    };
+
+    std::array<Slot, SlotCount> slots;
+    size_t nextRead{ 0 };  // Oldest slot that may be Reading, slots are used in ring order
+    size_t nextWrite{ 0 }; // Slot the next readback goes to
+
+    bool recording{ false };
+    std::string recordPrefix;
+    CaptureFormat recordFormat{ CaptureFormat::PNG };
+    size_t recordIndex{ 0 };
+    std::string screenshotPath;
+
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::deque<Job> jobs;          // Guarded by mutex
+    size_t busy{ 0 };              // Jobs taken by the writer and not finished, guarded by mutex
+    bool stopping{ false };        // Guarded by mutex
+    bool running{ false };
+
+    std::atomic<size_t> framesWritten{ 0 };
+    std::atomic<size_t> framesDropped{ 0 };
+    float captureCpuMs{ 0.0f };
+
+    void collect(bool wait);
+    void writerLoop();
+
+    static bool writeRaw(const std::string& path, const std::vector<unsigned char>& pixels);
+};
+
+#endif
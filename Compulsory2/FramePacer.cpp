@@ -0,0 +1,164 @@
+#include "FramePacer.h"
+#include <GLFW/glfw3.h>
+
+namespace {
+    const uint64_t HashSeed = 14695981039346656037ull; // FNV-1a
+    const uint64_t HashPrime = 1099511628211ull;
+
+    // GLFW callbacks carry no user data besides the window's own pointer, which is left to the game
+    FramePacer* hooked = nullptr;
+    GLFWcursorposfun previousCursorPos = nullptr;
+    GLFWcursorenterfun previousCursorEnter = nullptr;
+    GLFWmousebuttonfun previousMouseButton = nullptr;
+    GLFWscrollfun previousScroll = nullptr;
+    GLFWkeyfun previousKey = nullptr;
+    GLFWcharfun previousChar = nullptr;
+    GLFWwindowfocusfun previousFocus = nullptr;
+    GLFWwindowiconifyfun previousIconify = nullptr;
+    GLFWwindowrefreshfun previousRefresh = nullptr;
+    GLFWframebuffersizefun previousFramebufferSize = nullptr;
+
+    void onCursorPos(GLFWwindow* window, double x, double y) {
+        hooked->markChanged();
+        if (previousCursorPos)
+            previousCursorPos(window, x, y);
+    }
+
+    void onCursorEnter(GLFWwindow* window, int entered) {
+        hooked->markChanged();
+        if (previousCursorEnter)
+            previousCursorEnter(window, entered);
+    }
+
+    void onMouseButton(GLFWwindow* window, int button, int action, int mods) {
+        hooked->markChanged();
+        if (previousMouseButton)
+            previousMouseButton(window, button, action, mods);
+    }
+
+    void onScroll(GLFWwindow* window, double x, double y) {
+        hooked->markChanged();
+        if (previousScroll)
+            previousScroll(window, x, y);
+    }
+
+    void onKey(GLFWwindow* window, int key, int scancode, int action, int mods) {
+        hooked->markChanged();
+        if (previousKey)
+            previousKey(window, key, scancode, action, mods);
+    }
+
+    void onChar(GLFWwindow* window, unsigned int codepoint) {
+        hooked->markChanged();
+        if (previousChar)
+            previousChar(window, codepoint);
+    }
+
+    void onFocus(GLFWwindow* window, int focused) {
+        hooked->markChanged();
+        if (previousFocus)
+            previousFocus(window, focused);
+    }
+
+    void onIconify(GLFWwindow* window, int iconified) {
+        hooked->markChanged();
+        if (previousIconify)
+            previousIconify(window, iconified);
+    }
+
+    // The window system lost the contents, e.g. after being uncovered
+    void onRefresh(GLFWwindow* window) {
+        hooked->markChanged();
+        if (previousRefresh)
+            previousRefresh(window);
+    }
+
+    void onFramebufferSize(GLFWwindow* window, int width, int height) {
+        hooked->markChanged();
+        if (previousFramebufferSize)
+            previousFramebufferSize(window, width, height);
+    }
+}
+
+void FramePacer::initialize(GLFWwindow* window) {
+    this->window = window;
+    hooked = this;
+    previousCursorPos = glfwSetCursorPosCallback(window, onCursorPos);
+    previousCursorEnter = glfwSetCursorEnterCallback(window, onCursorEnter);
+    previousMouseButton = glfwSetMouseButtonCallback(window, onMouseButton);
+    previousScroll = glfwSetScrollCallback(window, onScroll);
+    previousKey = glfwSetKeyCallback(window, onKey);
+    previousChar = glfwSetCharCallback(window, onChar);
+    previousFocus = glfwSetWindowFocusCallback(window, onFocus);
+    previousIconify = glfwSetWindowIconifyCallback(window, onIconify);
+    previousRefresh = glfwSetWindowRefreshCallback(window, onRefresh);
+    previousFramebufferSize = glfwSetFramebufferSizeCallback(window, onFramebufferSize);
+
+    hash = lastHash = HashSeed;
+    changed = true;
+    lastFrameTime = windowStart = glfwGetTime();
+}
+
+double FramePacer::waitEvents() {
+    lastHash = hash;
+    hash = HashSeed;
+
+    double start = glfwGetTime();
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED)) {
+        glfwWaitEventsTimeout(MinimizedTimeout);
+        return glfwGetTime() - start;
+    }
+
+    if (onDemand && framesToSettle == 0 && !changed) {
+        glfwWaitEventsTimeout(idleTimeout);
+        return glfwGetTime() - start;
+    }
+
+    // Without focus the game keeps running, just at a lower rate. Events may wake the wait early,
+    // so it is repeated until the frame's time is up.
+    if (unfocusedFps > 0.0f && !glfwGetWindowAttrib(window, GLFW_FOCUSED)) {
+        double next = lastFrameTime + 1.0 / unfocusedFps;
+        for (double now = start; now < next; now = glfwGetTime())
+            glfwWaitEventsTimeout(next - now);
+        return 0.0;
+    }
+
+    glfwPollEvents();
+    return 0.0;
+}
+
+void FramePacer::watch(const void* data, size_t bytes) {
+    const unsigned char* bytePointer = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < bytes; ++i) {
+        hash ^= bytePointer[i];
+        hash *= HashPrime;
+    }
+}
+
+bool FramePacer::shouldRender() {
+    if (hash != lastHash)
+        changed = true;
+    // This frame and the settling ones after it
+    if (changed)
+        framesToSettle = settleFrames + 1;
+    changed = false;
+
+    bool minimized = glfwGetWindowAttrib(window, GLFW_ICONIFIED) != 0;
+    bool render = !minimized && (!onDemand || framesToSettle > 0);
+    if (render && framesToSettle > 0)
+        --framesToSettle;
+
+    double now = glfwGetTime();
+    ++loops;
+    if (render) {
+        ++frames;
+        lastFrameTime = now;
+    }
+    if (now - windowStart >= 1.0) {
+        loopsPerSecond = static_cast<float>(loops / (now - windowStart));
+        framesPerSecond = static_cast<float>(frames / (now - windowStart));
+        loops = frames = 0;
+        windowStart = now;
+    }
+    return render;
+}
@@ -0,0 +1,66 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct GLFWwindow;
+
+// Render on demand: decides each loop iteration whether the scene has to be drawn again and how long the
+// loop may sleep. A frame is drawn when a window event arrived or any watched state differs from the
+// previous iteration, plus a few settling frames after that for ImGui hover and layout. With nothing changing
+// the loop waits on window events with a timeout instead of spinning. It also sleeps while the window is
+// minimized and caps the frame rate while unfocused.
+class FramePacer {
+public:
+    // Hooks the window's input and window callbacks, chaining to any already installed.
+    // Call before ImGui installs its own so those chain to these.
+    void initialize(GLFWwindow* window);
+
+    // Replaces glfwPollEvents at the top of the loop. Returns the seconds slept while idle or minimized;
+    // nothing was moving then, so callers leave that time out of the simulation step.
+    double waitEvents();
+
+    // Change sources for this iteration, compared with what was watched the iteration before
+    void watch(const void* data, size_t bytes);
+    template <typename T> void watch(const T& value) { watch(&value, sizeof(T)); }
+    template <typename T> void watch(const std::vector<T>& values) {
+        size_t count = values.size();
+        watch(&count, sizeof(count));
+        watch(values.data(), values.size() * sizeof(T));
+    }
+    // Anything else that has to show, e.g. animation or a capture in progress
+    void markChanged() { changed = true; }
+
+    // Call after updating and watching, before drawing. False while minimized.
+    bool shouldRender();
+
+    // Settings, editable at runtime
+    bool onDemand{ true };
+    float idleTimeout{ 0.25f };  // Longest sleep while idle, seconds; the simulation still gets a tick this often
+    float unfocusedFps{ 10.0f }; // Frame rate cap without focus, 0 for none
+    int settleFrames{ 3 };       // Frames drawn after the last change
+
+    // Loop iterations and rendered frames over the last second
+    float getLoopsPerSecond() const { return loopsPerSecond; }
+    float getFramesPerSecond() const { return framesPerSecond; }
+    bool isIdle() const { return framesToSettle == 0; }
+
+private:
+    static constexpr double MinimizedTimeout = 0.5; // Seconds between ticks while minimized
+
+    GLFWwindow* window{ nullptr };
+
+    uint64_t hash{ 0 };     // Of everything watched this iteration
+    uint64_t lastHash{ 0 };
+    bool changed{ true };
+    int framesToSettle{ 0 };
+    double lastFrameTime{ 0.0 }; // When the last frame was drawn, for the unfocused cap
+
+    double windowStart{ 0.0 };
+    unsigned int loops{ 0 }, frames{ 0 };
+    float loopsPerSecond{ 0.0f }, framesPerSecond{ 0.0f };
+};
+
+#endif
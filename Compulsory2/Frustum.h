@@ -0,0 +1,43 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+// View frustum as six normalized planes pointing inwards
+struct Frustum {
+    glm::vec4 planes[6];
+
+    explicit Frustum(const glm::mat4& viewProjection) {
+        // Gribb & Hartmann: rows of the combined matrix added to / subtracted from the w row
+        glm::mat4 m = glm::transpose(viewProjection);
+        planes[0] = m[3] + m[0]; // Left
+        planes[1] = m[3] - m[0]; // Right
+        planes[2] = m[3] + m[1]; // Bottom
+        planes[3] = m[3] - m[1]; // Top
+        planes[4] = m[3] + m[2]; // Near
+        planes[5] = m[3] - m[2]; // Far
+        for (glm::vec4& plane : planes)
+            plane /= glm::length(glm::vec3(plane));
+    }
+
+    bool intersectsSphere(const glm::vec3& center, float radius) const {
+        for (const glm::vec4& plane : planes) {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    // Conservative: the box is kept unless it is fully outside one plane
+    bool intersectsBox(const glm::vec3& min, const glm::vec3& max) const {
+        for (const glm::vec4& plane : planes) {
+            // Corner furthest along the plane normal
+            glm::vec3 corner(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y, plane.z >= 0.0f ? max.z : min.z);
+            if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+                return false;
+        }
+        return true;
+    }
+};
+
+#endif
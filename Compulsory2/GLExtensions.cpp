@@ -0,0 +1,72 @@
+#include "GLExtensions.h"
+#include <GLFW/glfw3.h>
+#include <cstring>
+#include <iostream>
+
+int GLExtensions::glMajor = 3;
+int GLExtensions::glMinor = 3;
+
+bool GLExtensions::programBinary = false;
+PFNGLGETPROGRAMBINARYPROC_EXT GLExtensions::GetProgramBinary = nullptr;
+PFNGLPROGRAMBINARYPROC_EXT GLExtensions::ProgramBinary = nullptr;
+PFNGLPROGRAMPARAMETERIPROC_EXT GLExtensions::ProgramParameteri = nullptr;
+
+bool GLExtensions::gpuCulling = false;
+PFNGLDISPATCHCOMPUTEPROC_EXT GLExtensions::DispatchCompute = nullptr;
+PFNGLMEMORYBARRIERPROC_EXT GLExtensions::MemoryBarrierProc = nullptr;
+PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT GLExtensions::MultiDrawElementsIndirect = nullptr;
+
+bool GLExtensions::viewportArray = false;
+PFNGLVIEWPORTARRAYVPROC_EXT GLExtensions::ViewportArrayv = nullptr;
+
+namespace {
+    template <typename T>
+    T loadProc(const char* name) {
+        return reinterpret_cast<T>(glfwGetProcAddress(name));
+    }
+}
+
+bool GLExtensions::hasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && std::strcmp(extension, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+void GLExtensions::load() {
+    glGetIntegerv(GL_MAJOR_VERSION, &glMajor);
+    glGetIntegerv(GL_MINOR_VERSION, &glMinor);
+
+    if (isVersionAtLeast(4, 1) || hasExtension("GL_ARB_get_program_binary")) {
+        GetProgramBinary = loadProc<PFNGLGETPROGRAMBINARYPROC_EXT>("glGetProgramBinary");
+        ProgramBinary = loadProc<PFNGLPROGRAMBINARYPROC_EXT>("glProgramBinary");
+        ProgramParameteri = loadProc<PFNGLPROGRAMPARAMETERIPROC_EXT>("glProgramParameteri");
+
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        programBinary = GetProgramBinary && ProgramBinary && ProgramParameteri && formats > 0;
+    }
+
+    if (isVersionAtLeast(4, 3)) {
+        DispatchCompute = loadProc<PFNGLDISPATCHCOMPUTEPROC_EXT>("glDispatchCompute");
+        MemoryBarrierProc = loadProc<PFNGLMEMORYBARRIERPROC_EXT>("glMemoryBarrier");
+        MultiDrawElementsIndirect = loadProc<PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT>("glMultiDrawElementsIndirect");
+        gpuCulling = DispatchCompute && MemoryBarrierProc && MultiDrawElementsIndirect;
+    }
+
+    if (isVersionAtLeast(4, 1)) {
+        ViewportArrayv = loadProc<PFNGLVIEWPORTARRAYVPROC_EXT>("glViewportArrayv");
+        GLint viewports = 0;
+        glGetIntegerv(GL_MAX_VIEWPORTS, &viewports);
+        viewportArray = ViewportArrayv && viewports >= 4;
+    }
+
+    std::cout << "OpenGL " << glMajor << "." << glMinor
+        << (programBinary ? ", program binaries supported" : "")
+        << (gpuCulling ? ", GPU culling supported" : "")
+        << (viewportArray ? ", viewport arrays supported" : "") << "\n";
+}
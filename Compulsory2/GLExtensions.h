@@ -0,0 +1,68 @@
+#ifndef GL_EXTENSIONS_H
+#define GL_EXTENSIONS_H
+
+#include <glad/glad.h>
+
+// glad is generated for GL 3.3 core, so newer entry points are loaded here when the driver has them.
+// Every feature has a flag, callers keep a 3.3 path for when it is false.
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#endif
+
+#ifndef GL_SHADER_STORAGE_BUFFER
+#define GL_SHADER_STORAGE_BUFFER 0x90D2
+#define GL_COMPUTE_SHADER 0x91B9
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x00000001
+#define GL_COMMAND_BARRIER_BIT 0x00000040
+#define GL_BUFFER_UPDATE_BARRIER_BIT 0x00000200
+#define GL_SHADER_STORAGE_BARRIER_BIT 0x00002000
+#endif
+
+#ifndef GL_MAX_VIEWPORTS
+#define GL_MAX_VIEWPORTS 0x825B
+#endif
+
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC_EXT)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC_EXT)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC_EXT)(GLuint program, GLenum pname, GLint value);
+typedef void (APIENTRYP PFNGLDISPATCHCOMPUTEPROC_EXT)(GLuint groupsX, GLuint groupsY, GLuint groupsZ);
+typedef void (APIENTRYP PFNGLMEMORYBARRIERPROC_EXT)(GLbitfield barriers);
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT)(GLenum mode, GLenum type, const void* indirect, GLsizei drawCount, GLsizei stride);
+typedef void (APIENTRYP PFNGLVIEWPORTARRAYVPROC_EXT)(GLuint first, GLsizei count, const GLfloat* v);
+
+class GLExtensions {
+public:
+    // Call once after gladLoadGLLoader with the context current
+    static void load();
+
+    static bool hasExtension(const char* name);
+    static bool isVersionAtLeast(int major, int minor) { return glMajor > major || (glMajor == major && glMinor >= minor); }
+
+    // GL 4.1 / ARB_get_program_binary, also requires at least one binary format
+    static bool programBinary;
+    static PFNGLGETPROGRAMBINARYPROC_EXT GetProgramBinary;
+    static PFNGLPROGRAMBINARYPROC_EXT ProgramBinary;
+    static PFNGLPROGRAMPARAMETERIPROC_EXT ProgramParameteri;
+
+    // GL 4.3 compute shaders, SSBOs and multi-draw indirect, all three or nothing.
+    // Needs a 4.3 context since the culling shader is #version 430.
+    static bool gpuCulling;
+    static PFNGLDISPATCHCOMPUTEPROC_EXT DispatchCompute;
+    static PFNGLMEMORYBARRIERPROC_EXT MemoryBarrierProc; // winnt.h already defines MemoryBarrier as a macro
+    static PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT MultiDrawElementsIndirect;
+
+    // GL 4.1 viewport arrays with at least four viewports, for single-pass split-screen.
+    // The geometry shader writing gl_ViewportIndex is #version 410.
+    static bool viewportArray;
+    static PFNGLVIEWPORTARRAYVPROC_EXT ViewportArrayv;
+
+private:
+    static int glMajor, glMinor;
+};
+
+#endif
@@ -0,0 +1,380 @@
+// Every entry point glad loads for GL 3.3 core, generated from glad.h.
+// GL_FUNCTION(pointer type, return type, name without the gl prefix, (parameters), (arguments))
+// Define GL_FUNCTION before including, it is undefined again at the end.
+
+GL_FUNCTION(PFNGLCULLFACEPROC, void, CullFace, (GLenum mode), (mode))
+GL_FUNCTION(PFNGLFRONTFACEPROC, void, FrontFace, (GLenum mode), (mode))
+GL_FUNCTION(PFNGLHINTPROC, void, Hint, (GLenum target, GLenum mode), (target, mode))
+GL_FUNCTION(PFNGLLINEWIDTHPROC, void, LineWidth, (GLfloat width), (width))
+GL_FUNCTION(PFNGLPOINTSIZEPROC, void, PointSize, (GLfloat size), (size))
+GL_FUNCTION(PFNGLPOLYGONMODEPROC, void, PolygonMode, (GLenum face, GLenum mode), (face, mode))
+GL_FUNCTION(PFNGLSCISSORPROC, void, Scissor, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+GL_FUNCTION(PFNGLTEXPARAMETERFPROC, void, TexParameterf, (GLenum target, GLenum pname, GLfloat param), (target, pname, param))
+GL_FUNCTION(PFNGLTEXPARAMETERFVPROC, void, TexParameterfv, (GLenum target, GLenum pname, const GLfloat *params), (target, pname, params))
+GL_FUNCTION(PFNGLTEXPARAMETERIPROC, void, TexParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param))
+GL_FUNCTION(PFNGLTEXPARAMETERIVPROC, void, TexParameteriv, (GLenum target, GLenum pname, const GLint *params), (target, pname, params))
+GL_FUNCTION(PFNGLTEXIMAGE1DPROC, void, TexImage1D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, border, format, type, pixels))
+GL_FUNCTION(PFNGLTEXIMAGE2DPROC, void, TexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, height, border, format, type, pixels))
+GL_FUNCTION(PFNGLDRAWBUFFERPROC, void, DrawBuffer, (GLenum buf), (buf))
+GL_FUNCTION(PFNGLCLEARPROC, void, Clear, (GLbitfield mask), (mask))
+GL_FUNCTION(PFNGLCLEARCOLORPROC, void, ClearColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha))
+GL_FUNCTION(PFNGLCLEARSTENCILPROC, void, ClearStencil, (GLint s), (s))
+GL_FUNCTION(PFNGLCLEARDEPTHPROC, void, ClearDepth, (GLdouble depth), (depth))
+GL_FUNCTION(PFNGLSTENCILMASKPROC, void, StencilMask, (GLuint mask), (mask))
+GL_FUNCTION(PFNGLCOLORMASKPROC, void, ColorMask, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), (red, green, blue, alpha))
+GL_FUNCTION(PFNGLDEPTHMASKPROC, void, DepthMask, (GLboolean flag), (flag))
+GL_FUNCTION(PFNGLDISABLEPROC, void, Disable, (GLenum cap), (cap))
+GL_FUNCTION(PFNGLENABLEPROC, void, Enable, (GLenum cap), (cap))
+GL_FUNCTION(PFNGLFINISHPROC, void, Finish, (void), ())
+GL_FUNCTION(PFNGLFLUSHPROC, void, Flush, (void), ())
+GL_FUNCTION(PFNGLBLENDFUNCPROC, void, BlendFunc, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor))
+GL_FUNCTION(PFNGLLOGICOPPROC, void, LogicOp, (GLenum opcode), (opcode))
+GL_FUNCTION(PFNGLSTENCILFUNCPROC, void, StencilFunc, (GLenum func, GLint ref, GLuint mask), (func, ref, mask))
+GL_FUNCTION(PFNGLSTENCILOPPROC, void, StencilOp, (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass))
+GL_FUNCTION(PFNGLDEPTHFUNCPROC, void, DepthFunc, (GLenum func), (func))
+GL_FUNCTION(PFNGLPIXELSTOREFPROC, void, PixelStoref, (GLenum pname, GLfloat param), (pname, param))
+GL_FUNCTION(PFNGLPIXELSTOREIPROC, void, PixelStorei, (GLenum pname, GLint param), (pname, param))
+GL_FUNCTION(PFNGLREADBUFFERPROC, void, ReadBuffer, (GLenum src), (src))
+GL_FUNCTION(PFNGLREADPIXELSPROC, void, ReadPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels), (x, y, width, height, format, type, pixels))
+GL_FUNCTION(PFNGLGETBOOLEANVPROC, void, GetBooleanv, (GLenum pname, GLboolean *data), (pname, data))
+GL_FUNCTION(PFNGLGETDOUBLEVPROC, void, GetDoublev, (GLenum pname, GLdouble *data), (pname, data))
+GL_FUNCTION(PFNGLGETERRORPROC, GLenum, GetError, (void), ())
+GL_FUNCTION(PFNGLGETFLOATVPROC, void, GetFloatv, (GLenum pname, GLfloat *data), (pname, data))
+GL_FUNCTION(PFNGLGETINTEGERVPROC, void, GetIntegerv, (GLenum pname, GLint *data), (pname, data))
+GL_FUNCTION(PFNGLGETSTRINGPROC, const GLubyte *, GetString, (GLenum name), (name))
+GL_FUNCTION(PFNGLGETTEXIMAGEPROC, void, GetTexImage, (GLenum target, GLint level, GLenum format, GLenum type, void *pixels), (target, level, format, type, pixels))
+GL_FUNCTION(PFNGLGETTEXPARAMETERFVPROC, void, GetTexParameterfv, (GLenum target, GLenum pname, GLfloat *params), (target, pname, params))
+GL_FUNCTION(PFNGLGETTEXPARAMETERIVPROC, void, GetTexParameteriv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_FUNCTION(PFNGLGETTEXLEVELPARAMETERFVPROC, void, GetTexLevelParameterfv, (GLenum target, GLint level, GLenum pname, GLfloat *params), (target, level, pname, params))
+GL_FUNCTION(PFNGLGETTEXLEVELPARAMETERIVPROC, void, GetTexLevelParameteriv, (GLenum target, GLint level, GLenum pname, GLint *params), (target, level, pname, params))
+GL_FUNCTION(PFNGLISENABLEDPROC, GLboolean, IsEnabled, (GLenum cap), (cap))
+GL_FUNCTION(PFNGLDEPTHRANGEPROC, void, DepthRange, (GLdouble n, GLdouble f), (n, f))
+GL_FUNCTION(PFNGLVIEWPORTPROC, void, Viewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+GL_FUNCTION(PFNGLDRAWARRAYSPROC, void, DrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count))
+GL_FUNCTION(PFNGLDRAWELEMENTSPROC, void, DrawElements, (GLenum mode, GLsizei count, GLenum type, const void *indices), (mode, count, type, indices))
+GL_FUNCTION(PFNGLPOLYGONOFFSETPROC, void, PolygonOffset, (GLfloat factor, GLfloat units), (factor, units))
+GL_FUNCTION(PFNGLCOPYTEXIMAGE1DPROC, void, CopyTexImage1D, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border), (target, level, internalformat, x, y, width, border))
+GL_FUNCTION(PFNGLCOPYTEXIMAGE2DPROC, void, CopyTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border), (target, level, internalformat, x, y, width, height, border))
+GL_FUNCTION(PFNGLCOPYTEXSUBIMAGE1DPROC, void, CopyTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width), (target, level, xoffset, x, y, width))
+GL_FUNCTION(PFNGLCOPYTEXSUBIMAGE2DPROC, void, CopyTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, x, y, width, height))
+GL_FUNCTION(PFNGLTEXSUBIMAGE1DPROC, void, TexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, width, format, type, pixels))
+GL_FUNCTION(PFNGLTEXSUBIMAGE2DPROC, void, TexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, yoffset, width, height, format, type, pixels))
+GL_FUNCTION(PFNGLBINDTEXTUREPROC, void, BindTexture, (GLenum target, GLuint texture), (target, texture))
+GL_FUNCTION(PFNGLDELETETEXTURESPROC, void, DeleteTextures, (GLsizei n, const GLuint *textures), (n, textures))
+GL_FUNCTION(PFNGLGENTEXTURESPROC, void, GenTextures, (GLsizei n, GLuint *textures), (n, textures))
+GL_FUNCTION(PFNGLISTEXTUREPROC, GLboolean, IsTexture, (GLuint texture), (texture))
+GL_FUNCTION(PFNGLDRAWRANGEELEMENTSPROC, void, DrawRangeElements, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices), (mode, start, end, count, type, indices))
+GL_FUNCTION(PFNGLTEXIMAGE3DPROC, void, TexImage3D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, height, depth, border, format, type, pixels))
+GL_FUNCTION(PFNGLTEXSUBIMAGE3DPROC, void, TexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels))
+GL_FUNCTION(PFNGLCOPYTEXSUBIMAGE3DPROC, void, CopyTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, zoffset, x, y, width, height))
+GL_FUNCTION(PFNGLACTIVETEXTUREPROC, void, ActiveTexture, (GLenum texture), (texture))
+GL_FUNCTION(PFNGLSAMPLECOVERAGEPROC, void, SampleCoverage, (GLfloat value, GLboolean invert), (value, invert))
+GL_FUNCTION(PFNGLCOMPRESSEDTEXIMAGE3DPROC, void, CompressedTexImage3D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, height, depth, border, imageSize, data))
+GL_FUNCTION(PFNGLCOMPRESSEDTEXIMAGE2DPROC, void, CompressedTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, height, border, imageSize, data))
+GL_FUNCTION(PFNGLCOMPRESSEDTEXIMAGE1DPROC, void, CompressedTexImage1D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, border, imageSize, data))
+GL_FUNCTION(PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC, void, CompressedTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data))
+GL_FUNCTION(PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC, void, CompressedTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, yoffset, width, height, format, imageSize, data))
+GL_FUNCTION(PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC, void, CompressedTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, width, format, imageSize, data))
+GL_FUNCTION(PFNGLGETCOMPRESSEDTEXIMAGEPROC, void, GetCompressedTexImage, (GLenum target, GLint level, void *img), (target, level, img))
+GL_FUNCTION(PFNGLBLENDFUNCSEPARATEPROC, void, BlendFuncSeparate, (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha), (sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha))
+GL_FUNCTION(PFNGLMULTIDRAWARRAYSPROC, void, MultiDrawArrays, (GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount), (mode, first, count, drawcount))
+GL_FUNCTION(PFNGLMULTIDRAWELEMENTSPROC, void, MultiDrawElements, (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount), (mode, count, type, indices, drawcount))
+GL_FUNCTION(PFNGLPOINTPARAMETERFPROC, void, PointParameterf, (GLenum pname, GLfloat param), (pname, param))
+GL_FUNCTION(PFNGLPOINTPARAMETERFVPROC, void, PointParameterfv, (GLenum pname, const GLfloat *params), (pname, params))
+GL_FUNCTION(PFNGLPOINTPARAMETERIPROC, void, PointParameteri, (GLenum pname, GLint param), (pname, param))
+GL_FUNCTION(PFNGLPOINTPARAMETERIVPROC, void, PointParameteriv, (GLenum pname, const GLint *params), (pname, params))
+GL_FUNCTION(PFNGLBLENDCOLORPROC, void, BlendColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha))
+GL_FUNCTION(PFNGLBLENDEQUATIONPROC, void, BlendEquation, (GLenum mode), (mode))
+GL_FUNCTION(PFNGLGENQUERIESPROC, void, GenQueries, (GLsizei n, GLuint *ids), (n, ids))
+GL_FUNCTION(PFNGLDELETEQUERIESPROC, void, DeleteQueries, (GLsizei n, const GLuint *ids), (n, ids))
+GL_FUNCTION(PFNGLISQUERYPROC, GLboolean, IsQuery, (GLuint id), (id))
+GL_FUNCTION(PFNGLBEGINQUERYPROC, void, BeginQuery, (GLenum target, GLuint id), (target, id))
+GL_FUNCTION(PFNGLENDQUERYPROC, void, EndQuery, (GLenum target), (target))
+GL_FUNCTION(PFNGLGETQUERYIVPROC, void, GetQueryiv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_FUNCTION(PFNGLGETQUERYOBJECTIVPROC, void, GetQueryObjectiv, (GLuint id, GLenum pname, GLint *params), (id, pname, params))
+GL_FUNCTION(PFNGLGETQUERYOBJECTUIVPROC, void, GetQueryObjectuiv, (GLuint id, GLenum pname, GLuint *params), (id, pname, params))
+GL_FUNCTION(PFNGLBINDBUFFERPROC, void, BindBuffer, (GLenum target, GLuint buffer), (target, buffer))
+GL_FUNCTION(PFNGLDELETEBUFFERSPROC, void, DeleteBuffers, (GLsizei n, const GLuint *buffers), (n, buffers))
+GL_FUNCTION(PFNGLGENBUFFERSPROC, void, GenBuffers, (GLsizei n, GLuint *buffers), (n, buffers))
+GL_FUNCTION(PFNGLISBUFFERPROC, GLboolean, IsBuffer, (GLuint buffer), (buffer))
+GL_FUNCTION(PFNGLBUFFERDATAPROC, void, BufferData, (GLenum target, GLsizeiptr size, const void *data, GLenum usage), (target, size, data, usage))
+GL_FUNCTION(PFNGLBUFFERSUBDATAPROC, void, BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void *data), (target, offset, size, data))
+GL_FUNCTION(PFNGLGETBUFFERSUBDATAPROC, void, GetBufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, void *data), (target, offset, size, data))
+GL_FUNCTION(PFNGLMAPBUFFERPROC, void *, MapBuffer, (GLenum target, GLenum access), (target, access))
+GL_FUNCTION(PFNGLUNMAPBUFFERPROC, GLboolean, UnmapBuffer, (GLenum target), (target))
+GL_FUNCTION(PFNGLGETBUFFERPARAMETERIVPROC, void, GetBufferParameteriv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_FUNCTION(PFNGLGETBUFFERPOINTERVPROC, void, GetBufferPointerv, (GLenum target, GLenum pname, void **params), (target, pname, params))
+GL_FUNCTION(PFNGLBLENDEQUATIONSEPARATEPROC, void, BlendEquationSeparate, (GLenum modeRGB, GLenum modeAlpha), (modeRGB, modeAlpha))
+GL_FUNCTION(PFNGLDRAWBUFFERSPROC, void, DrawBuffers, (GLsizei n, const GLenum *bufs), (n, bufs))
+GL_FUNCTION(PFNGLSTENCILOPSEPARATEPROC, void, StencilOpSeparate, (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass), (face, sfail, dpfail, dppass))
+GL_FUNCTION(PFNGLSTENCILFUNCSEPARATEPROC, void, StencilFuncSeparate, (GLenum face, GLenum func, GLint ref, GLuint mask), (face, func, ref, mask))
+GL_FUNCTION(PFNGLSTENCILMASKSEPARATEPROC, void, StencilMaskSeparate, (GLenum face, GLuint mask), (face, mask))
+GL_FUNCTION(PFNGLATTACHSHADERPROC, void, AttachShader, (GLuint program, GLuint shader), (program, shader))
+GL_FUNCTION(PFNGLBINDATTRIBLOCATIONPROC, void, BindAttribLocation, (GLuint program, GLuint index, const GLchar *name), (program, index, name))
+GL_FUNCTION(PFNGLCOMPILESHADERPROC, void, CompileShader, (GLuint shader), (shader))
+GL_FUNCTION(PFNGLCREATEPROGRAMPROC, GLuint, CreateProgram, (void), ())
+GL_FUNCTION(PFNGLCREATESHADERPROC, GLuint, CreateShader, (GLenum type), (type))
+GL_FUNCTION(PFNGLDELETEPROGRAMPROC, void, DeleteProgram, (GLuint program), (program))
+GL_FUNCTION(PFNGLDELETESHADERPROC, void, DeleteShader, (GLuint shader), (shader))
+GL_FUNCTION(PFNGLDETACHSHADERPROC, void, DetachShader, (GLuint program, GLuint shader), (program, shader))
+GL_FUNCTION(PFNGLDISABLEVERTEXATTRIBARRAYPROC, void, DisableVertexAttribArray, (GLuint index), (index))
+GL_FUNCTION(PFNGLENABLEVERTEXATTRIBARRAYPROC, void, EnableVertexAttribArray, (GLuint index), (index))
+GL_FUNCTION(PFNGLGETACTIVEATTRIBPROC, void, GetActiveAttrib, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name))
+GL_FUNCTION(PFNGLGETACTIVEUNIFORMPROC, void, GetActiveUniform, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name))
+GL_FUNCTION(PFNGLGETATTACHEDSHADERSPROC, void, GetAttachedShaders, (GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders), (program, maxCount, count, shaders))
+GL_FUNCTION(PFNGLGETATTRIBLOCATIONPROC, GLint, GetAttribLocation, (GLuint program, const GLchar *name), (program, name))
+GL_FUNCTION(PFNGLGETPROGRAMIVPROC, void, GetProgramiv, (GLuint program, GLenum pname, GLint *params), (program, pname, params))
+GL_FUNCTION(PFNGLGETPROGRAMINFOLOGPROC, void, GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (program, bufSize, length, infoLog))
+GL_FUNCTION(PFNGLGETSHADERIVPROC, void, GetShaderiv, (GLuint shader, GLenum pname, GLint *params), (shader, pname, params))
+GL_FUNCTION(PFNGLGETSHADERINFOLOGPROC, void, GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (shader, bufSize, length, infoLog))
+GL_FUNCTION(PFNGLGETSHADERSOURCEPROC, void, GetShaderSource, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source), (shader, bufSize, length, source))
+GL_FUNCTION(PFNGLGETUNIFORMLOCATIONPROC, GLint, GetUniformLocation, (GLuint program, const GLchar *name), (program, name))
+GL_FUNCTION(PFNGLGETUNIFORMFVPROC, void, GetUniformfv, (GLuint program, GLint location, GLfloat *params), (program, location, params))
+GL_FUNCTION(PFNGLGETUNIFORMIVPROC, void, GetUniformiv, (GLuint program, GLint location, GLint *params), (program, location, params))
+GL_FUNCTION(PFNGLGETVERTEXATTRIBDVPROC, void, GetVertexAttribdv, (GLuint index, GLenum pname, GLdouble *params), (index, pname, params))
+GL_FUNCTION(PFNGLGETVERTEXATTRIBFVPROC, void, GetVertexAttribfv, (GLuint index, GLenum pname, GLfloat *params), (index, pname, params))
+GL_FUNCTION(PFNGLGETVERTEXATTRIBIVPROC, void, GetVertexAttribiv, (GLuint index, GLenum pname, GLint *params), (index, pname, params))
+GL_FUNCTION(PFNGLGETVERTEXATTRIBPOINTERVPROC, void, GetVertexAttribPointerv, (GLuint index, GLenum pname, void **pointer), (index, pname, pointer))
+GL_FUNCTION(PFNGLISPROGRAMPROC, GLboolean, IsProgram, (GLuint program), (program))
+GL_FUNCTION(PFNGLISSHADERPROC, GLboolean, IsShader, (GLuint shader), (shader))
+GL_FUNCTION(PFNGLLINKPROGRAMPROC, void, LinkProgram, (GLuint program), (program))
+GL_FUNCTION(PFNGLSHADERSOURCEPROC, void, ShaderSource, (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length), (shader, count, string, length))
+GL_FUNCTION(PFNGLUSEPROGRAMPROC, void, UseProgram, (GLuint program), (program))
+GL_FUNCTION(PFNGLUNIFORM1FPROC, void, Uniform1f, (GLint location, GLfloat v0), (location, v0))
+GL_FUNCTION(PFNGLUNIFORM2FPROC, void, Uniform2f, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1))
+GL_FUNCTION(PFNGLUNIFORM3FPROC, void, Uniform3f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2))
+GL_FUNCTION(PFNGLUNIFORM4FPROC, void, Uniform4f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3))
+GL_FUNCTION(PFNGLUNIFORM1IPROC, void, Uniform1i, (GLint location, GLint v0), (location, v0))
+GL_FUNCTION(PFNGLUNIFORM2IPROC, void, Uniform2i, (GLint location, GLint v0, GLint v1), (location, v0, v1))
+GL_FUNCTION(PFNGLUNIFORM3IPROC, void, Uniform3i, (GLint location, GLint v0, GLint v1, GLint v2), (location, v0, v1, v2))
+GL_FUNCTION(PFNGLUNIFORM4IPROC, void, Uniform4i, (GLint location, GLint v0, GLint v1, GLint v2, GLint v3), (location, v0, v1, v2, v3))
+GL_FUNCTION(PFNGLUNIFORM1FVPROC, void, Uniform1fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM2FVPROC, void, Uniform2fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM3FVPROC, void, Uniform3fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM4FVPROC, void, Uniform4fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM1IVPROC, void, Uniform1iv, (GLint location, GLsizei count, const GLint *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM2IVPROC, void, Uniform2iv, (GLint location, GLsizei count, const GLint *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM3IVPROC, void, Uniform3iv, (GLint location, GLsizei count, const GLint *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM4IVPROC, void, Uniform4iv, (GLint location, GLsizei count, const GLint *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORMMATRIX2FVPROC, void, UniformMatrix2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLUNIFORMMATRIX3FVPROC, void, UniformMatrix3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLUNIFORMMATRIX4FVPROC, void, UniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLVALIDATEPROGRAMPROC, void, ValidateProgram, (GLuint program), (program))
+GL_FUNCTION(PFNGLVERTEXATTRIB1DPROC, void, VertexAttrib1d, (GLuint index, GLdouble x), (index, x))
+GL_FUNCTION(PFNGLVERTEXATTRIB1DVPROC, void, VertexAttrib1dv, (GLuint index, const GLdouble *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB1FPROC, void, VertexAttrib1f, (GLuint index, GLfloat x), (index, x))
+GL_FUNCTION(PFNGLVERTEXATTRIB1FVPROC, void, VertexAttrib1fv, (GLuint index, const GLfloat *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB1SPROC, void, VertexAttrib1s, (GLuint index, GLshort x), (index, x))
+GL_FUNCTION(PFNGLVERTEXATTRIB1SVPROC, void, VertexAttrib1sv, (GLuint index, const GLshort *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB2DPROC, void, VertexAttrib2d, (GLuint index, GLdouble x, GLdouble y), (index, x, y))
+GL_FUNCTION(PFNGLVERTEXATTRIB2DVPROC, void, VertexAttrib2dv, (GLuint index, const GLdouble *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB2FPROC, void, VertexAttrib2f, (GLuint index, GLfloat x, GLfloat y), (index, x, y))
+GL_FUNCTION(PFNGLVERTEXATTRIB2FVPROC, void, VertexAttrib2fv, (GLuint index, const GLfloat *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB2SPROC, void, VertexAttrib2s, (GLuint index, GLshort x, GLshort y), (index, x, y))
+GL_FUNCTION(PFNGLVERTEXATTRIB2SVPROC, void, VertexAttrib2sv, (GLuint index, const GLshort *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB3DPROC, void, VertexAttrib3d, (GLuint index, GLdouble x, GLdouble y, GLdouble z), (index, x, y, z))
+GL_FUNCTION(PFNGLVERTEXATTRIB3DVPROC, void, VertexAttrib3dv, (GLuint index, const GLdouble *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB3FPROC, void, VertexAttrib3f, (GLuint index, GLfloat x, GLfloat y, GLfloat z), (index, x, y, z))
+GL_FUNCTION(PFNGLVERTEXATTRIB3FVPROC, void, VertexAttrib3fv, (GLuint index, const GLfloat *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB3SPROC, void, VertexAttrib3s, (GLuint index, GLshort x, GLshort y, GLshort z), (index, x, y, z))
+GL_FUNCTION(PFNGLVERTEXATTRIB3SVPROC, void, VertexAttrib3sv, (GLuint index, const GLshort *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4NBVPROC, void, VertexAttrib4Nbv, (GLuint index, const GLbyte *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4NIVPROC, void, VertexAttrib4Niv, (GLuint index, const GLint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4NSVPROC, void, VertexAttrib4Nsv, (GLuint index, const GLshort *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4NUBPROC, void, VertexAttrib4Nub, (GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w), (index, x, y, z, w))
+GL_FUNCTION(PFNGLVERTEXATTRIB4NUBVPROC, void, VertexAttrib4Nubv, (GLuint index, const GLubyte *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4NUIVPROC, void, VertexAttrib4Nuiv, (GLuint index, const GLuint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4NUSVPROC, void, VertexAttrib4Nusv, (GLuint index, const GLushort *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4BVPROC, void, VertexAttrib4bv, (GLuint index, const GLbyte *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4DPROC, void, VertexAttrib4d, (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w), (index, x, y, z, w))
+GL_FUNCTION(PFNGLVERTEXATTRIB4DVPROC, void, VertexAttrib4dv, (GLuint index, const GLdouble *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4FPROC, void, VertexAttrib4f, (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w), (index, x, y, z, w))
+GL_FUNCTION(PFNGLVERTEXATTRIB4FVPROC, void, VertexAttrib4fv, (GLuint index, const GLfloat *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4IVPROC, void, VertexAttrib4iv, (GLuint index, const GLint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4SPROC, void, VertexAttrib4s, (GLuint index, GLshort x, GLshort y, GLshort z, GLshort w), (index, x, y, z, w))
+GL_FUNCTION(PFNGLVERTEXATTRIB4SVPROC, void, VertexAttrib4sv, (GLuint index, const GLshort *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4UBVPROC, void, VertexAttrib4ubv, (GLuint index, const GLubyte *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4UIVPROC, void, VertexAttrib4uiv, (GLuint index, const GLuint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIB4USVPROC, void, VertexAttrib4usv, (GLuint index, const GLushort *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBPOINTERPROC, void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer), (index, size, type, normalized, stride, pointer))
+GL_FUNCTION(PFNGLUNIFORMMATRIX2X3FVPROC, void, UniformMatrix2x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLUNIFORMMATRIX3X2FVPROC, void, UniformMatrix3x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLUNIFORMMATRIX2X4FVPROC, void, UniformMatrix2x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLUNIFORMMATRIX4X2FVPROC, void, UniformMatrix4x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLUNIFORMMATRIX3X4FVPROC, void, UniformMatrix3x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLUNIFORMMATRIX4X3FVPROC, void, UniformMatrix4x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_FUNCTION(PFNGLCOLORMASKIPROC, void, ColorMaski, (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a), (index, r, g, b, a))
+GL_FUNCTION(PFNGLGETBOOLEANI_VPROC, void, GetBooleani_v, (GLenum target, GLuint index, GLboolean *data), (target, index, data))
+GL_FUNCTION(PFNGLGETINTEGERI_VPROC, void, GetIntegeri_v, (GLenum target, GLuint index, GLint *data), (target, index, data))
+GL_FUNCTION(PFNGLENABLEIPROC, void, Enablei, (GLenum target, GLuint index), (target, index))
+GL_FUNCTION(PFNGLDISABLEIPROC, void, Disablei, (GLenum target, GLuint index), (target, index))
+GL_FUNCTION(PFNGLISENABLEDIPROC, GLboolean, IsEnabledi, (GLenum target, GLuint index), (target, index))
+GL_FUNCTION(PFNGLBEGINTRANSFORMFEEDBACKPROC, void, BeginTransformFeedback, (GLenum primitiveMode), (primitiveMode))
+GL_FUNCTION(PFNGLENDTRANSFORMFEEDBACKPROC, void, EndTransformFeedback, (void), ())
+GL_FUNCTION(PFNGLBINDBUFFERRANGEPROC, void, BindBufferRange, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size))
+GL_FUNCTION(PFNGLBINDBUFFERBASEPROC, void, BindBufferBase, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer))
+GL_FUNCTION(PFNGLTRANSFORMFEEDBACKVARYINGSPROC, void, TransformFeedbackVaryings, (GLuint program, GLsizei count, const GLchar *const*varyings, GLenum bufferMode), (program, count, varyings, bufferMode))
+GL_FUNCTION(PFNGLGETTRANSFORMFEEDBACKVARYINGPROC, void, GetTransformFeedbackVarying, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name))
+GL_FUNCTION(PFNGLCLAMPCOLORPROC, void, ClampColor, (GLenum target, GLenum clamp), (target, clamp))
+GL_FUNCTION(PFNGLBEGINCONDITIONALRENDERPROC, void, BeginConditionalRender, (GLuint id, GLenum mode), (id, mode))
+GL_FUNCTION(PFNGLENDCONDITIONALRENDERPROC, void, EndConditionalRender, (void), ())
+GL_FUNCTION(PFNGLVERTEXATTRIBIPOINTERPROC, void, VertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer), (index, size, type, stride, pointer))
+GL_FUNCTION(PFNGLGETVERTEXATTRIBIIVPROC, void, GetVertexAttribIiv, (GLuint index, GLenum pname, GLint *params), (index, pname, params))
+GL_FUNCTION(PFNGLGETVERTEXATTRIBIUIVPROC, void, GetVertexAttribIuiv, (GLuint index, GLenum pname, GLuint *params), (index, pname, params))
+GL_FUNCTION(PFNGLVERTEXATTRIBI1IPROC, void, VertexAttribI1i, (GLuint index, GLint x), (index, x))
+GL_FUNCTION(PFNGLVERTEXATTRIBI2IPROC, void, VertexAttribI2i, (GLuint index, GLint x, GLint y), (index, x, y))
+GL_FUNCTION(PFNGLVERTEXATTRIBI3IPROC, void, VertexAttribI3i, (GLuint index, GLint x, GLint y, GLint z), (index, x, y, z))
+GL_FUNCTION(PFNGLVERTEXATTRIBI4IPROC, void, VertexAttribI4i, (GLuint index, GLint x, GLint y, GLint z, GLint w), (index, x, y, z, w))
+GL_FUNCTION(PFNGLVERTEXATTRIBI1UIPROC, void, VertexAttribI1ui, (GLuint index, GLuint x), (index, x))
+GL_FUNCTION(PFNGLVERTEXATTRIBI2UIPROC, void, VertexAttribI2ui, (GLuint index, GLuint x, GLuint y), (index, x, y))
+GL_FUNCTION(PFNGLVERTEXATTRIBI3UIPROC, void, VertexAttribI3ui, (GLuint index, GLuint x, GLuint y, GLuint z), (index, x, y, z))
+GL_FUNCTION(PFNGLVERTEXATTRIBI4UIPROC, void, VertexAttribI4ui, (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w), (index, x, y, z, w))
+GL_FUNCTION(PFNGLVERTEXATTRIBI1IVPROC, void, VertexAttribI1iv, (GLuint index, const GLint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI2IVPROC, void, VertexAttribI2iv, (GLuint index, const GLint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI3IVPROC, void, VertexAttribI3iv, (GLuint index, const GLint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI4IVPROC, void, VertexAttribI4iv, (GLuint index, const GLint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI1UIVPROC, void, VertexAttribI1uiv, (GLuint index, const GLuint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI2UIVPROC, void, VertexAttribI2uiv, (GLuint index, const GLuint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI3UIVPROC, void, VertexAttribI3uiv, (GLuint index, const GLuint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI4UIVPROC, void, VertexAttribI4uiv, (GLuint index, const GLuint *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI4BVPROC, void, VertexAttribI4bv, (GLuint index, const GLbyte *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI4SVPROC, void, VertexAttribI4sv, (GLuint index, const GLshort *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI4UBVPROC, void, VertexAttribI4ubv, (GLuint index, const GLubyte *v), (index, v))
+GL_FUNCTION(PFNGLVERTEXATTRIBI4USVPROC, void, VertexAttribI4usv, (GLuint index, const GLushort *v), (index, v))
+GL_FUNCTION(PFNGLGETUNIFORMUIVPROC, void, GetUniformuiv, (GLuint program, GLint location, GLuint *params), (program, location, params))
+GL_FUNCTION(PFNGLBINDFRAGDATALOCATIONPROC, void, BindFragDataLocation, (GLuint program, GLuint color, const GLchar *name), (program, color, name))
+GL_FUNCTION(PFNGLGETFRAGDATALOCATIONPROC, GLint, GetFragDataLocation, (GLuint program, const GLchar *name), (program, name))
+GL_FUNCTION(PFNGLUNIFORM1UIPROC, void, Uniform1ui, (GLint location, GLuint v0), (location, v0))
+GL_FUNCTION(PFNGLUNIFORM2UIPROC, void, Uniform2ui, (GLint location, GLuint v0, GLuint v1), (location, v0, v1))
+GL_FUNCTION(PFNGLUNIFORM3UIPROC, void, Uniform3ui, (GLint location, GLuint v0, GLuint v1, GLuint v2), (location, v0, v1, v2))
+GL_FUNCTION(PFNGLUNIFORM4UIPROC, void, Uniform4ui, (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (location, v0, v1, v2, v3))
+GL_FUNCTION(PFNGLUNIFORM1UIVPROC, void, Uniform1uiv, (GLint location, GLsizei count, const GLuint *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM2UIVPROC, void, Uniform2uiv, (GLint location, GLsizei count, const GLuint *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM3UIVPROC, void, Uniform3uiv, (GLint location, GLsizei count, const GLuint *value), (location, count, value))
+GL_FUNCTION(PFNGLUNIFORM4UIVPROC, void, Uniform4uiv, (GLint location, GLsizei count, const GLuint *value), (location, count, value))
+GL_FUNCTION(PFNGLTEXPARAMETERIIVPROC, void, TexParameterIiv, (GLenum target, GLenum pname, const GLint *params), (target, pname, params))
+GL_FUNCTION(PFNGLTEXPARAMETERIUIVPROC, void, TexParameterIuiv, (GLenum target, GLenum pname, const GLuint *params), (target, pname, params))
+GL_FUNCTION(PFNGLGETTEXPARAMETERIIVPROC, void, GetTexParameterIiv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_FUNCTION(PFNGLGETTEXPARAMETERIUIVPROC, void, GetTexParameterIuiv, (GLenum target, GLenum pname, GLuint *params), (target, pname, params))
+GL_FUNCTION(PFNGLCLEARBUFFERIVPROC, void, ClearBufferiv, (GLenum buffer, GLint drawbuffer, const GLint *value), (buffer, drawbuffer, value))
+GL_FUNCTION(PFNGLCLEARBUFFERUIVPROC, void, ClearBufferuiv, (GLenum buffer, GLint drawbuffer, const GLuint *value), (buffer, drawbuffer, value))
+GL_FUNCTION(PFNGLCLEARBUFFERFVPROC, void, ClearBufferfv, (GLenum buffer, GLint drawbuffer, const GLfloat *value), (buffer, drawbuffer, value))
+GL_FUNCTION(PFNGLCLEARBUFFERFIPROC, void, ClearBufferfi, (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil), (buffer, drawbuffer, depth, stencil))
+GL_FUNCTION(PFNGLGETSTRINGIPROC, const GLubyte *, GetStringi, (GLenum name, GLuint index), (name, index))
+GL_FUNCTION(PFNGLISRENDERBUFFERPROC, GLboolean, IsRenderbuffer, (GLuint renderbuffer), (renderbuffer))
+GL_FUNCTION(PFNGLBINDRENDERBUFFERPROC, void, BindRenderbuffer, (GLenum target, GLuint renderbuffer), (target, renderbuffer))
+GL_FUNCTION(PFNGLDELETERENDERBUFFERSPROC, void, DeleteRenderbuffers, (GLsizei n, const GLuint *renderbuffers), (n, renderbuffers))
+GL_FUNCTION(PFNGLGENRENDERBUFFERSPROC, void, GenRenderbuffers, (GLsizei n, GLuint *renderbuffers), (n, renderbuffers))
+GL_FUNCTION(PFNGLRENDERBUFFERSTORAGEPROC, void, RenderbufferStorage, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height), (target, internalformat, width, height))
+GL_FUNCTION(PFNGLGETRENDERBUFFERPARAMETERIVPROC, void, GetRenderbufferParameteriv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_FUNCTION(PFNGLISFRAMEBUFFERPROC, GLboolean, IsFramebuffer, (GLuint framebuffer), (framebuffer))
+GL_FUNCTION(PFNGLBINDFRAMEBUFFERPROC, void, BindFramebuffer, (GLenum target, GLuint framebuffer), (target, framebuffer))
+GL_FUNCTION(PFNGLDELETEFRAMEBUFFERSPROC, void, DeleteFramebuffers, (GLsizei n, const GLuint *framebuffers), (n, framebuffers))
+GL_FUNCTION(PFNGLGENFRAMEBUFFERSPROC, void, GenFramebuffers, (GLsizei n, GLuint *framebuffers), (n, framebuffers))
+GL_FUNCTION(PFNGLCHECKFRAMEBUFFERSTATUSPROC, GLenum, CheckFramebufferStatus, (GLenum target), (target))
+GL_FUNCTION(PFNGLFRAMEBUFFERTEXTURE1DPROC, void, FramebufferTexture1D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level))
+GL_FUNCTION(PFNGLFRAMEBUFFERTEXTURE2DPROC, void, FramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level))
+GL_FUNCTION(PFNGLFRAMEBUFFERTEXTURE3DPROC, void, FramebufferTexture3D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset), (target, attachment, textarget, texture, level, zoffset))
+GL_FUNCTION(PFNGLFRAMEBUFFERRENDERBUFFERPROC, void, FramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), (target, attachment, renderbuffertarget, renderbuffer))
+GL_FUNCTION(PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC, void, GetFramebufferAttachmentParameteriv, (GLenum target, GLenum attachment, GLenum pname, GLint *params), (target, attachment, pname, params))
+GL_FUNCTION(PFNGLGENERATEMIPMAPPROC, void, GenerateMipmap, (GLenum target), (target))
+GL_FUNCTION(PFNGLBLITFRAMEBUFFERPROC, void, BlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter))
+GL_FUNCTION(PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC, void, RenderbufferStorageMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (target, samples, internalformat, width, height))
+GL_FUNCTION(PFNGLFRAMEBUFFERTEXTURELAYERPROC, void, FramebufferTextureLayer, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer), (target, attachment, texture, level, layer))
+GL_FUNCTION(PFNGLMAPBUFFERRANGEPROC, void *, MapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), (target, offset, length, access))
+GL_FUNCTION(PFNGLFLUSHMAPPEDBUFFERRANGEPROC, void, FlushMappedBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length), (target, offset, length))
+GL_FUNCTION(PFNGLBINDVERTEXARRAYPROC, void, BindVertexArray, (GLuint array), (array))
+GL_FUNCTION(PFNGLDELETEVERTEXARRAYSPROC, void, DeleteVertexArrays, (GLsizei n, const GLuint *arrays), (n, arrays))
+GL_FUNCTION(PFNGLGENVERTEXARRAYSPROC, void, GenVertexArrays, (GLsizei n, GLuint *arrays), (n, arrays))
+GL_FUNCTION(PFNGLISVERTEXARRAYPROC, GLboolean, IsVertexArray, (GLuint array), (array))
+GL_FUNCTION(PFNGLDRAWARRAYSINSTANCEDPROC, void, DrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount), (mode, first, count, instancecount))
+GL_FUNCTION(PFNGLDRAWELEMENTSINSTANCEDPROC, void, DrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount), (mode, count, type, indices, instancecount))
+GL_FUNCTION(PFNGLTEXBUFFERPROC, void, TexBuffer, (GLenum target, GLenum internalformat, GLuint buffer), (target, internalformat, buffer))
+GL_FUNCTION(PFNGLPRIMITIVERESTARTINDEXPROC, void, PrimitiveRestartIndex, (GLuint index), (index))
+GL_FUNCTION(PFNGLCOPYBUFFERSUBDATAPROC, void, CopyBufferSubData, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readTarget, writeTarget, readOffset, writeOffset, size))
+GL_FUNCTION(PFNGLGETUNIFORMINDICESPROC, void, GetUniformIndices, (GLuint program, GLsizei uniformCount, const GLchar *const*uniformNames, GLuint *uniformIndices), (program, uniformCount, uniformNames, uniformIndices))
+GL_FUNCTION(PFNGLGETACTIVEUNIFORMSIVPROC, void, GetActiveUniformsiv, (GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params), (program, uniformCount, uniformIndices, pname, params))
+GL_FUNCTION(PFNGLGETACTIVEUNIFORMNAMEPROC, void, GetActiveUniformName, (GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName), (program, uniformIndex, bufSize, length, uniformName))
+GL_FUNCTION(PFNGLGETUNIFORMBLOCKINDEXPROC, GLuint, GetUniformBlockIndex, (GLuint program, const GLchar *uniformBlockName), (program, uniformBlockName))
+GL_FUNCTION(PFNGLGETACTIVEUNIFORMBLOCKIVPROC, void, GetActiveUniformBlockiv, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params), (program, uniformBlockIndex, pname, params))
+GL_FUNCTION(PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC, void, GetActiveUniformBlockName, (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName), (program, uniformBlockIndex, bufSize, length, uniformBlockName))
+GL_FUNCTION(PFNGLUNIFORMBLOCKBINDINGPROC, void, UniformBlockBinding, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding), (program, uniformBlockIndex, uniformBlockBinding))
+GL_FUNCTION(PFNGLDRAWELEMENTSBASEVERTEXPROC, void, DrawElementsBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex), (mode, count, type, indices, basevertex))
+GL_FUNCTION(PFNGLDRAWRANGEELEMENTSBASEVERTEXPROC, void, DrawRangeElementsBaseVertex, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices, GLint basevertex), (mode, start, end, count, type, indices, basevertex))
+GL_FUNCTION(PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC, void, DrawElementsInstancedBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex), (mode, count, type, indices, instancecount, basevertex))
+GL_FUNCTION(PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC, void, MultiDrawElementsBaseVertex, (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex), (mode, count, type, indices, drawcount, basevertex))
+GL_FUNCTION(PFNGLPROVOKINGVERTEXPROC, void, ProvokingVertex, (GLenum mode), (mode))
+GL_FUNCTION(PFNGLFENCESYNCPROC, GLsync, FenceSync, (GLenum condition, GLbitfield flags), (condition, flags))
+GL_FUNCTION(PFNGLISSYNCPROC, GLboolean, IsSync, (GLsync sync), (sync))
+GL_FUNCTION(PFNGLDELETESYNCPROC, void, DeleteSync, (GLsync sync), (sync))
+GL_FUNCTION(PFNGLCLIENTWAITSYNCPROC, GLenum, ClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout))
+GL_FUNCTION(PFNGLWAITSYNCPROC, void, WaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout))
+GL_FUNCTION(PFNGLGETINTEGER64VPROC, void, GetInteger64v, (GLenum pname, GLint64 *data), (pname, data))
+GL_FUNCTION(PFNGLGETSYNCIVPROC, void, GetSynciv, (GLsync sync, GLenum pname, GLsizei count, GLsizei *length, GLint *values), (sync, pname, count, length, values))
+GL_FUNCTION(PFNGLGETINTEGER64I_VPROC, void, GetInteger64i_v, (GLenum target, GLuint index, GLint64 *data), (target, index, data))
+GL_FUNCTION(PFNGLGETBUFFERPARAMETERI64VPROC, void, GetBufferParameteri64v, (GLenum target, GLenum pname, GLint64 *params), (target, pname, params))
+GL_FUNCTION(PFNGLFRAMEBUFFERTEXTUREPROC, void, FramebufferTexture, (GLenum target, GLenum attachment, GLuint texture, GLint level), (target, attachment, texture, level))
+GL_FUNCTION(PFNGLTEXIMAGE2DMULTISAMPLEPROC, void, TexImage2DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, fixedsamplelocations))
+GL_FUNCTION(PFNGLTEXIMAGE3DMULTISAMPLEPROC, void, TexImage3DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, depth, fixedsamplelocations))
+GL_FUNCTION(PFNGLGETMULTISAMPLEFVPROC, void, GetMultisamplefv, (GLenum pname, GLuint index, GLfloat *val), (pname, index, val))
+GL_FUNCTION(PFNGLSAMPLEMASKIPROC, void, SampleMaski, (GLuint maskNumber, GLbitfield mask), (maskNumber, mask))
+GL_FUNCTION(PFNGLBINDFRAGDATALOCATIONINDEXEDPROC, void, BindFragDataLocationIndexed, (GLuint program, GLuint colorNumber, GLuint index, const GLchar *name), (program, colorNumber, index, name))
+GL_FUNCTION(PFNGLGETFRAGDATAINDEXPROC, GLint, GetFragDataIndex, (GLuint program, const GLchar *name), (program, name))
+GL_FUNCTION(PFNGLGENSAMPLERSPROC, void, GenSamplers, (GLsizei count, GLuint *samplers), (count, samplers))
+GL_FUNCTION(PFNGLDELETESAMPLERSPROC, void, DeleteSamplers, (GLsizei count, const GLuint *samplers), (count, samplers))
+GL_FUNCTION(PFNGLISSAMPLERPROC, GLboolean, IsSampler, (GLuint sampler), (sampler))
+GL_FUNCTION(PFNGLBINDSAMPLERPROC, void, BindSampler, (GLuint unit, GLuint sampler), (unit, sampler))
+GL_FUNCTION(PFNGLSAMPLERPARAMETERIPROC, void, SamplerParameteri, (GLuint sampler, GLenum pname, GLint param), (sampler, pname, param))
+GL_FUNCTION(PFNGLSAMPLERPARAMETERIVPROC, void, SamplerParameteriv, (GLuint sampler, GLenum pname, const GLint *param), (sampler, pname, param))
+GL_FUNCTION(PFNGLSAMPLERPARAMETERFPROC, void, SamplerParameterf, (GLuint sampler, GLenum pname, GLfloat param), (sampler, pname, param))
+GL_FUNCTION(PFNGLSAMPLERPARAMETERFVPROC, void, SamplerParameterfv, (GLuint sampler, GLenum pname, const GLfloat *param), (sampler, pname, param))
+GL_FUNCTION(PFNGLSAMPLERPARAMETERIIVPROC, void, SamplerParameterIiv, (GLuint sampler, GLenum pname, const GLint *param), (sampler, pname, param))
+GL_FUNCTION(PFNGLSAMPLERPARAMETERIUIVPROC, void, SamplerParameterIuiv, (GLuint sampler, GLenum pname, const GLuint *param), (sampler, pname, param))
+GL_FUNCTION(PFNGLGETSAMPLERPARAMETERIVPROC, void, GetSamplerParameteriv, (GLuint sampler, GLenum pname, GLint *params), (sampler, pname, params))
+GL_FUNCTION(PFNGLGETSAMPLERPARAMETERIIVPROC, void, GetSamplerParameterIiv, (GLuint sampler, GLenum pname, GLint *params), (sampler, pname, params))
+GL_FUNCTION(PFNGLGETSAMPLERPARAMETERFVPROC, void, GetSamplerParameterfv, (GLuint sampler, GLenum pname, GLfloat *params), (sampler, pname, params))
+GL_FUNCTION(PFNGLGETSAMPLERPARAMETERIUIVPROC, void, GetSamplerParameterIuiv, (GLuint sampler, GLenum pname, GLuint *params), (sampler, pname, params))
+GL_FUNCTION(PFNGLQUERYCOUNTERPROC, void, QueryCounter, (GLuint id, GLenum target), (id, target))
+GL_FUNCTION(PFNGLGETQUERYOBJECTI64VPROC, void, GetQueryObjecti64v, (GLuint id, GLenum pname, GLint64 *params), (id, pname, params))
+GL_FUNCTION(PFNGLGETQUERYOBJECTUI64VPROC, void, GetQueryObjectui64v, (GLuint id, GLenum pname, GLuint64 *params), (id, pname, params))
+GL_FUNCTION(PFNGLVERTEXATTRIBDIVISORPROC, void, VertexAttribDivisor, (GLuint index, GLuint divisor), (index, divisor))
+GL_FUNCTION(PFNGLVERTEXATTRIBP1UIPROC, void, VertexAttribP1ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_FUNCTION(PFNGLVERTEXATTRIBP1UIVPROC, void, VertexAttribP1uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value))
+GL_FUNCTION(PFNGLVERTEXATTRIBP2UIPROC, void, VertexAttribP2ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_FUNCTION(PFNGLVERTEXATTRIBP2UIVPROC, void, VertexAttribP2uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value))
+GL_FUNCTION(PFNGLVERTEXATTRIBP3UIPROC, void, VertexAttribP3ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_FUNCTION(PFNGLVERTEXATTRIBP3UIVPROC, void, VertexAttribP3uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value))
+GL_FUNCTION(PFNGLVERTEXATTRIBP4UIPROC, void, VertexAttribP4ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_FUNCTION(PFNGLVERTEXATTRIBP4UIVPROC, void, VertexAttribP4uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value))
+GL_FUNCTION(PFNGLVERTEXP2UIPROC, void, VertexP2ui, (GLenum type, GLuint value), (type, value))
+GL_FUNCTION(PFNGLVERTEXP2UIVPROC, void, VertexP2uiv, (GLenum type, const GLuint *value), (type, value))
+GL_FUNCTION(PFNGLVERTEXP3UIPROC, void, VertexP3ui, (GLenum type, GLuint value), (type, value))
+GL_FUNCTION(PFNGLVERTEXP3UIVPROC, void, VertexP3uiv, (GLenum type, const GLuint *value), (type, value))
+GL_FUNCTION(PFNGLVERTEXP4UIPROC, void, VertexP4ui, (GLenum type, GLuint value), (type, value))
+GL_FUNCTION(PFNGLVERTEXP4UIVPROC, void, VertexP4uiv, (GLenum type, const GLuint *value), (type, value))
+GL_FUNCTION(PFNGLTEXCOORDP1UIPROC, void, TexCoordP1ui, (GLenum type, GLuint coords), (type, coords))
+GL_FUNCTION(PFNGLTEXCOORDP1UIVPROC, void, TexCoordP1uiv, (GLenum type, const GLuint *coords), (type, coords))
+GL_FUNCTION(PFNGLTEXCOORDP2UIPROC, void, TexCoordP2ui, (GLenum type, GLuint coords), (type, coords))
+GL_FUNCTION(PFNGLTEXCOORDP2UIVPROC, void, TexCoordP2uiv, (GLenum type, const GLuint *coords), (type, coords))
+GL_FUNCTION(PFNGLTEXCOORDP3UIPROC, void, TexCoordP3ui, (GLenum type, GLuint coords), (type, coords))
+GL_FUNCTION(PFNGLTEXCOORDP3UIVPROC, void, TexCoordP3uiv, (GLenum type, const GLuint *coords), (type, coords))
+GL_FUNCTION(PFNGLTEXCOORDP4UIPROC, void, TexCoordP4ui, (GLenum type, GLuint coords), (type, coords))
+GL_FUNCTION(PFNGLTEXCOORDP4UIVPROC, void, TexCoordP4uiv, (GLenum type, const GLuint *coords), (type, coords))
+GL_FUNCTION(PFNGLMULTITEXCOORDP1UIPROC, void, MultiTexCoordP1ui, (GLenum texture, GLenum type, GLuint coords), (texture, type, coords))
+GL_FUNCTION(PFNGLMULTITEXCOORDP1UIVPROC, void, MultiTexCoordP1uiv, (GLenum texture, GLenum type, const GLuint *coords), (texture, type, coords))
+GL_FUNCTION(PFNGLMULTITEXCOORDP2UIPROC, void, MultiTexCoordP2ui, (GLenum texture, GLenum type, GLuint coords), (texture, type, coords))
+GL_FUNCTION(PFNGLMULTITEXCOORDP2UIVPROC, void, MultiTexCoordP2uiv, (GLenum texture, GLenum type, const GLuint *coords), (texture, type, coords))
+GL_FUNCTION(PFNGLMULTITEXCOORDP3UIPROC, void, MultiTexCoordP3ui, (GLenum texture, GLenum type, GLuint coords), (texture, type, coords))
+GL_FUNCTION(PFNGLMULTITEXCOORDP3UIVPROC, void, MultiTexCoordP3uiv, (GLenum texture, GLenum type, const GLuint *coords), (texture, type, coords))
+GL_FUNCTION(PFNGLMULTITEXCOORDP4UIPROC, void, MultiTexCoordP4ui, (GLenum texture, GLenum type, GLuint coords), (texture, type, coords))
+GL_FUNCTION(PFNGLMULTITEXCOORDP4UIVPROC, void, MultiTexCoordP4uiv, (GLenum texture, GLenum type, const GLuint *coords), (texture, type, coords))
+GL_FUNCTION(PFNGLNORMALP3UIPROC, void, NormalP3ui, (GLenum type, GLuint coords), (type, coords))
+GL_FUNCTION(PFNGLNORMALP3UIVPROC, void, NormalP3uiv, (GLenum type, const GLuint *coords), (type, coords))
+GL_FUNCTION(PFNGLCOLORP3UIPROC, void, ColorP3ui, (GLenum type, GLuint color), (type, color))
+GL_FUNCTION(PFNGLCOLORP3UIVPROC, void, ColorP3uiv, (GLenum type, const GLuint *color), (type, color))
+GL_FUNCTION(PFNGLCOLORP4UIPROC, void, ColorP4ui, (GLenum type, GLuint color), (type, color))
+GL_FUNCTION(PFNGLCOLORP4UIVPROC, void, ColorP4uiv, (GLenum type, const GLuint *color), (type, color))
+GL_FUNCTION(PFNGLSECONDARYCOLORP3UIPROC, void, SecondaryColorP3ui, (GLenum type, GLuint color), (type, color))
+GL_FUNCTION(PFNGLSECONDARYCOLORP3UIVPROC, void, SecondaryColorP3uiv, (GLenum type, const GLuint *color), (type, color))
+
+#undef GL_FUNCTION
@@ -0,0 +1,384 @@
+#include "GLTrace.h"
+#include "GLExtensions.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+bool GLTrace::installed = false;
+GLFrameStats GLTrace::lastFrame;
+
+namespace {
+    enum FunctionIndex {
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) Function##name,
+#include "GLFunctions.inl"
+        // GLExtensions entry points used every frame, the program binary ones only run at startup
+        FunctionDispatchCompute,
+        FunctionMemoryBarrier,
+        FunctionMultiDrawElementsIndirect,
+        FunctionViewportArrayv,
+        FunctionCount
+    };
+
+    const char* const functionNames[FunctionCount] = {
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) "gl" #name,
+#include "GLFunctions.inl"
+        "glDispatchCompute",
+        "glMemoryBarrier",
+        "glMultiDrawElementsIndirect",
+        "glViewportArrayv"
+    };
+
+    enum class Category : unsigned char { Other, Draw, Uniform, Bind };
+    Category categories[FunctionCount] = {};
+
+    // Driver entry points the wrappers forward to
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) pointer real##name = nullptr;
+#include "GLFunctions.inl"
+    PFNGLDISPATCHCOMPUTEPROC_EXT realDispatchCompute = nullptr;
+    PFNGLMEMORYBARRIERPROC_EXT realMemoryBarrier = nullptr;
+    PFNGLMULTIDRAWELEMENTSINDIRECTPROC_EXT realMultiDrawElementsIndirect = nullptr;
+    PFNGLVIEWPORTARRAYVPROC_EXT realViewportArrayv = nullptr;
+
+    // Counters of the frame in progress, GL is single threaded
+    size_t callCounts[FunctionCount] = {};
+    GLuint currentProgram = 0; // Outlives frames like the GL state it mirrors
+    std::unordered_map<GLuint, size_t> programDraws;
+    std::vector<std::pair<GLenum, size_t>> targetBytes;
+
+    // Frame recording: requested, then active for one whole frame
+    bool recordPending = false;
+    bool recording = false;
+    std::string recordPath;
+    std::string recordBuffer;
+    size_t recordedCalls = 0;
+
+    std::ofstream log;
+
+    void countCall(FunctionIndex function) {
+        ++callCounts[function];
+        if (categories[function] == Category::Draw)
+            ++programDraws[currentProgram];
+    }
+
+    void countUpload(GLenum target, GLsizeiptr size) {
+        for (std::pair<GLenum, size_t>& entry : targetBytes) {
+            if (entry.first == target) {
+                entry.second += size;
+                return;
+            }
+        }
+        targetBytes.emplace_back(target, size);
+    }
+
+    // Arguments are printed by C type: GL enums and names are plain integers
+    template <typename T> void appendArgument(std::string& line, T value) { line += std::to_string(value); }
+    template <typename T> void appendArgument(std::string& line, T* value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%p", reinterpret_cast<const void*>(value));
+        line += value ? text : "NULL";
+    }
+    void appendArgument(std::string& line, const char* value) {
+        if (!value) {
+            line += "NULL";
+            return;
+        }
+        line += '"';
+        line += value;
+        line += '"';
+    }
+    void appendArgument(std::string& line, double value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%g", value);
+        line += text;
+    }
+    void appendArgument(std::string& line, float value) { appendArgument(line, static_cast<double>(value)); }
+
+    void appendArguments(std::string&) {}
+    template <typename First, typename... Rest> void appendArguments(std::string& line, First first, Rest... rest) {
+        appendArgument(line, first);
+        if (sizeof...(rest) > 0)
+            line += ", ";
+        appendArguments(line, rest...);
+    }
+
+    // Called with the original argument list, so one wrapper body fits every signature
+    struct CallRecorder {
+        FunctionIndex function;
+        template <typename... Arguments> void operator()(Arguments... arguments) const {
+            recordBuffer += functionNames[function];
+            recordBuffer += '(';
+            appendArguments(recordBuffer, arguments...);
+            recordBuffer += ")\n";
+            ++recordedCalls;
+        }
+    };
+
+    // Count, record when asked, forward
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) \
+    result APIENTRY trace##name parameters { \
+        countCall(Function##name); \
+        if (recording) \
+            CallRecorder{ Function##name } arguments; \
+        return real##name arguments; \
+    }
+#include "GLFunctions.inl"
+
+    void APIENTRY traceDispatchCompute(GLuint groupsX, GLuint groupsY, GLuint groupsZ) {
+        countCall(FunctionDispatchCompute);
+        if (recording)
+            CallRecorder{ FunctionDispatchCompute }(groupsX, groupsY, groupsZ);
+        realDispatchCompute(groupsX, groupsY, groupsZ);
+    }
+
+    void APIENTRY traceMemoryBarrier(GLbitfield barriers) {
+        countCall(FunctionMemoryBarrier);
+        if (recording)
+            CallRecorder{ FunctionMemoryBarrier }(barriers);
+        realMemoryBarrier(barriers);
+    }
+
+    void APIENTRY traceMultiDrawElementsIndirect(GLenum mode, GLenum type, const void* indirect, GLsizei drawCount, GLsizei stride) {
+        countCall(FunctionMultiDrawElementsIndirect);
+        if (recording)
+            CallRecorder{ FunctionMultiDrawElementsIndirect }(mode, type, indirect, drawCount, stride);
+        realMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+    }
+
+    void APIENTRY traceViewportArrayv(GLuint first, GLsizei count, const GLfloat* v) {
+        countCall(FunctionViewportArrayv);
+        if (recording)
+            CallRecorder{ FunctionViewportArrayv }(first, count, v);
+        realViewportArrayv(first, count, v);
+    }
+
+    // Wrappers with bookkeeping of their own before the common one
+    void APIENTRY trackUseProgram(GLuint program) {
+        currentProgram = program;
+        traceUseProgram(program);
+    }
+
+    void APIENTRY trackBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        if (data)
+            countUpload(target, size);
+        traceBufferData(target, size, data, usage);
+    }
+
+    void APIENTRY trackBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        countUpload(target, size);
+        traceBufferSubData(target, offset, size, data);
+    }
+
+    // Counted as if the whole range gets written, there is no way to see what the CPU actually touches
+    void* APIENTRY trackMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+        if (access & GL_MAP_WRITE_BIT)
+            countUpload(target, length);
+        return traceMapBufferRange(target, offset, length, access);
+    }
+
+    Category categorize(const char* name) {
+        if (std::strncmp(name, "glDraw", 6) == 0 || std::strncmp(name, "glMultiDraw", 11) == 0)
+            return Category::Draw;
+        if (std::strncmp(name, "glUniform", 9) == 0 && std::strcmp(name, "glUniformBlockBinding") != 0)
+            return Category::Uniform;
+        if (std::strncmp(name, "glBind", 6) == 0)
+            return Category::Bind;
+        return Category::Other;
+    }
+
+    void writeRecording(size_t frame) {
+        std::ofstream file(recordPath, std::ios::binary);
+        if (!file) {
+            std::cerr << "GLTrace: Failed to open " << recordPath << " for writing\n";
+            return;
+        }
+        file << "# GL calls of frame " << frame << ", " << recordedCalls << " calls\n" << recordBuffer;
+        std::cout << "GLTrace: Recorded " << recordedCalls << " calls of frame " << frame << " to " << recordPath << "\n";
+    }
+}
+
+bool GLTrace::install() {
+    if (installed)
+        return true;
+    if (!glad_glGetString) {
+        std::cerr << "GLTrace: GL has to be loaded before installing\n";
+        return false;
+    }
+
+    // Entry points the driver did not provide stay null
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) \
+    real##name = glad_gl##name; \
+    if (real##name) \
+        glad_gl##name = &trace##name;
+#include "GLFunctions.inl"
+
+    if (realUseProgram)
+        glad_glUseProgram = &trackUseProgram;
+    if (realBufferData)
+        glad_glBufferData = &trackBufferData;
+    if (realBufferSubData)
+        glad_glBufferSubData = &trackBufferSubData;
+    if (realMapBufferRange)
+        glad_glMapBufferRange = &trackMapBufferRange;
+
+    realDispatchCompute = GLExtensions::DispatchCompute;
+    realMemoryBarrier = GLExtensions::MemoryBarrierProc;
+    realMultiDrawElementsIndirect = GLExtensions::MultiDrawElementsIndirect;
+    realViewportArrayv = GLExtensions::ViewportArrayv;
+    if (realDispatchCompute)
+        GLExtensions::DispatchCompute = &traceDispatchCompute;
+    if (realMemoryBarrier)
+        GLExtensions::MemoryBarrierProc = &traceMemoryBarrier;
+    if (realMultiDrawElementsIndirect)
+        GLExtensions::MultiDrawElementsIndirect = &traceMultiDrawElementsIndirect;
+    if (realViewportArrayv)
+        GLExtensions::ViewportArrayv = &traceViewportArrayv;
+
+    for (size_t i = 0; i < FunctionCount; ++i)
+        categories[i] = categorize(functionNames[i]);
+
+    installed = true;
+    std::cout << "GLTrace: Intercepting " << FunctionCount << " entry points\n";
+    return true;
+}
+
+void GLTrace::endFrame() {
+    if (!installed)
+        return;
+
+    GLFrameStats& stats = lastFrame;
+    size_t frame = stats.frame + 1;
+    stats = GLFrameStats();
+    stats.frame = frame;
+
+    for (size_t i = 0; i < FunctionCount; ++i) {
+        size_t count = callCounts[i];
+        if (count == 0)
+            continue;
+        stats.calls += count;
+        switch (categories[i]) {
+        case Category::Draw: stats.drawCalls += count; break;
+        case Category::Uniform: stats.uniformWrites += count; break;
+        case Category::Bind: stats.bindCalls += count; break;
+        default: break;
+        }
+        stats.entryPoints.emplace_back(functionNames[i], count);
+    }
+    stats.programBinds = callCounts[FunctionUseProgram];
+    std::stable_sort(stats.entryPoints.begin(), stats.entryPoints.end(), [](const std::pair<const char*, size_t>& a, const std::pair<const char*, size_t>& b) {
+        return a.second > b.second;
+    });
+
+    stats.bytesPerTarget.assign(targetBytes.begin(), targetBytes.end());
+    std::sort(stats.bytesPerTarget.begin(), stats.bytesPerTarget.end());
+    for (const std::pair<unsigned int, size_t>& entry : stats.bytesPerTarget)
+        stats.bytesUploaded += entry.second;
+
+    stats.drawsPerProgram.assign(programDraws.begin(), programDraws.end());
+    std::sort(stats.drawsPerProgram.begin(), stats.drawsPerProgram.end(), [](const std::pair<unsigned int, size_t>& a, const std::pair<unsigned int, size_t>& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+
+    std::fill(std::begin(callCounts), std::end(callCounts), 0);
+    targetBytes.clear();
+    programDraws.clear();
+
+    if (log.is_open()) {
+        log << stats.frame << ',' << stats.calls << ',' << stats.drawCalls << ',' << stats.programBinds << ','
+            << stats.uniformWrites << ',' << stats.bindCalls << ',' << stats.bytesUploaded << '\n';
+    }
+
+    // A recording covers exactly the frame between two endFrame calls
+    if (recording) {
+        writeRecording(stats.frame);
+        recording = false;
+        recordBuffer.clear();
+        recordBuffer.shrink_to_fit();
+    }
+    if (recordPending) {
+        recordPending = false;
+        recording = true;
+        recordedCalls = 0;
+    }
+}
+
+bool GLTrace::exportStats(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "GLTrace: Failed to open " << path << " for writing\n";
+        return false;
+    }
+
+    const GLFrameStats& stats = lastFrame;
+    file << "frame " << stats.frame << "\n"
+        << "calls " << stats.calls << "\n"
+        << "draw calls " << stats.drawCalls << "\n"
+        << "program binds " << stats.programBinds << "\n"
+        << "uniform writes " << stats.uniformWrites << "\n"
+        << "bind calls " << stats.bindCalls << "\n"
+        << "bytes uploaded " << stats.bytesUploaded << "\n";
+
+    file << "\n[entry points]\n";
+    for (const std::pair<const char*, size_t>& entry : stats.entryPoints)
+        file << entry.first << ' ' << entry.second << "\n";
+
+    file << "\n[bytes per buffer target]\n";
+    for (const std::pair<unsigned int, size_t>& entry : stats.bytesPerTarget)
+        file << getTargetName(entry.first) << ' ' << entry.second << "\n";
+
+    file << "\n[draws per program]\n";
+    for (const std::pair<unsigned int, size_t>& entry : stats.drawsPerProgram)
+        file << entry.first << ' ' << entry.second << "\n";
+
+    std::cout << "GLTrace: Wrote frame " << stats.frame << " stats to " << path << "\n";
+    return true;
+}
+
+bool GLTrace::startLog(const std::string& path) {
+    log.close();
+    log.open(path);
+    if (!log) {
+        std::cerr << "GLTrace: Failed to open " << path << " for writing\n";
+        return false;
+    }
+    log << "frame,calls,draw calls,program binds,uniform writes,bind calls,bytes uploaded\n";
+    return true;
+}
+
+void GLTrace::stopLog() {
+    log.close();
+}
+
+bool GLTrace::isLogging() {
+    return log.is_open();
+}
+
+void GLTrace::recordFrame(const std::string& path) {
+    if (recording || recordPending)
+        return;
+    recordPath = path;
+    recordPending = true;
+}
+
+bool GLTrace::isRecordingFrame() {
+    return recording || recordPending;
+}
+
+const char* GLTrace::getTargetName(unsigned int target) {
+    switch (target) {
+    case GL_ARRAY_BUFFER: return "GL_ARRAY_BUFFER";
+    case GL_ELEMENT_ARRAY_BUFFER: return "GL_ELEMENT_ARRAY_BUFFER";
+    case GL_UNIFORM_BUFFER: return "GL_UNIFORM_BUFFER";
+    case GL_PIXEL_PACK_BUFFER: return "GL_PIXEL_PACK_BUFFER";
+    case GL_PIXEL_UNPACK_BUFFER: return "GL_PIXEL_UNPACK_BUFFER";
+    case GL_COPY_READ_BUFFER: return "GL_COPY_READ_BUFFER";
+    case GL_COPY_WRITE_BUFFER: return "GL_COPY_WRITE_BUFFER";
+    case GL_TEXTURE_BUFFER: return "GL_TEXTURE_BUFFER";
+    case GL_TRANSFORM_FEEDBACK_BUFFER: return "GL_TRANSFORM_FEEDBACK_BUFFER";
+    case GL_SHADER_STORAGE_BUFFER: return "GL_SHADER_STORAGE_BUFFER";
+    case GL_DRAW_INDIRECT_BUFFER: return "GL_DRAW_INDIRECT_BUFFER";
+    default: return "unknown target";
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef GL_TRACE_H
+#define GL_TRACE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// GL work of one frame as seen by GLTrace
+struct GLFrameStats {
+    size_t frame{ 0 };
+    size_t calls{ 0 };
+    size_t drawCalls{ 0 };     // glDraw*, glMultiDraw* and indirect multi-draws
+    size_t programBinds{ 0 };  // glUseProgram
+    size_t uniformWrites{ 0 }; // glUniform*
+    size_t bindCalls{ 0 };     // glBind*: buffers, vertex arrays, textures, framebuffers...
+    size_t bytesUploaded{ 0 }; // Buffer data written from the CPU, summed over targets
+
+    std::vector<std::pair<const char*, size_t>> entryPoints;       // Most called first
+    std::vector<std::pair<unsigned int, size_t>> bytesPerTarget;   // Buffer target, bytes
+    std::vector<std::pair<unsigned int, size_t>> drawsPerProgram;  // Program name, draws; most drawn first
+};
+
+// Opt-in interception of the game's GL calls, for finding out what a frame really sends to the driver.
+// install() swaps every glad function pointer, and the per-frame GLExtensions ones, for a wrapper that
+// counts the call and forwards it. Buffer uploads are summed per target (glBufferData with data,
+// glBufferSubData and write mappings) and draws are attributed to the bound program.
+// ImGui has its own GL loader, so the UI's calls are not part of the numbers.
+// Kept GL-free so UI code can include this.
+class GLTrace {
+public:
+    // Call after gladLoadGLLoader and GLExtensions::load, with the context current. Stays on until exit.
+    static bool install();
+    static bool isInstalled() { return installed; }
+
+    // Call once per frame before swapping: closes the frame's counters and advances recording and logging
+    static void endFrame();
+    static const GLFrameStats& getLastFrame() { return lastFrame; }
+
+    // Last frame's counters, every entry point, target and program, as text
+    static bool exportStats(const std::string& path);
+
+    // Appends one CSV row of totals per frame until stopped
+    static bool startLog(const std::string& path);
+    static void stopLog();
+    static bool isLogging();
+
+    // Writes every call of the next whole frame with its arguments, one per line, when that frame ends
+    static void recordFrame(const std::string& path);
+    static bool isRecordingFrame();
+
+    // "GL_ARRAY_BUFFER" style name of a buffer target
+    static const char* getTargetName(unsigned int target);
+
+private:
+    static bool installed;
+    static GLFrameStats lastFrame;
+};
+
+#endif
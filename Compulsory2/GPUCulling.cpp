@@ -0,0 +1,199 @@
+#include "GPUCulling.h"
+#include "ShaderHelper.h"
+#include <algorithm>
+#include <glm/gtc/type_ptr.hpp>
+
+static_assert(sizeof(InstanceData) == 17 * sizeof(GLuint), "Culling.comp writes InstanceData as 17 words");
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "Indirect commands are 5 tightly packed words");
+
+namespace {
+    const GLuint WorkGroupSize = 64; // local_size_x in Culling.comp
+}
+
+void GPUCulling::initialize() {
+    if (!isSupported())
+        return;
+
+    program = ShaderHelper::createCachedProgram({ { GL_COMPUTE_SHADER, ShaderHelper::readFile("Culling.comp") } });
+    if (!program) {
+        std::cerr << "GPU culling shader failed, using the CPU path\n";
+        return;
+    }
+    frustumPlanesLoc = glGetUniformLocation(program, "frustumPlanes");
+    objectCountLoc = glGetUniformLocation(program, "objectCount");
+    eyePositionLoc = glGetUniformLocation(program, "eyePosition");
+    projectionScaleLoc = glGetUniformLocation(program, "projectionScale");
+
+    GLuint buffers[3];
+    glGenBuffers(3, buffers);
+    objectBuffer = buffers[0];
+    commandBuffer = buffers[1];
+    instanceBuffer = buffers[2];
+}
+
+void GPUCulling::cleanup() {
+    if (program)
+        glDeleteProgram(program);
+    GLuint buffers[3] = { objectBuffer, commandBuffer, instanceBuffer };
+    glDeleteBuffers(3, buffers);
+    program = objectBuffer = commandBuffer = instanceBuffer = 0;
+    objectCapacity = commandCapacity = instanceCapacity = 0;
+    layoutDirty = true;
+}
+
+unsigned int GPUCulling::addMesh(const MeshAllocation& mesh, float boundingRadius) {
+    meshes.push_back({ mesh, boundingRadius, 0, 0, 1, 0.0f });
+    layoutDirty = true;
+    return static_cast<unsigned int>(meshes.size() - 1);
+}
+
+unsigned int GPUCulling::addMesh(const GPUMeshLOD& mesh) {
+    unsigned int first = static_cast<unsigned int>(meshes.size());
+    unsigned int levelCount = static_cast<unsigned int>(mesh.getLevelCount());
+    for (unsigned int level = 0; level < levelCount; ++level)
+        meshes.push_back({ mesh.getLevel(level).getAllocation(), mesh.getBoundingRadius(), 0, 0, level == 0 ? levelCount : 0, mesh.fullDetailSize });
+    layoutDirty = true;
+    return first;
+}
+
+float GPUCulling::worldRadius(unsigned int mesh, const glm::mat4& model) const {
+    float scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+    return meshes[mesh].radius * scale;
+}
+
+unsigned int GPUCulling::addObject(unsigned int mesh, const glm::mat4& model, const glm::vec4& color) {
+    objects.push_back({ model, worldRadius(mesh, model), 0, packColor(color), meshes[mesh].levelCount, meshes[mesh].fullDetailSize, {} });
+    objectMeshes.push_back(mesh);
+    ++meshes[mesh].objectCount;
+    layoutDirty = true;
+    return static_cast<unsigned int>(objects.size() - 1);
+}
+
+void GPUCulling::setTransform(unsigned int object, const glm::mat4& model) {
+    objects[object].model = model;
+    objects[object].radius = worldRadius(objectMeshes[object], model);
+    if (dirtyBegin == dirtyEnd) {
+        dirtyBegin = object;
+        dirtyEnd = object + 1;
+    }
+    else {
+        dirtyBegin = std::min<size_t>(dirtyBegin, object);
+        dirtyEnd = std::max<size_t>(dirtyEnd, object + 1);
+    }
+}
+
+void GPUCulling::clear() {
+    objects.clear();
+    objectMeshes.clear();
+    for (Mesh& mesh : meshes)
+        mesh.objectCount = 0;
+    layoutDirty = true;
+}
+
+void GPUCulling::rebuildLayout() {
+    // Commands grouped by vertex format so each format is one contiguous multi-draw, chains stay in level order
+    std::vector<unsigned int> order;
+    for (unsigned int m = 0; m < meshes.size(); ++m) {
+        if (meshes[m].levelCount != 0)
+            order.push_back(m);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+        return meshes[a].allocation.format < meshes[b].allocation.format;
+    });
+
+    commandTemplates.clear();
+    formatRanges.clear();
+    GLuint baseInstance = 0;
+    for (unsigned int meshIndex : order) {
+        size_t objectCount = meshes[meshIndex].objectCount;
+        if (objectCount == 0)
+            continue;
+
+        // Any object of the chain may land in any level, so each level reserves room for all of them
+        for (unsigned int level = 0; level < meshes[meshIndex].levelCount; ++level) {
+            Mesh& mesh = meshes[meshIndex + level];
+            mesh.command = static_cast<GLuint>(commandTemplates.size());
+            commandTemplates.push_back({ static_cast<GLuint>(mesh.allocation.indexCount), 0, mesh.allocation.firstIndex,
+                mesh.allocation.baseVertex, baseInstance });
+            baseInstance += static_cast<GLuint>(objectCount);
+
+            if (formatRanges.empty() || formatRanges.back().format != mesh.allocation.format)
+                formatRanges.push_back({ mesh.allocation.format, mesh.command, 0 });
+            ++formatRanges.back().commandCount;
+        }
+    }
+
+    for (size_t i = 0; i < objects.size(); ++i)
+        objects[i].command = meshes[objectMeshes[i]].command;
+
+    if (program) {
+        // Every object has a slot even if all of them pass
+        reserve(GL_SHADER_STORAGE_BUFFER, objectBuffer, objectCapacity, objects.size() * sizeof(CullObject));
+        reserve(GL_SHADER_STORAGE_BUFFER, commandBuffer, commandCapacity, commandTemplates.size() * sizeof(DrawElementsIndirectCommand));
+        reserve(GL_SHADER_STORAGE_BUFFER, instanceBuffer, instanceCapacity, baseInstance * sizeof(InstanceData));
+        if (!objects.empty()) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, objectBuffer);
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, objects.size() * sizeof(CullObject), objects.data());
+        }
+    }
+
+    layoutDirty = false;
+    dirtyBegin = dirtyEnd = 0;
+}
+
+void GPUCulling::reserve(GLenum target, GLuint buffer, size_t& capacity, size_t size) {
+    if (size <= capacity)
+        return;
+    capacity = std::max(size, capacity * 2);
+    glBindBuffer(target, buffer);
+    glBufferData(target, capacity, nullptr, GL_DYNAMIC_DRAW);
+}
+
+void GPUCulling::cull(const glm::mat4& viewProjection, const glm::vec3& eye, float projectionScale) {
+    if (!program)
+        return;
+
+    if (layoutDirty)
+        rebuildLayout();
+    else if (dirtyBegin != dirtyEnd) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, objectBuffer);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, dirtyBegin * sizeof(CullObject), (dirtyEnd - dirtyBegin) * sizeof(CullObject), &objects[dirtyBegin]);
+        dirtyBegin = dirtyEnd = 0;
+    }
+    if (objects.empty())
+        return;
+
+    // Instance counts start at zero every frame, the shader counts them up
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, commandTemplates.size() * sizeof(DrawElementsIndirectCommand), commandTemplates.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    Frustum frustum(viewProjection);
+
+    glUseProgram(program);
+    glUniform4fv(frustumPlanesLoc, 6, glm::value_ptr(frustum.planes[0]));
+    glUniform1ui(objectCountLoc, static_cast<GLuint>(objects.size()));
+    glUniform3fv(eyePositionLoc, 1, glm::value_ptr(eye));
+    glUniform1f(projectionScaleLoc, projectionScale);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, objectBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, commandBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, instanceBuffer);
+    GLExtensions::DispatchCompute(static_cast<GLuint>((objects.size() + WorkGroupSize - 1) / WorkGroupSize), 1, 1);
+
+    // Commands are read by the indirect draw, instances by vertex fetch
+    GLExtensions::MemoryBarrierProc(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+size_t GPUCulling::readVisibleCount() {
+    if (!program || commandTemplates.empty())
+        return 0;
+    std::vector<DrawElementsIndirectCommand> commands(commandTemplates.size());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    size_t visible = 0;
+    for (const DrawElementsIndirectCommand& command : commands)
+        visible += command.instanceCount;
+    return visible;
+}
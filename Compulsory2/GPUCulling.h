@@ -0,0 +1,147 @@
+#ifndef GPU_CULLING_H
+#define GPU_CULLING_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "Frustum.h"
+#include "GLExtensions.h"
+#include "MeshArena.h"
+#include "MeshLOD.h"
+#include "MultiView.h"
+#include "Vertex.h"
+
+// Layout fixed by glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+// GPU-driven submission for large object counts. Objects and their transforms persist in an SSBO,
+// Culling.comp tests every bounding sphere against the frustum, appends the survivors' InstanceData
+// to the range of their mesh's LOD level and bumps that level's indirect command, so the CPU never builds
+// instance lists.
+// Renderer::drawCulled issues one glMultiDrawElementsIndirect per vertex format and falls back to
+// CPU culling plus the instanced 3.3 path when isActive() is false.
+class GPUCulling {
+public:
+    // Draw commands of one vertex format, consecutive in the command buffer
+    struct FormatRange {
+        VertexFormat format;
+        size_t firstCommand;
+        size_t commandCount;
+    };
+
+    static bool isSupported() { return GLExtensions::gpuCulling; }
+
+    // False also when the shader failed or the GPU path was switched off
+    bool isActive() const { return enabled && program != 0; }
+    void setEnabled(bool value) { enabled = value; }
+
+    // Compiles the culling shader, harmless without GL 4.3
+    void initialize();
+    void cleanup();
+
+    // boundingRadius encloses the mesh around its origin, see MeshLOD::boundingRadius
+    unsigned int addMesh(const MeshAllocation& mesh, float boundingRadius);
+    // Every level gets a draw command, objects of the chain are drawn at the level their projected size selects
+    unsigned int addMesh(const GPUMeshLOD& mesh);
+    unsigned int addObject(unsigned int mesh, const glm::mat4& model, const glm::vec4& color);
+    void setTransform(unsigned int object, const glm::mat4& model);
+    void clear();
+
+    size_t getObjectCount() const { return objects.size(); }
+
+    // Uploads changes and runs the culling shader; commands and instances stay on the GPU.
+    // LOD levels are selected from the distance to eye, projectionScale as in Renderer::projectedSize.
+    void cull(const glm::mat4& viewProjection, const glm::vec3& eye, float projectionScale);
+
+    // Reads the instance counts back, stalls the pipeline, for tests and benchmarks only
+    size_t readVisibleCount();
+
+    // Same sphere test on the CPU, calls fn(mesh, model, color) for every visible object with the LOD level
+    // that screenSize(center, radius) selects
+    template <typename SizeFn, typename Fn>
+    void forEachVisible(const glm::mat4& viewProjection, SizeFn screenSize, Fn fn) const {
+        Frustum frustum(viewProjection);
+        for (size_t i = 0; i < objects.size(); ++i) {
+            glm::vec3 center(objects[i].model[3]);
+            if (frustum.intersectsSphere(center, objects[i].radius))
+                fn(selectLevel(i, screenSize(center, objects[i].radius)), objects[i].model, objects[i].color);
+        }
+    }
+
+    // Full detail only
+    template <typename Fn>
+    void forEachVisible(const glm::mat4& viewProjection, Fn fn) const {
+        forEachVisible(viewProjection, [](const glm::vec3&, float) { return 1.0f; }, fn);
+    }
+
+    // Every view in one pass over the objects, calls fn(mesh, model, color, visibleViews) for objects any view sees
+    template <typename SizeFn, typename Fn>
+    void forEachVisible(const ViewFrustums& frustums, SizeFn screenSize, Fn fn) const {
+        for (size_t i = 0; i < objects.size(); ++i) {
+            glm::vec3 center(objects[i].model[3]);
+            unsigned int visibleViews = frustums.sphereMask(center, objects[i].radius);
+            if (visibleViews != 0)
+                fn(selectLevel(i, screenSize(center, objects[i].radius)), objects[i].model, objects[i].color, visibleViews);
+        }
+    }
+
+    const std::vector<FormatRange>& getFormatRanges() const { return formatRanges; }
+    GLuint getCommandBuffer() const { return commandBuffer; }
+    GLuint getInstanceBuffer() const { return instanceBuffer; }
+
+private:
+    // std430 layout of Culling.comp's CullObject
+    struct CullObject {
+        glm::mat4 model;
+        float radius;
+        GLuint command; // Of LOD level 0, the other levels follow
+        ColorRGBA8 color;
+        GLuint levelCount;
+        float fullDetailSize;
+        GLuint padding[3];
+    };
+    static_assert(sizeof(CullObject) == 96, "CullObject must match the std430 struct in Culling.comp");
+
+    // A LOD chain is levelCount consecutive entries, objects only refer to the first
+    struct Mesh {
+        MeshAllocation allocation;
+        float radius;
+        size_t objectCount;
+        GLuint command;
+        unsigned int levelCount;
+        float fullDetailSize;
+    };
+
+    std::vector<Mesh> meshes;
+    std::vector<CullObject> objects;
+    std::vector<unsigned int> objectMeshes;
+    std::vector<DrawElementsIndirectCommand> commandTemplates; // Zero instances, baseInstance reserves each mesh's range
+    std::vector<FormatRange> formatRanges;
+
+    // Meshes or objects were added, commands and buffer sizes must be rebuilt
+    bool layoutDirty{ true };
+    // Objects whose transforms changed since the last upload
+    size_t dirtyBegin{ 0 }, dirtyEnd{ 0 };
+
+    bool enabled{ true };
+    GLuint program{ 0 };
+    GLint frustumPlanesLoc{ -1 }, objectCountLoc{ -1 }, eyePositionLoc{ -1 }, projectionScaleLoc{ -1 };
+    GLuint objectBuffer{ 0 }, commandBuffer{ 0 }, instanceBuffer{ 0 };
+    size_t objectCapacity{ 0 }, commandCapacity{ 0 }, instanceCapacity{ 0 }; // Bytes
+
+    void rebuildLayout();
+    float worldRadius(unsigned int mesh, const glm::mat4& model) const;
+    const MeshAllocation& selectLevel(size_t object, float screenSize) const {
+        const Mesh& mesh = meshes[objectMeshes[object]];
+        return meshes[objectMeshes[object] + MeshLOD::selectLevel(screenSize, mesh.fullDetailSize, mesh.levelCount)].allocation;
+    }
+    static void reserve(GLenum target, GLuint buffer, size_t& capacity, size_t size);
+};
+
+#endif
@@ -0,0 +1,16 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 barCoord;
+flat in float fill;
+
+void main() {
+    // Dark frame around the bar, filled part goes from green to red as health drops
+    vec2 edge = min(barCoord, 1.0 - barCoord);
+    if (edge.x < 0.02 || edge.y < 0.15) {
+        FragColor = vec4(0.05, 0.05, 0.05, 1.0);
+        return;
+    }
+    vec3 full = mix(vec3(0.9, 0.1, 0.1), vec3(0.2, 0.85, 0.2), fill);
+    FragColor = vec4(barCoord.x <= fill ? full : vec3(0.2), 1.0);
+}
@@ -0,0 +1,26 @@
+#version 330 core
+// Every attribute is per instance, the quad corner comes from gl_VertexID
+layout (location = 0) in vec2 aOffset; // (x, z) from the camera in quantization steps
+layout (location = 1) in float aFill;  // Health fraction
+
+out vec2 barCoord; // x from 0 to 1 along the bar
+flat out float fill;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 origin;      // Camera (x, z) at bar height
+uniform vec3 cameraRight;
+uniform vec3 cameraUp;
+uniform vec3 size;        // Half width, half height, world units per quantization step
+
+const vec2 corners[4] = vec2[4](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(-1.0, 1.0), vec2(1.0, 1.0));
+
+void main() {
+    vec2 corner = corners[gl_VertexID];
+    barCoord = corner * 0.5 + 0.5;
+    fill = aFill;
+
+    vec3 center = origin + vec3(aOffset.x, 0.0, aOffset.y) * size.z;
+    vec3 offset = cameraRight * corner.x * size.x + cameraUp * corner.y * size.y;
+    gl_Position = projection * view * vec4(center + offset, 1.0);
+}
@@ -0,0 +1,112 @@
+#include "HealthBars.h"
+#include "Frustum.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace {
+    enum HealthBarAttribute : GLuint {
+        BarPosition = 0,
+        BarFill = 1
+    };
+}
+
+void HealthBarRenderer::initialize() {
+    program = ShaderProgram(ShaderHelper::createCachedProgram({
+        { GL_VERTEX_SHADER, ShaderHelper::readFile("HealthBar.vs") },
+        { GL_FRAGMENT_SHADER, ShaderHelper::readFile("HealthBar.fs") } }));
+    if (!program.isValid()) {
+        std::cerr << "ERROR::SHADER::PROGRAM::CREATION_FAILED (health bars)\n";
+        return;
+    }
+    viewLoc = program.getUniformLocation("view");
+    projectionLoc = program.getUniformLocation("projection");
+    originLoc = program.getUniformLocation("origin");
+    cameraRightLoc = program.getUniformLocation("cameraRight");
+    cameraUpLoc = program.getUniformLocation("cameraUp");
+    sizeLoc = program.getUniformLocation("size");
+
+    // The quad corner comes from gl_VertexID, both attributes are per instance
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glEnableVertexAttribArray(BarPosition);
+    glVertexAttribPointer(BarPosition, 2, GL_SHORT, GL_FALSE, sizeof(HealthBarInstance),
+        reinterpret_cast<const void*>(offsetof(HealthBarInstance, x)));
+    glVertexAttribDivisor(BarPosition, 1);
+    glEnableVertexAttribArray(BarFill);
+    glVertexAttribPointer(BarFill, 1, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(HealthBarInstance),
+        reinterpret_cast<const void*>(offsetof(HealthBarInstance, fill)));
+    glVertexAttribDivisor(BarFill, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void HealthBarRenderer::cleanup() {
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    vao = vbo = 0;
+    capacity = 0;
+    program.destroy();
+}
+
+bool HealthBarRenderer::gather(ComponentManager& componentManager, const glm::mat4& viewProjection, const glm::vec2& origin) {
+    instances.clear();
+    Frustum frustum(viewProjection);
+    const float radius = 0.5f * size.x;
+    const float limit = std::numeric_limits<int16_t>::max() / PositionScale;
+
+    componentManager.view<Position, Health>([&](unsigned int, size_t, const Position& position, const Health& health) {
+        if (health.currentHealth >= health.maxHealth || health.currentHealth <= 0 || health.maxHealth <= 0)
+            return;
+        if (!frustum.intersectsSphere(glm::vec3(position.x, height, position.z), radius))
+            return;
+
+        // Anything this far from the camera is beyond the far plane in practice
+        glm::vec2 offset = glm::vec2(position.x, position.z) - origin;
+        if (std::fabs(offset.x) >= limit || std::fabs(offset.y) >= limit)
+            return;
+
+        HealthBarInstance instance{};
+        instance.x = static_cast<int16_t>(std::lround(offset.x * PositionScale));
+        instance.z = static_cast<int16_t>(std::lround(offset.y * PositionScale));
+        instance.fill = static_cast<uint8_t>(255.0f * health.currentHealth / health.maxHealth + 0.5f);
+        instances.push_back(instance);
+    });
+    return !instances.empty();
+}
+
+void HealthBarRenderer::draw(ComponentManager& componentManager, const glm::mat4& view, const glm::mat4& projection) {
+    if (!program.isValid())
+        return;
+
+    // Camera position from the view matrix, bars are stored relative to it
+    glm::vec3 cameraPosition = -glm::transpose(glm::mat3(view)) * glm::vec3(view[3]);
+    glm::vec2 origin(cameraPosition.x, cameraPosition.z);
+    if (!gather(componentManager, projection * view, origin))
+        return;
+
+    // Orphan and refill like the other instance streams
+    size_t bytes = instances.size() * sizeof(HealthBarInstance);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (bytes > capacity)
+        capacity = std::max(bytes, capacity * 2);
+    glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUseProgram(program.getId());
+    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, &view[0][0]);
+    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, &projection[0][0]);
+    glUniform3f(originLoc, origin.x, height, origin.y);
+    // Rows of the view rotation are the camera axes in world space
+    glUniform3f(cameraRightLoc, view[0][0], view[1][0], view[2][0]);
+    glUniform3f(cameraUpLoc, view[0][1], view[1][1], view[2][1]);
+    glUniform3f(sizeLoc, size.x * 0.5f, size.y * 0.5f, 1.0f / PositionScale);
+
+    glBindVertexArray(vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instances.size()));
+    glBindVertexArray(0);
+}
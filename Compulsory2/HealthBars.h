@@ -0,0 +1,50 @@
+#ifndef HEALTH_BARS_H
+#define HEALTH_BARS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "ComponentManager.h"
+#include "ShaderHelper.h"
+
+// One bar as uploaded: position relative to the camera in 1/32 units and the health fraction
+struct HealthBarInstance {
+    int16_t x, z;
+    uint8_t fill;       // currentHealth / maxHealth in 0..255
+    uint8_t padding[3]; // Keeps instances 4-byte aligned
+};
+
+// World-space health bars over every damaged entity, drawn as one instanced camera-facing quad draw
+// straight from the Health pool. Entities at full health or outside the view frustum get no bar.
+class HealthBarRenderer {
+public:
+    // Creates the program and buffer, needs a current GL context
+    void initialize();
+    void cleanup();
+
+    // Gathers and draws, depth tested so bars hide behind scenery
+    void draw(ComponentManager& componentManager, const glm::mat4& view, const glm::mat4& projection);
+
+    // Bars drawn by the last draw
+    size_t getBarCount() const { return instances.size(); }
+
+    float height{ 1.5f }; // Above the entity's ground position
+    glm::vec2 size{ 1.0f, 0.12f };
+
+private:
+    static constexpr float PositionScale = 32.0f; // Quantization steps per world unit
+
+    // Fills instances, returns false when there is nothing to draw
+    bool gather(ComponentManager& componentManager, const glm::mat4& viewProjection, const glm::vec2& origin);
+
+    std::vector<HealthBarInstance> instances;
+
+    ShaderProgram program;
+    GLint viewLoc{ -1 }, projectionLoc{ -1 }, originLoc{ -1 }, cameraRightLoc{ -1 }, cameraUpLoc{ -1 };
+    GLint sizeLoc{ -1 };
+    GLuint vao{ 0 }, vbo{ 0 };
+    size_t capacity{ 0 }; // Bytes
+};
+
+#endif
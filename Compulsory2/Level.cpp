@@ -1,10 +1,45 @@
 #include "Level.h"
+#include <glm/gtc/matrix_transform.hpp>
 
-Level::Level(EntityManager& entityManager, ComponentManager& componentManager)
+namespace {
+    // Enemies and pickups come in waves far from the camera, so they get LOD chains. Level 0 rounds the box
+    // edges and the simplifier collapses the bevels back down towards the plain box.
+    std::vector<Mesh3D> createEnemyLODs() {
+        return MeshLOD::buildChain(PrimitiveGenerator::createRoundedBox(1.0f, 2.0f, 1.0f, 0.12f, 2, glm::vec3(1.f, 0.f, 0.f)), 4);
+    }
+
+    std::vector<Mesh3D> createPickupLODs() {
+        return MeshLOD::buildChain(PrimitiveGenerator::createRoundedBox(0.5f, 0.5f, 0.5f, 0.06f, 2, glm::vec3(0.f, 1.f, 0.f)), 4);
+    }
+
+    // Static batch materials, geometry only merges within one
+    enum SceneryMaterial : unsigned int {
+        GroundMaterial,
+        PropMaterial
+    };
+
+    const float GroundHeight = -1.0f; // Entities stand on it, boxes are centered on their Position
+    const float GroundExtent = 24.0f; // Half size of the playing field
+    const float GroundTile = 8.0f;
+}
+
+Level::Level(EntityManager& entityManager, ComponentManager& componentManager, const MeshPack* meshPack)
     : entityManager(entityManager), componentManager(componentManager) {
-    // Initialize meshes
-    enemyMesh = PrimitiveGenerator::createBox(1.0f, 2.0f, 1.0f, glm::vec3(1.f, 0.f, 0.f));
-    pickupMesh = PrimitiveGenerator::createBox(0.5f, 0.5f, 0.5f, glm::vec3(0.f, 1.f, 0.f));
+    if (meshPack) {
+        enemyMesh = meshPack->loadLOD("enemy");
+        pickupMesh = meshPack->loadLOD("pickup");
+    }
+
+    // Fall back to generating anything the pack did not provide
+    if (!enemyMesh)
+        enemyMesh = std::make_shared<GPUMeshLOD>(createEnemyLODs());
+    if (!pickupMesh)
+        pickupMesh = std::make_shared<GPUMeshLOD>(createPickupLODs());
+}
+
+void Level::cookMeshes(MeshPackWriter& writer) {
+    writer.addMesh("enemy", createEnemyLODs());
+    writer.addMesh("pickup", createPickupLODs());
 }
 
 void Level::generateLevel(int numEnemies, int numPickups, unsigned int seed) {
@@ -17,6 +52,10 @@ void Level::generateLevel(int numEnemies, int numPickups, unsigned int seed) {
     }
     std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
 
+    // Props draw from their own generator, so the enemies and pickups a seed gives do not depend on them
+    std::mt19937 sceneryRng(seed == 0 ? static_cast<unsigned int>(std::random_device{}()) : seed + 1);
+    buildScenery(sceneryRng);
+
     // Generate enemies
     for (int i = 0; i < numEnemies; ++i) {
         float x = dist(rng);
@@ -28,10 +67,7 @@ void Level::generateLevel(int numEnemies, int numPickups, unsigned int seed) {
         componentManager.addComponent(enemyEntity, Health(50));
         componentManager.addComponent(enemyEntity, Damage(15));
         componentManager.addComponent(enemyEntity, AI(true));
-
-        std::shared_ptr<WorldObject> enemyObject = std::make_shared<WorldObject>(enemyMesh);
-        enemyEntities.push_back(enemyEntity);
-        enemyObjects.push_back(enemyObject);
+        componentManager.addComponent(enemyEntity, Renderable(enemyMesh));
     }
 
     // Generate pickups
@@ -42,25 +78,83 @@ void Level::generateLevel(int numEnemies, int numPickups, unsigned int seed) {
         unsigned int pickupEntity = entityManager.createEntity();
         componentManager.addComponent(pickupEntity, Position(x, z));
         componentManager.addComponent(pickupEntity, Pickup("Potion"));
-
-        std::shared_ptr<WorldObject> pickupObject = std::make_shared<WorldObject>(pickupMesh);
-        pickupEntities.push_back(pickupEntity);
-        pickupObjects.push_back(pickupObject);
+        componentManager.addComponent(pickupEntity, Renderable(pickupMesh));
+        componentManager.addComponent(pickupEntity, LightEmitter(glm::vec3(0.2f, 1.0f, 0.3f), 4.0f, 1.5f));
     }
 }
 
-std::vector<unsigned int>& Level::getEnemyEntities() {
-    return enemyEntities;
-}
+void Level::buildScenery(std::mt19937& rng) {
+    scenery.beginRebuild();
 
-std::vector<std::shared_ptr<WorldObject>>& Level::getEnemyObjects() {
-    return enemyObjects;
-}
+    // Checkered ground tiles
+    Mesh3D lightTile = PrimitiveGenerator::createPlane(GroundTile, GroundTile, glm::vec3(0.45f, 0.5f, 0.4f));
+    Mesh3D darkTile = PrimitiveGenerator::createPlane(GroundTile, GroundTile, glm::vec3(0.38f, 0.43f, 0.34f));
+    int tiles = static_cast<int>(2.0f * GroundExtent / GroundTile);
+    for (int x = 0; x < tiles; ++x) {
+        for (int z = 0; z < tiles; ++z) {
+            glm::vec3 center(-GroundExtent + (x + 0.5f) * GroundTile, GroundHeight, -GroundExtent + (z + 0.5f) * GroundTile);
+            scenery.add((x + z) % 2 ? darkTile : lightTile, glm::translate(glm::mat4(1.0f), center), GroundMaterial);
+        }
+    }
+
+    // Walls and pillars, kept away from the player's spawn at the origin. Entities collide with them.
+    obstacles.clear();
+    Mesh3D wall = PrimitiveGenerator::createBox(4.0f, 2.0f, 0.5f, glm::vec3(0.55f, 0.5f, 0.45f));
+    std::vector<Mesh3D> pillar = PrimitiveGenerator::createCylinderLODs(0.5f, 3.0f, 32, glm::vec3(0.6f, 0.58f, 0.55f), 3);
+    std::uniform_real_distribution<float> dist(-GroundExtent + 2.0f, GroundExtent - 2.0f);
+    std::uniform_int_distribution<int> kind(0, 3);
+    for (int i = 0; i < 16; ++i) {
+        glm::vec3 position(dist(rng), 0.0f, dist(rng));
+        if (glm::length(position) < 4.0f)
+            continue;
 
-std::vector<unsigned int>& Level::getPickupEntities() {
-    return pickupEntities;
+        int type = kind(rng);
+        if (type == 0) {
+            // Stood up along Y with the base on the ground
+            position.y = GroundHeight + 1.5f;
+            glm::mat4 transform = glm::rotate(glm::translate(glm::mat4(1.0f), position), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+            scenery.add(pillar, transform, PropMaterial);
+            obstacles.push_back({ glm::vec2(position.x, position.z), glm::vec2(0.5f), true });
+        }
+        else {
+            position.y = GroundHeight + 1.0f;
+            glm::mat4 transform = glm::rotate(glm::translate(glm::mat4(1.0f), position), glm::radians(type == 1 ? 90.0f : 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            scenery.add(wall, transform, PropMaterial);
+            obstacles.push_back({ glm::vec2(position.x, position.z), type == 1 ? glm::vec2(0.25f, 2.0f) : glm::vec2(2.0f, 0.25f), false });
+        }
+    }
+
+    scenery.commit();
 }
 
-std::vector<std::shared_ptr<WorldObject>>& Level::getPickupObjects() {
-    return pickupObjects;
+void Level::resolveCollisions() {
+    const float radius = 0.5f; // Entities are treated as circles around their Position
+
+    for (Position& position : componentManager.positions) {
+        glm::vec2 point(position.x, position.z);
+        for (const Obstacle& obstacle : obstacles) {
+            glm::vec2 closest = obstacle.round ? obstacle.center
+                : glm::clamp(point, obstacle.center - obstacle.halfExtent, obstacle.center + obstacle.halfExtent);
+            float reach = radius + (obstacle.round ? obstacle.halfExtent.x : 0.0f);
+            glm::vec2 offset = point - closest;
+            float distance = glm::length(offset);
+            if (distance >= reach)
+                continue;
+
+            if (distance > 1e-4f) {
+                point = closest + offset / distance * reach;
+                continue;
+            }
+
+            // Center inside the footprint, leave along the axis with the shortest way out
+            glm::vec2 fromCenter = point - obstacle.center;
+            glm::vec2 depth = obstacle.halfExtent - glm::abs(fromCenter);
+            if (depth.x < depth.y)
+                point.x = obstacle.center.x + (fromCenter.x < 0.0f ? -1.0f : 1.0f) * (obstacle.halfExtent.x + radius);
+            else
+                point.y = obstacle.center.y + (fromCenter.y < 0.0f ? -1.0f : 1.0f) * (obstacle.halfExtent.y + radius);
+        }
+        position.x = point.x;
+        position.z = point.y;
+    }
 }
@@ -4,37 +4,52 @@
 #include <vector>
 #include <memory>
 #include <random>
+#include <glm/glm.hpp>
 #include "EntityManager.h"
 #include "ComponentManager.h"
-#include "WorldObject.h"
 #include "PrimitiveGenerator.h"
+#include "MeshLOD.h"
+#include "MeshPack.h"
+#include "StaticBatcher.h"
 
 class Level {
 public:
-    Level(EntityManager& entityManager, ComponentManager& componentManager);
+    // Meshes come from the pack when it has them, otherwise they are generated
+    Level(EntityManager& entityManager, ComponentManager& componentManager, const MeshPack* meshPack = nullptr);
+
+    // Adds the level's meshes to an offline mesh pack
+    static void cookMeshes(MeshPackWriter& writer);
 
     // Generate level with enemies and pickups, randomized if seed == 0
     void generateLevel(int numEnemies, int numPickups, unsigned int seed = 0);
 
-    // Get entities and WorldObjects
-    std::vector<unsigned int>& getEnemyEntities();
-    std::vector<std::shared_ptr<WorldObject>>& getEnemyObjects();
+    // Ground and props, one multi-draw per material over the visible cells
+    void drawStatic(Renderer& renderer) { scenery.draw(renderer); }
+
+    // Pushes every entity out of the walls and pillars, call after movement
+    void resolveCollisions();
 
-    std::vector<unsigned int>& getPickupEntities();
-    std::vector<std::shared_ptr<WorldObject>>& getPickupObjects();
+    // Enemies are the AI entities, the level is cleared once none are left
+    bool isCleared() const { return componentManager.ais.empty(); }
 
 private:
+    // Rebuilds the static batches, the ground is the same every level so only cells with props re-upload
+    void buildScenery(std::mt19937& rng);
+
     EntityManager& entityManager;
     ComponentManager& componentManager;
 
-    // Entities and WorldObjects
-    std::vector<unsigned int> enemyEntities;
-    std::vector<std::shared_ptr<WorldObject>> enemyObjects;
+    // Uploaded once and shared by every enemy/pickup Renderable
+    std::shared_ptr<GPUMeshLOD> enemyMesh;
+    std::shared_ptr<GPUMeshLOD> pickupMesh;
 
-    std::vector<unsigned int> pickupEntities;
-    std::vector<std::shared_ptr<WorldObject>> pickupObjects;
+    StaticBatcher scenery;
 
-    // Meshes for enemies and pickups
-    Mesh3D enemyMesh;
-    Mesh3D pickupMesh;
+    // Footprint of a wall or pillar on the ground plane
+    struct Obstacle {
+        glm::vec2 center;
+        glm::vec2 halfExtent; // Half size of a wall, x is the radius of a pillar
+        bool round;
+    };
+    std::vector<Obstacle> obstacles;
 };
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <iostream>
+#include <glm/glm.hpp>
 #include "Vertex.h"
 
 class Mesh3D {
@@ -41,6 +42,58 @@ public:
     const std::vector<unsigned int>& getIndices() 
     { return indices; }
 
+    // True if every vertex shares one color, which is then returned through color
+    bool getUniformColor(glm::vec3& color) const {
+        if (vertices.empty())
+            return false;
+        color = vertices[0].color;
+        for (const Vertex3D& vertex : vertices) {
+            if (vertex.color != color)
+                return false;
+        }
+        return true;
+    }
+
+    // True if every vertex carries a normal
+    bool hasNormals() const {
+        if (vertices.empty())
+            return false;
+        for (const Vertex3D& vertex : vertices) {
+            if (vertex.normal == glm::vec3(0.0f))
+                return false;
+        }
+        return true;
+    }
+
+    // Vertex normals when present, computed ones otherwise
+    std::vector<glm::vec3> getNormals() const {
+        if (!hasNormals())
+            return computeNormals();
+        std::vector<glm::vec3> normals(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+            normals[i] = glm::normalize(vertices[i].normal);
+        return normals;
+    }
+
+    // Area-weighted smooth normals, triangles referencing missing vertices are skipped
+    std::vector<glm::vec3> computeNormals() const {
+        std::vector<glm::vec3> normals(vertices.size(), glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            unsigned int a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            if (a >= vertices.size() || b >= vertices.size() || c >= vertices.size())
+                continue;
+            glm::vec3 faceNormal = glm::cross(vertices[b].position - vertices[a].position, vertices[c].position - vertices[a].position);
+            normals[a] += faceNormal;
+            normals[b] += faceNormal;
+            normals[c] += faceNormal;
+        }
+        for (glm::vec3& normal : normals) {
+            float length = glm::length(normal);
+            normal = length > 0.0f ? normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+        }
+        return normals;
+    }
+
     void printMeshSize() const {
         std::cout << "Mesh has " << vertices.size() << " vertices and " << indices.size() << " indices.\n";
     }
@@ -0,0 +1,289 @@
+#include "MeshArena.h"
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+FreeListAllocator::FreeListAllocator(size_t capacity) {
+    grow(capacity);
+}
+
+bool FreeListAllocator::allocate(size_t count, size_t& offset) {
+    if (count == 0) {
+        offset = 0;
+        return true;
+    }
+
+    for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+        if (it->second < count)
+            continue;
+
+        offset = it->first;
+        size_t remaining = it->second - count;
+        freeBlocks.erase(it);
+        if (remaining > 0)
+            freeBlocks[offset + count] = remaining;
+
+        usedCount += count;
+        return true;
+    }
+    return false;
+}
+
+void FreeListAllocator::free(size_t offset, size_t count) {
+    if (count == 0)
+        return;
+
+    usedCount -= count;
+    auto it = freeBlocks.emplace(offset, count).first;
+
+    // Merge with the following block
+    auto next = std::next(it);
+    if (next != freeBlocks.end() && it->first + it->second == next->first) {
+        it->second += next->second;
+        freeBlocks.erase(next);
+    }
+
+    // Merge with the preceding block
+    if (it != freeBlocks.begin()) {
+        auto prev = std::prev(it);
+        if (prev->first + prev->second == it->first) {
+            prev->second += it->second;
+            freeBlocks.erase(it);
+        }
+    }
+}
+
+void FreeListAllocator::grow(size_t newCapacity) {
+    if (newCapacity <= totalCapacity)
+        return;
+
+    size_t oldCapacity = totalCapacity;
+    totalCapacity = newCapacity;
+    usedCount += newCapacity - oldCapacity; // free() below subtracts it again
+    free(oldCapacity, newCapacity - oldCapacity);
+}
+
+MeshArena& MeshArena::instance() {
+    static MeshArena arena;
+    return arena;
+}
+
+
+void MeshArena::initializeIndices() {
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+    glBufferData(GL_COPY_WRITE_BUFFER, initialIndexCapacity * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    indexAllocator.grow(initialIndexCapacity);
+}
+
+MeshArena::VertexPool& MeshArena::getPool(VertexFormat format) {
+    if (EBO == 0)
+        initializeIndices();
+
+    VertexPool& pool = pools[static_cast<size_t>(format)];
+    if (pool.VAO != 0)
+        return pool;
+
+    pool.stride = vertexStride(format);
+    switch (format) {
+    case VertexFormat::Float:
+        pool.applyLayout = &applyVertexLayout<Vertex3D>;
+        break;
+    case VertexFormat::Packed:
+        pool.applyLayout = &applyVertexLayout<PackedVertex>;
+        break;
+    case VertexFormat::PackedColor:
+        pool.applyLayout = &applyVertexLayout<PackedColorVertex>;
+        break;
+    default:
+        std::cerr << "Unknown VertexFormat value." << std::endl;
+        break;
+    }
+
+    glGenVertexArrays(1, &pool.VAO);
+    glGenBuffers(1, &pool.VBO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, pool.VBO);
+    glBufferData(GL_ARRAY_BUFFER, initialVertexCapacity * pool.stride, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    pool.allocator.grow(initialVertexCapacity);
+    setupVertexFormat(pool);
+    return pool;
+}
+
+void MeshArena::setupVertexFormat(VertexPool& pool) {
+    glBindVertexArray(pool.VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, pool.VBO);
+
+    // Attribute pointers come from the format's compile-time layout
+    pool.applyLayout(0, 0);
+
+    // The element buffer binding is VAO state
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+GLuint MeshArena::reallocateBuffer(GLuint oldBuffer, size_t oldBytes, size_t newBytes) {
+    GLuint newBuffer;
+    glGenBuffers(1, &newBuffer);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, oldBuffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &oldBuffer);
+    return newBuffer;
+}
+
+void MeshArena::growVertices(VertexPool& pool, size_t minCapacity) {
+    size_t oldCapacity = pool.allocator.capacity();
+    size_t newCapacity = oldCapacity * 2;
+    while (newCapacity < minCapacity)
+        newCapacity *= 2;
+
+    pool.VBO = reallocateBuffer(pool.VBO, oldCapacity * pool.stride, newCapacity * pool.stride);
+    pool.allocator.grow(newCapacity);
+    setupVertexFormat(pool);
+}
+
+void MeshArena::growIndices(size_t minCapacity) {
+    size_t oldCapacity = indexAllocator.capacity();
+    size_t newCapacity = oldCapacity * 2;
+    while (newCapacity < minCapacity)
+        newCapacity *= 2;
+
+    EBO = reallocateBuffer(EBO, oldCapacity * sizeof(GLuint), newCapacity * sizeof(GLuint));
+    indexAllocator.grow(newCapacity);
+
+    // Every format's VAO references the element buffer
+    for (VertexPool& pool : pools) {
+        if (pool.VAO != 0)
+            setupVertexFormat(pool);
+    }
+}
+
+size_t MeshArena::vertexStride(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::Float:
+        return sizeof(Vertex3D);
+    case VertexFormat::Packed:
+        return sizeof(PackedVertex);
+    case VertexFormat::PackedColor:
+        return sizeof(PackedColorVertex);
+    default:
+        std::cerr << "Unknown VertexFormat value." << std::endl;
+        return 0;
+    }
+}
+
+namespace {
+    template <typename T>
+    void storeVertices(CookedMesh& cooked, const std::vector<T>& vertices) {
+        cooked.format = T::format;
+        cooked.vertexCount = vertices.size();
+        cooked.vertexData.resize(vertices.size() * sizeof(T));
+        if (!vertices.empty())
+            std::memcpy(cooked.vertexData.data(), vertices.data(), cooked.vertexData.size());
+    }
+}
+
+CookedMesh MeshArena::cook(const Mesh3D& sourceMesh, MeshOptimizationStats* stats) {
+    Mesh3D mesh = sourceMesh;
+    MeshOptimizationStats optimization = MeshOptimizer::optimize(mesh);
+    if (stats)
+        *stats = optimization;
+
+    CookedMesh cooked;
+    cooked.indices = mesh.indices;
+
+    // Half floats keep ~3 decimal digits, larger meshes stay in full precision
+    constexpr float maxHalfExtent = 64.0f;
+    for (const Vertex3D& vertex : mesh.vertices) {
+        glm::vec3 extent = glm::abs(vertex.position);
+        if (extent.x > maxHalfExtent || extent.y > maxHalfExtent || extent.z > maxHalfExtent) {
+            if (!mesh.hasNormals()) {
+                std::vector<glm::vec3> normals = mesh.computeNormals();
+                for (size_t i = 0; i < mesh.vertices.size(); ++i)
+                    mesh.vertices[i].normal = normals[i];
+            }
+            storeVertices(cooked, mesh.vertices);
+            return cooked;
+        }
+    }
+
+    std::vector<glm::vec3> normals = mesh.getNormals();
+
+    // A mesh-wide color becomes per-instance data, only varying colors stay in the vertices
+    glm::vec3 color;
+    if (mesh.getUniformColor(color)) {
+        std::vector<PackedVertex> packed(mesh.vertices.size());
+        for (size_t i = 0; i < packed.size(); ++i) {
+            packed[i].position = packPosition(mesh.vertices[i].position);
+            packed[i].normal = packNormal(normals[i]);
+        }
+        storeVertices(cooked, packed);
+        cooked.baseColor = glm::vec4(color, 1.0f);
+        return cooked;
+    }
+
+    std::vector<PackedColorVertex> packed(mesh.vertices.size());
+    for (size_t i = 0; i < packed.size(); ++i) {
+        packed[i].position = packPosition(mesh.vertices[i].position);
+        packed[i].normal = packNormal(normals[i]);
+        packed[i].color = packColor(mesh.vertices[i].color);
+    }
+    storeVertices(cooked, packed);
+    return cooked;
+}
+
+MeshAllocation MeshArena::upload(VertexFormat format, const void* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount) {
+    VertexPool& pool = getPool(format);
+
+    size_t vertexOffset, indexOffset;
+    while (!pool.allocator.allocate(vertexCount, vertexOffset))
+        growVertices(pool, pool.allocator.capacity() + vertexCount);
+    while (!indexAllocator.allocate(indexCount, indexOffset))
+        growIndices(indexAllocator.capacity() + indexCount);
+
+    // Indices stay mesh-local, the base vertex offsets them at draw time
+    glBindBuffer(GL_ARRAY_BUFFER, pool.VBO);
+    glBufferSubData(GL_ARRAY_BUFFER, vertexOffset * pool.stride, vertexCount * pool.stride, vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Upload through the copy target so the element binding of whichever VAO is bound is left alone
+    glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, indexOffset * sizeof(GLuint), indexCount * sizeof(GLuint), indices);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    MeshAllocation allocation;
+    allocation.format = format;
+    allocation.baseVertex = static_cast<GLint>(vertexOffset);
+    allocation.vertexCount = static_cast<GLuint>(vertexCount);
+    allocation.firstIndex = static_cast<GLuint>(indexOffset);
+    allocation.indexCount = static_cast<GLsizei>(indexCount);
+    return allocation;
+}
+
+void MeshArena::free(const MeshAllocation& allocation) {
+    pools[static_cast<size_t>(allocation.format)].allocator.free(allocation.baseVertex, allocation.vertexCount);
+    indexAllocator.free(allocation.firstIndex, allocation.indexCount);
+}
+
+void MeshArena::release() {
+    for (VertexPool& pool : pools) {
+        glDeleteVertexArrays(1, &pool.VAO);
+        glDeleteBuffers(1, &pool.VBO);
+        pool.VAO = 0;
+        pool.VBO = 0;
+    }
+    glDeleteBuffers(1, &EBO);
+    EBO = 0;
+}
@@ -0,0 +1,154 @@
+#ifndef MESH_ARENA_H
+#define MESH_ARENA_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+#include "Mesh.h"
+#include "MeshOptimizer.h"
+
+// First-fit sub-allocator over a linear range of elements, free blocks coalesce on release
+class FreeListAllocator {
+public:
+    explicit FreeListAllocator(size_t capacity = 0);
+
+    // Returns false if no free block is large enough
+    bool allocate(size_t count, size_t& offset);
+    void free(size_t offset, size_t count);
+
+    // Extend the managed range, the new tail becomes free space
+    void grow(size_t newCapacity);
+
+    size_t capacity() const { return totalCapacity; }
+    size_t used() const { return usedCount; }
+
+private:
+    std::map<size_t, size_t> freeBlocks; // offset -> size
+    size_t totalCapacity{ 0 };
+    size_t usedCount{ 0 };
+};
+
+// Location of a mesh inside the shared vertex and index buffers
+struct MeshAllocation {
+    VertexFormat format{ VertexFormat::Packed };
+    GLint baseVertex{ 0 };
+    GLuint vertexCount{ 0 };
+    GLuint firstIndex{ 0 };
+    GLsizei indexCount{ 0 };
+
+    // Byte offset into the element buffer, as expected by glDrawElements*
+    const void* indexOffset() const { return reinterpret_cast<const void*>(static_cast<uintptr_t>(firstIndex) * sizeof(GLuint)); }
+};
+
+// Mesh already optimized and quantized into a GPU vertex format, ready to be copied into the arena
+struct CookedMesh {
+    VertexFormat format{ VertexFormat::Packed };
+    std::vector<uint8_t> vertexData;
+    size_t vertexCount{ 0 };
+    std::vector<GLuint> indices;
+    glm::vec4 baseColor{ 1.0f }; // Mesh-wide color for formats without vertex colors
+};
+
+// One large EBO plus one VBO/VAO per vertex format, all static meshes are sub-allocated from them
+class MeshArena {
+public:
+    static MeshArena& instance();
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    // Optimizes a copy of the mesh and quantizes it into the most compact format that can represent it, no GL calls
+    static CookedMesh cook(const Mesh3D& mesh, MeshOptimizationStats* stats = nullptr);
+
+    MeshAllocation upload(const Mesh3D& mesh, MeshOptimizationStats* stats = nullptr) { return upload(cook(mesh, stats)); }
+    MeshAllocation upload(const CookedMesh& mesh) {
+        return upload(mesh.format, mesh.vertexData.data(), mesh.vertexCount, mesh.indices.data(), mesh.indices.size());
+    }
+
+    // Uploads vertices that are already in a GPU format, the source may be mapped file memory
+    MeshAllocation upload(VertexFormat format, const void* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount);
+
+    static size_t vertexStride(VertexFormat format);
+
+    void free(const MeshAllocation& allocation);
+
+    // Deletes the buffers and VAOs, call while the context is still current. Not done on destruction: the arena
+    // is a static and outlives the context. Meshes can still be freed afterwards, uploads cannot.
+    void release();
+
+    GLuint getVAO(VertexFormat format) const { return pools[static_cast<size_t>(format)].VAO; }
+
+    size_t vertexCapacity(VertexFormat format) const { return pools[static_cast<size_t>(format)].allocator.capacity(); }
+    size_t verticesUsed(VertexFormat format) const { return pools[static_cast<size_t>(format)].allocator.used(); }
+    size_t indexCapacity() const { return indexAllocator.capacity(); }
+    size_t indicesUsed() const { return indexAllocator.used(); }
+
+private:
+    struct VertexPool {
+        GLuint VAO{ 0 }, VBO{ 0 };
+        FreeListAllocator allocator;
+        size_t stride{ 0 };
+        void (*applyLayout)(GLuint divisor, size_t baseOffset){ nullptr };
+    };
+
+    MeshArena() = default;
+
+    void initializeIndices();
+    VertexPool& getPool(VertexFormat format);
+    void growVertices(VertexPool& pool, size_t minCapacity);
+    void growIndices(size_t minCapacity);
+    void setupVertexFormat(VertexPool& pool);
+
+    // Copies the old buffer contents into a larger buffer and returns the new one
+    static GLuint reallocateBuffer(GLuint oldBuffer, size_t oldBytes, size_t newBytes);
+
+    std::array<VertexPool, static_cast<size_t>(VertexFormat::Count)> pools;
+    GLuint EBO{ 0 };
+    FreeListAllocator indexAllocator;
+
+    static constexpr size_t initialVertexCapacity{ 1 << 16 };
+    static constexpr size_t initialIndexCapacity{ 1 << 18 };
+};
+
+// Owning handle for a mesh uploaded to the arena, released when the last user lets go
+class GPUMesh {
+public:
+    // Not delegating to the CookedMesh constructor, the stats member only exists once the body runs
+    explicit GPUMesh(const Mesh3D& mesh) {
+        CookedMesh cooked = MeshArena::cook(mesh, &optimizationStats);
+        allocation = MeshArena::instance().upload(cooked);
+        baseColor = cooked.baseColor;
+    }
+    explicit GPUMesh(const CookedMesh& mesh) : allocation(MeshArena::instance().upload(mesh)), baseColor(mesh.baseColor) {}
+
+    // Takes ownership of an allocation that was uploaded directly
+    GPUMesh(const MeshAllocation& allocation, const glm::vec4& baseColor) : allocation(allocation), baseColor(baseColor) {}
+    ~GPUMesh() { MeshArena::instance().free(allocation); }
+
+    GPUMesh(const GPUMesh&) = delete;
+    GPUMesh& operator=(const GPUMesh&) = delete;
+
+    const MeshAllocation& getAllocation() const { return allocation; }
+
+    // Mesh-wide color moved out of the vertices, white when colors are stored per vertex
+    const glm::vec4& getBaseColor() const { return baseColor; }
+
+    const MeshOptimizationStats& getOptimizationStats() const { return optimizationStats; }
+
+private:
+    MeshAllocation allocation;
+    glm::vec4 baseColor{ 1.0f };
+    MeshOptimizationStats optimizationStats; // Zero unless built from a Mesh3D
+};
+
+// Set of arena meshes sharing one model matrix and color, submitted with one multi-draw per vertex format
+struct MeshBatch {
+    std::vector<MeshAllocation> parts;
+    glm::mat4 modelMatrix{ 1.0f };
+    glm::vec4 color{ 1.0f };
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "MeshLOD.h"
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+
+std::vector<Mesh3D> MeshLOD::buildChain(const Mesh3D& mesh, int levelCount, float reduction) {
+    std::vector<Mesh3D> chain;
+    chain.push_back(mesh);
+
+    for (int level = 1; level < levelCount; ++level) {
+        const Mesh3D& previous = chain.back();
+        size_t previousTriangles = previous.indices.size() / 3;
+        size_t target = static_cast<size_t>(previousTriangles * reduction);
+        if (target < 4)
+            break;
+
+        Mesh3D simplified = MeshSimplifier::simplify(previous, target);
+
+        // Stop once the simplifier cannot make meaningful progress
+        if (simplified.indices.size() / 3 >= previousTriangles)
+            break;
+        chain.push_back(simplified);
+    }
+    return chain;
+}
+
+float MeshLOD::boundingRadius(const Mesh3D& mesh) {
+    float radius = 0.0f;
+    for (const Vertex3D& vertex : mesh.vertices)
+        radius = std::max(radius, glm::length(vertex.position));
+    return radius;
+}
+
+GPUMeshLOD::GPUMeshLOD(const std::vector<Mesh3D>& meshes) {
+    for (const Mesh3D& mesh : meshes) {
+        levels.push_back(std::make_shared<GPUMesh>(mesh));
+        boundingRadius = std::max(boundingRadius, MeshLOD::boundingRadius(mesh));
+    }
+}
+
+size_t MeshLOD::selectLevel(float screenSize, float fullDetailSize, size_t levelCount) {
+    if (levelCount <= 1 || screenSize >= fullDetailSize)
+        return 0;
+    if (screenSize <= 0.0f)
+        return levelCount - 1;
+
+    size_t level = static_cast<size_t>(std::log2(fullDetailSize / screenSize));
+    return std::min(level, levelCount - 1);
+}
+
+size_t GPUMeshLOD::selectLevel(float screenSize) const {
+    return MeshLOD::selectLevel(screenSize, fullDetailSize, levels.size());
+}
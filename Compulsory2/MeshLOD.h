@@ -0,0 +1,46 @@
+#ifndef MESH_LOD_H
+#define MESH_LOD_H
+
+#include <memory>
+#include <vector>
+#include "Mesh.h"
+#include "MeshArena.h"
+
+// Builds LOD chains on the CPU, level 0 is the full-detail mesh
+class MeshLOD {
+public:
+    // Each level keeps roughly reduction times the triangles of the previous one (quadric simplification)
+    static std::vector<Mesh3D> buildChain(const Mesh3D& mesh, int levelCount, float reduction = 0.5f);
+
+    // Radius of the sphere around the origin enclosing every vertex
+    static float boundingRadius(const Mesh3D& mesh);
+
+    // Level for an object covering screenSize of the viewport height, see GPUMeshLOD::selectLevel.
+    // Culling.comp makes the same choice on the GPU.
+    static size_t selectLevel(float screenSize, float fullDetailSize, size_t levelCount);
+};
+
+// Uploaded LOD chain, levels are picked from the projected size of the object
+class GPUMeshLOD {
+public:
+    explicit GPUMeshLOD(const std::vector<Mesh3D>& levels);
+
+    // Adopts levels that were uploaded elsewhere, e.g. from a mesh pack
+    GPUMeshLOD(const std::vector<std::shared_ptr<GPUMesh>>& levels, float boundingRadius) : levels(levels), boundingRadius(boundingRadius) {}
+
+    size_t getLevelCount() const { return levels.size(); }
+    const GPUMesh& getLevel(size_t level) const { return *levels[level]; }
+    float getBoundingRadius() const { return boundingRadius; }
+
+    // screenSize is the projected diameter as a fraction of the viewport height.
+    // Level 0 covers fullDetailSize and up, every halving of the size drops one level.
+    size_t selectLevel(float screenSize) const;
+
+    float fullDetailSize{ 0.5f };
+
+private:
+    std::vector<std::shared_ptr<GPUMesh>> levels;
+    float boundingRadius{ 0.0f };
+};
+
+#endif
@@ -0,0 +1,402 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+    // Forsyth scoring constants, see "Linear-Speed Vertex Cache Optimisation"
+    constexpr int forsythCacheSize = 32;
+    constexpr float cacheDecayPower = 1.5f;
+    constexpr float lastTriangleScore = 0.75f;
+    constexpr float valenceBoostScale = 2.0f;
+    constexpr float valenceBoostPower = 0.5f;
+
+    float vertexScore(int cachePosition, int liveTriangles) {
+        if (liveTriangles == 0)
+            return -1.0f; // No triangles left, never pick again
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // The last triangle's vertices get a fixed score so strips are not favoured over fans
+                score = lastTriangleScore;
+            }
+            else {
+                float scaler = 1.0f / (forsythCacheSize - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, cacheDecayPower);
+            }
+        }
+
+        // Boost vertices with few triangles left so they get finished off
+        score += valenceBoostScale * std::pow(static_cast<float>(liveTriangles), -valenceBoostPower);
+        return score;
+    }
+
+    // Hash key for welding, positions and colors snapped to the epsilon grid
+    struct WeldKey {
+        int64_t p[3];
+        int64_t c[3];
+        int64_t n[3];
+        bool operator==(const WeldKey& other) const {
+            return std::equal(p, p + 3, other.p) && std::equal(c, c + 3, other.c) && std::equal(n, n + 3, other.n);
+        }
+    };
+
+    struct WeldKeyHash {
+        size_t operator()(const WeldKey& key) const {
+            size_t hash = 1469598103934665603ull;
+            for (int i = 0; i < 3; ++i) {
+                hash = (hash ^ static_cast<size_t>(key.p[i])) * 1099511628211ull;
+                hash = (hash ^ static_cast<size_t>(key.c[i])) * 1099511628211ull;
+                hash = (hash ^ static_cast<size_t>(key.n[i])) * 1099511628211ull;
+            }
+            return hash;
+        }
+    };
+}
+
+MeshOptimizationStats MeshOptimizer::optimize(Mesh3D& mesh) {
+    MeshOptimizationStats stats;
+    stats.verticesBefore = mesh.vertices.size();
+    stats.trianglesBefore = mesh.indices.size() / 3;
+
+    std::pair<size_t, size_t> removed = removeInvalidTriangles(mesh);
+    stats.invalidTriangles = removed.first;
+    stats.degenerateTriangles = removed.second;
+    stats.acmrBefore = computeACMR(mesh);
+
+    weldVertices(mesh);
+
+    // Generated meshes are sometimes already well ordered, keep whichever order caches better
+    std::vector<unsigned int> original = mesh.indices;
+    float originalACMR = computeACMR(mesh);
+    optimizeVertexCache(mesh);
+    if (computeACMR(mesh) > originalACMR)
+        mesh.indices.swap(original);
+
+    optimizeOverdraw(mesh);
+    optimizeVertexFetch(mesh);
+
+    stats.verticesAfter = mesh.vertices.size();
+    stats.trianglesAfter = mesh.indices.size() / 3;
+    stats.acmrAfter = computeACMR(mesh);
+    return stats;
+}
+
+std::pair<size_t, size_t> MeshOptimizer::removeInvalidTriangles(Mesh3D& mesh) {
+    size_t invalid = 0, degenerate = 0;
+    size_t vertexCount = mesh.vertices.size();
+    size_t write = 0;
+
+    // Trailing indices that do not form a full triangle count as invalid
+    size_t triangleIndices = mesh.indices.size() - mesh.indices.size() % 3;
+    if (triangleIndices != mesh.indices.size())
+        ++invalid;
+
+    for (size_t i = 0; i < triangleIndices; i += 3) {
+        unsigned int a = mesh.indices[i], b = mesh.indices[i + 1], c = mesh.indices[i + 2];
+        if (a >= vertexCount || b >= vertexCount || c >= vertexCount) {
+            ++invalid;
+            continue;
+        }
+        if (a == b || b == c || a == c) {
+            ++degenerate;
+            continue;
+        }
+        mesh.indices[write++] = a;
+        mesh.indices[write++] = b;
+        mesh.indices[write++] = c;
+    }
+    mesh.indices.resize(write);
+    return { invalid, degenerate };
+}
+
+size_t MeshOptimizer::weldVertices(Mesh3D& mesh, float epsilon) {
+    std::unordered_map<WeldKey, unsigned int, WeldKeyHash> unique;
+    std::vector<unsigned int> remap(mesh.vertices.size());
+    std::vector<Vertex3D> welded;
+    welded.reserve(mesh.vertices.size());
+
+    float inverse = 1.0f / epsilon;
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        const Vertex3D& vertex = mesh.vertices[i];
+        WeldKey key;
+        for (int k = 0; k < 3; ++k) {
+            key.p[k] = static_cast<int64_t>(std::llround(vertex.position[k] * inverse));
+            key.c[k] = static_cast<int64_t>(std::llround(vertex.color[k] * inverse));
+            key.n[k] = static_cast<int64_t>(std::llround(vertex.normal[k] * inverse));
+        }
+
+        auto it = unique.find(key);
+        if (it == unique.end()) {
+            unsigned int index = static_cast<unsigned int>(welded.size());
+            unique.emplace(key, index);
+            welded.push_back(vertex);
+            remap[i] = index;
+        }
+        else {
+            remap[i] = it->second;
+        }
+    }
+
+    for (unsigned int& index : mesh.indices)
+        index = remap[index];
+
+    size_t removed = mesh.vertices.size() - welded.size();
+    mesh.vertices.swap(welded);
+
+    // Welding can collapse triangles onto a shared vertex
+    removeInvalidTriangles(mesh);
+    return removed;
+}
+
+void MeshOptimizer::optimizeVertexCache(Mesh3D& mesh) {
+    size_t vertexCount = mesh.vertices.size();
+    size_t triangleCount = mesh.indices.size() / 3;
+    if (triangleCount == 0)
+        return;
+
+    // Vertex -> triangle adjacency in one flat array
+    std::vector<int> liveTriangles(vertexCount, 0);
+    for (unsigned int index : mesh.indices)
+        ++liveTriangles[index];
+
+    std::vector<size_t> adjacencyOffset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v)
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + liveTriangles[v];
+
+    std::vector<unsigned int> adjacency(mesh.indices.size());
+    std::vector<size_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            unsigned int v = mesh.indices[t * 3 + k];
+            adjacency[fill[v]++] = static_cast<unsigned int>(t);
+        }
+    }
+
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        vertexScores[v] = vertexScore(-1, liveTriangles[v]);
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScores[t] = vertexScores[mesh.indices[t * 3]] + vertexScores[mesh.indices[t * 3 + 1]] + vertexScores[mesh.indices[t * 3 + 2]];
+    }
+
+    std::vector<unsigned int> output;
+    output.reserve(mesh.indices.size());
+
+    // Three extra slots hold vertices pushed out while inserting a triangle
+    std::vector<unsigned int> cache;
+    cache.reserve(forsythCacheSize + 3);
+
+    size_t scanCursor = 0;
+    int bestTriangle = -1;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (bestTriangle < 0) {
+            // Nothing adjacent to the cache left, fall back to the best remaining triangle
+            float bestScore = -1.0f;
+            for (size_t t = scanCursor; t < triangleCount; ++t) {
+                if (!emitted[t] && triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    bestTriangle = static_cast<int>(t);
+                }
+            }
+        }
+
+        emitted[bestTriangle] = true;
+        while (scanCursor < triangleCount && emitted[scanCursor])
+            ++scanCursor;
+
+        for (int k = 0; k < 3; ++k)
+            output.push_back(mesh.indices[bestTriangle * 3 + k]);
+
+        // Move its vertices to the front of the LRU cache and retire the triangle from their live lists
+        for (int k = 2; k >= 0; --k) {
+            unsigned int v = mesh.indices[bestTriangle * 3 + k];
+
+            auto found = std::find(cache.begin(), cache.end(), v);
+            if (found != cache.end())
+                cache.erase(found);
+            cache.insert(cache.begin(), v);
+
+            --liveTriangles[v];
+            size_t begin = adjacencyOffset[v];
+            size_t end = begin + liveTriangles[v] + 1;
+            for (size_t a = begin; a < end; ++a) {
+                if (adjacency[a] == static_cast<unsigned int>(bestTriangle)) {
+                    std::swap(adjacency[a], adjacency[end - 1]);
+                    break;
+                }
+            }
+        }
+
+        // Rescore everything that was in the cache, including vertices just evicted
+        for (size_t i = 0; i < cache.size(); ++i) {
+            unsigned int v = cache[i];
+            int position = i < static_cast<size_t>(forsythCacheSize) ? static_cast<int>(i) : -1;
+
+            float newScore = vertexScore(position, liveTriangles[v]);
+            float delta = newScore - vertexScores[v];
+            vertexScores[v] = newScore;
+
+            size_t begin = adjacencyOffset[v];
+            for (size_t a = begin; a < begin + liveTriangles[v]; ++a)
+                triangleScores[adjacency[a]] += delta;
+        }
+        if (cache.size() > static_cast<size_t>(forsythCacheSize))
+            cache.resize(forsythCacheSize);
+
+        // Next triangle is the best one touching the cache
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (unsigned int v : cache) {
+            size_t begin = adjacencyOffset[v];
+            for (size_t a = begin; a < begin + liveTriangles[v]; ++a) {
+                unsigned int t = adjacency[a];
+                if (triangleScores[t] > bestScore) {
+                    bestScore = triangleScores[t];
+                    bestTriangle = static_cast<int>(t);
+                }
+            }
+        }
+    }
+
+    mesh.indices.swap(output);
+}
+
+void MeshOptimizer::optimizeOverdraw(Mesh3D& mesh, float threshold) {
+    size_t triangleCount = mesh.indices.size() / 3;
+    if (triangleCount < 2)
+        return;
+
+    // Split the cache-ordered stream into clusters. A hard boundary is a triangle whose three
+    // vertices all miss the cache, reordering there costs nothing; soft boundaries are added
+    // where the cluster so far is already at least as cache efficient as the whole mesh.
+    const unsigned int cacheSize = 16;
+    float meshACMR = computeACMR(mesh, cacheSize);
+
+    std::vector<size_t> clusterStarts;
+    std::vector<unsigned int> timestamp(mesh.vertices.size(), 0);
+    unsigned int time = cacheSize + 1;
+    size_t clusterMisses = 0;
+
+    for (size_t t = 0; t < triangleCount; ++t) {
+        int misses = 0;
+        for (int k = 0; k < 3; ++k) {
+            unsigned int v = mesh.indices[t * 3 + k];
+            if (time - timestamp[v] > cacheSize) {
+                timestamp[v] = time++;
+                ++misses;
+            }
+        }
+
+        size_t clusterTriangles = clusterStarts.empty() ? 0 : t - clusterStarts.back();
+        bool hardBoundary = misses == 3;
+        bool softBoundary = clusterTriangles > 0 &&
+            static_cast<float>(clusterMisses) / clusterTriangles <= meshACMR * threshold && misses >= 2;
+
+        if (clusterStarts.empty() || hardBoundary || softBoundary) {
+            clusterStarts.push_back(t);
+            clusterMisses = 0;
+        }
+        clusterMisses += misses;
+    }
+    clusterStarts.push_back(triangleCount);
+
+    // Mesh centroid weighted by triangle area
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& a = mesh.vertices[mesh.indices[t * 3]].position;
+        const glm::vec3& b = mesh.vertices[mesh.indices[t * 3 + 1]].position;
+        const glm::vec3& c = mesh.vertices[mesh.indices[t * 3 + 2]].position;
+        float area = glm::length(glm::cross(b - a, c - a));
+        meshCentroid += (a + b + c) / 3.0f * area;
+        meshArea += area;
+    }
+    if (meshArea > 0.0f)
+        meshCentroid /= meshArea;
+
+    // Clusters facing away from the centre are likely to occlude the rest, draw them first
+    size_t clusterCount = clusterStarts.size() - 1;
+    std::vector<float> sortKey(clusterCount);
+    for (size_t i = 0; i < clusterCount; ++i) {
+        glm::vec3 centroid(0.0f), normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = clusterStarts[i]; t < clusterStarts[i + 1]; ++t) {
+            const glm::vec3& a = mesh.vertices[mesh.indices[t * 3]].position;
+            const glm::vec3& b = mesh.vertices[mesh.indices[t * 3 + 1]].position;
+            const glm::vec3& c = mesh.vertices[mesh.indices[t * 3 + 2]].position;
+            glm::vec3 faceNormal = glm::cross(b - a, c - a);
+            float faceArea = glm::length(faceNormal);
+            centroid += (a + b + c) / 3.0f * faceArea;
+            normal += faceNormal;
+            area += faceArea;
+        }
+        if (area > 0.0f)
+            centroid /= area;
+        float normalLength = glm::length(normal);
+        if (normalLength > 0.0f)
+            normal /= normalLength;
+        sortKey[i] = glm::dot(centroid - meshCentroid, normal);
+    }
+
+    std::vector<size_t> order(clusterCount);
+    for (size_t i = 0; i < clusterCount; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+    std::vector<unsigned int> output;
+    output.reserve(mesh.indices.size());
+    for (size_t cluster : order) {
+        output.insert(output.end(), mesh.indices.begin() + clusterStarts[cluster] * 3,
+            mesh.indices.begin() + clusterStarts[cluster + 1] * 3);
+    }
+
+    // Cluster seams can cost cache hits, keep the cache order when they cost more than threshold allows
+    mesh.indices.swap(output);
+    if (computeACMR(mesh, cacheSize) > meshACMR * threshold)
+        mesh.indices.swap(output);
+}
+
+void MeshOptimizer::optimizeVertexFetch(Mesh3D& mesh) {
+    const unsigned int unused = ~0u;
+    std::vector<unsigned int> remap(mesh.vertices.size(), unused);
+    std::vector<Vertex3D> ordered;
+    ordered.reserve(mesh.vertices.size());
+
+    for (unsigned int& index : mesh.indices) {
+        if (remap[index] == unused) {
+            remap[index] = static_cast<unsigned int>(ordered.size());
+            ordered.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    // Vertices no triangle references are dropped
+    mesh.vertices.swap(ordered);
+}
+
+float MeshOptimizer::computeACMR(const Mesh3D& mesh, unsigned int cacheSize) {
+    size_t triangleCount = mesh.indices.size() / 3;
+    if (triangleCount == 0)
+        return 0.0f;
+
+    // FIFO cache simulated with insertion timestamps
+    std::vector<unsigned int> timestamp(mesh.vertices.size(), 0);
+    unsigned int time = cacheSize + 1;
+    size_t misses = 0;
+    for (unsigned int index : mesh.indices) {
+        if (index >= mesh.vertices.size())
+            continue;
+        if (time - timestamp[index] > cacheSize) {
+            timestamp[index] = time++;
+            ++misses;
+        }
+    }
+    return static_cast<float>(misses) / triangleCount;
+}
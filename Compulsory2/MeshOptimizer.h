@@ -0,0 +1,49 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <utility>
+#include "Mesh.h"
+
+// Before/after numbers of one optimization run
+struct MeshOptimizationStats {
+    size_t verticesBefore{ 0 }, verticesAfter{ 0 };
+    size_t trianglesBefore{ 0 }, trianglesAfter{ 0 };
+    size_t invalidTriangles{ 0 };    // Referenced a vertex that does not exist
+    size_t degenerateTriangles{ 0 }; // Repeated an index
+    float acmrBefore{ 0.0f }, acmrAfter{ 0.0f }; // Average cache miss ratio, transformed vertices per triangle
+
+    void print() const {
+        std::cout << "Mesh optimized: " << verticesBefore << " -> " << verticesAfter << " vertices, "
+            << trianglesBefore << " -> " << trianglesAfter << " triangles ("
+            << invalidTriangles << " invalid, " << degenerateTriangles << " degenerate), ACMR "
+            << acmrBefore << " -> " << acmrAfter << "\n";
+    }
+};
+
+// Mesh processing applied before upload: validation, welding and GPU-friendly reordering
+class MeshOptimizer {
+public:
+    // Runs every step below in order and reports the effect
+    static MeshOptimizationStats optimize(Mesh3D& mesh);
+
+    // Drops triangles with out-of-range or repeated indices, returns { invalid, degenerate } counts
+    static std::pair<size_t, size_t> removeInvalidTriangles(Mesh3D& mesh);
+
+    // Merges vertices with equal position, color and normal (within epsilon), returns the number removed
+    static size_t weldVertices(Mesh3D& mesh, float epsilon = 1e-5f);
+
+    // Forsyth's linear-speed triangle reordering for the post-transform vertex cache
+    static void optimizeVertexCache(Mesh3D& mesh);
+
+    // Sorts cache-friendly triangle clusters front-to-back from the outside in,
+    // allowing the ACMR to degrade by at most threshold
+    static void optimizeOverdraw(Mesh3D& mesh, float threshold = 1.05f);
+
+    // Renumbers vertices in first-use order so vertex fetch walks memory linearly
+    static void optimizeVertexFetch(Mesh3D& mesh);
+
+    // Simulated FIFO post-transform cache, misses per triangle
+    static float computeACMR(const Mesh3D& mesh, unsigned int cacheSize = 16);
+};
+
+#endif
@@ -0,0 +1,223 @@
+#include "MeshPack.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <iostream>
+
+namespace {
+    const char MESH_PACK_MAGIC[4] = { 'M', 'P', 'A', 'K' };
+
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool isLittleEndian() {
+        uint32_t value = 1;
+        uint8_t firstByte;
+        std::memcpy(&firstByte, &value, 1);
+        return firstByte == 1;
+    }
+
+    bool rangeInside(uint64_t offset, uint64_t size, uint64_t limit) {
+        return offset <= limit && size <= limit - offset;
+    }
+}
+
+void MeshPackWriter::addMesh(const std::string& name, const std::vector<Mesh3D>& levels) {
+    if (name.size() >= MESH_PACK_NAME_LENGTH) {
+        std::cerr << "Mesh pack name too long: " << name << std::endl;
+        return;
+    }
+    if (levels.empty())
+        return;
+
+    Entry entry;
+    entry.name = name;
+    entry.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    entry.boundsMax = glm::vec3(-std::numeric_limits<float>::max());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const Mesh3D& level = levels[i];
+        MeshOptimizationStats stats;
+        entry.levels.push_back(MeshArena::cook(level, &stats));
+        std::cout << name << " LOD " << i << ": ";
+        stats.print();
+        entry.boundingRadius = std::max(entry.boundingRadius, MeshLOD::boundingRadius(level));
+        for (const Vertex3D& vertex : level.vertices) {
+            entry.boundsMin = glm::min(entry.boundsMin, vertex.position);
+            entry.boundsMax = glm::max(entry.boundsMax, vertex.position);
+        }
+    }
+    entries.push_back(std::move(entry));
+}
+
+bool MeshPackWriter::write(const std::string& path) const {
+    // The runtime maps the file as-is, so the cooker only runs where that matches the format
+    if (!isLittleEndian()) {
+        std::cerr << "Mesh packs can only be cooked on little-endian hosts" << std::endl;
+        return false;
+    }
+
+    std::vector<MeshPackMesh> meshTable;
+    std::vector<MeshPackLOD> lodTable;
+    size_t dataSize = 0;
+    for (const Entry& entry : entries) {
+        MeshPackMesh mesh{};
+        std::memcpy(mesh.name, entry.name.c_str(), entry.name.size());
+        mesh.firstLOD = static_cast<uint32_t>(lodTable.size());
+        mesh.lodCount = static_cast<uint32_t>(entry.levels.size());
+        for (int axis = 0; axis < 3; ++axis) {
+            mesh.boundsMin[axis] = entry.boundsMin[axis];
+            mesh.boundsMax[axis] = entry.boundsMax[axis];
+        }
+        mesh.boundingRadius = entry.boundingRadius;
+        meshTable.push_back(mesh);
+
+        for (const CookedMesh& level : entry.levels) {
+            MeshPackLOD lod{};
+            lod.format = static_cast<uint32_t>(level.format);
+            lod.vertexCount = static_cast<uint32_t>(level.vertexCount);
+            lod.indexCount = static_cast<uint32_t>(level.indices.size());
+            lod.vertexOffset = dataSize;
+            dataSize = alignUp(dataSize + level.vertexData.size(), MESH_PACK_BLOB_ALIGNMENT);
+            lod.indexOffset = dataSize;
+            dataSize = alignUp(dataSize + level.indices.size() * sizeof(GLuint), MESH_PACK_BLOB_ALIGNMENT);
+            for (int i = 0; i < 4; ++i)
+                lod.baseColor[i] = level.baseColor[i];
+            lodTable.push_back(lod);
+        }
+    }
+
+    MeshPackHeader header{};
+    std::memcpy(header.magic, MESH_PACK_MAGIC, sizeof(header.magic));
+    header.version = MESH_PACK_VERSION;
+    header.endianTag = MESH_PACK_ENDIAN_TAG;
+    header.meshCount = static_cast<uint32_t>(meshTable.size());
+    header.lodCount = static_cast<uint32_t>(lodTable.size());
+    header.meshTableOffset = sizeof(MeshPackHeader);
+    header.lodTableOffset = header.meshTableOffset + meshTable.size() * sizeof(MeshPackMesh);
+    header.dataOffset = alignUp(static_cast<size_t>(header.lodTableOffset + lodTable.size() * sizeof(MeshPackLOD)), MESH_PACK_DATA_ALIGNMENT);
+    header.dataSize = dataSize;
+
+    // Build the whole image in memory, padding bytes stay zero
+    std::vector<uint8_t> image(static_cast<size_t>(header.dataOffset + header.dataSize), 0);
+    std::memcpy(image.data(), &header, sizeof(header));
+    if (!meshTable.empty())
+        std::memcpy(image.data() + header.meshTableOffset, meshTable.data(), meshTable.size() * sizeof(MeshPackMesh));
+    if (!lodTable.empty())
+        std::memcpy(image.data() + header.lodTableOffset, lodTable.data(), lodTable.size() * sizeof(MeshPackLOD));
+
+    uint8_t* blob = image.data() + header.dataOffset;
+    size_t lodIndex = 0;
+    for (const Entry& entry : entries) {
+        for (const CookedMesh& level : entry.levels) {
+            const MeshPackLOD& lod = lodTable[lodIndex++];
+            if (!level.vertexData.empty())
+                std::memcpy(blob + lod.vertexOffset, level.vertexData.data(), level.vertexData.size());
+            if (!level.indices.empty())
+                std::memcpy(blob + lod.indexOffset, level.indices.data(), level.indices.size() * sizeof(GLuint));
+        }
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to open " << path << " for writing" << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    if (!out) {
+        std::cerr << "Failed to write " << path << std::endl;
+        return false;
+    }
+
+    std::cout << "Cooked " << meshTable.size() << " meshes (" << lodTable.size() << " LODs, "
+        << image.size() << " bytes) to " << path << "\n";
+    return true;
+}
+
+bool MeshPack::open(const std::string& path) {
+    close();
+    if (!file.open(path))
+        return false;
+
+    const uint8_t* base = file.getData();
+    size_t size = file.getSize();
+    header = reinterpret_cast<const MeshPackHeader*>(base);
+
+    // Only bounds are checked here, nothing is parsed or converted
+    bool valid = size >= sizeof(MeshPackHeader)
+        && std::memcmp(header->magic, MESH_PACK_MAGIC, sizeof(header->magic)) == 0
+        && header->version == MESH_PACK_VERSION
+        && header->endianTag == MESH_PACK_ENDIAN_TAG
+        && header->meshTableOffset % alignof(MeshPackMesh) == 0
+        && header->lodTableOffset % alignof(MeshPackLOD) == 0
+        && header->dataOffset % MESH_PACK_BLOB_ALIGNMENT == 0
+        && rangeInside(header->meshTableOffset, uint64_t(header->meshCount) * sizeof(MeshPackMesh), size)
+        && rangeInside(header->lodTableOffset, uint64_t(header->lodCount) * sizeof(MeshPackLOD), size)
+        && rangeInside(header->dataOffset, header->dataSize, size);
+    if (!valid) {
+        std::cerr << "Invalid or outdated mesh pack: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    meshes = reinterpret_cast<const MeshPackMesh*>(base + header->meshTableOffset);
+    lods = reinterpret_cast<const MeshPackLOD*>(base + header->lodTableOffset);
+    data = base + header->dataOffset;
+
+    for (uint32_t i = 0; i < header->meshCount; ++i) {
+        const MeshPackMesh& mesh = meshes[i];
+        if (!rangeInside(mesh.firstLOD, mesh.lodCount, header->lodCount) || mesh.name[MESH_PACK_NAME_LENGTH - 1] != '\0')
+            valid = false;
+    }
+    for (uint32_t i = 0; i < header->lodCount && valid; ++i) {
+        const MeshPackLOD& lod = lods[i];
+        size_t stride = lod.format < static_cast<uint32_t>(VertexFormat::Count) ? MeshArena::vertexStride(static_cast<VertexFormat>(lod.format)) : 0;
+        valid = stride != 0
+            && lod.vertexOffset % MESH_PACK_BLOB_ALIGNMENT == 0
+            && lod.indexOffset % MESH_PACK_BLOB_ALIGNMENT == 0
+            && rangeInside(lod.vertexOffset, uint64_t(lod.vertexCount) * stride, header->dataSize)
+            && rangeInside(lod.indexOffset, uint64_t(lod.indexCount) * sizeof(GLuint), header->dataSize);
+    }
+    if (!valid) {
+        std::cerr << "Corrupt mesh pack tables: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+const MeshPackMesh* MeshPack::findMesh(const std::string& name) const {
+    if (!isOpen())
+        return nullptr;
+    for (uint32_t i = 0; i < header->meshCount; ++i) {
+        if (name == meshes[i].name)
+            return &meshes[i];
+    }
+    return nullptr;
+}
+
+std::shared_ptr<GPUMesh> MeshPack::uploadLOD(const MeshPackLOD& lod) const {
+    MeshAllocation allocation = MeshArena::instance().upload(static_cast<VertexFormat>(lod.format),
+        data + lod.vertexOffset, lod.vertexCount,
+        reinterpret_cast<const GLuint*>(data + lod.indexOffset), lod.indexCount);
+    return std::make_shared<GPUMesh>(allocation, glm::vec4(lod.baseColor[0], lod.baseColor[1], lod.baseColor[2], lod.baseColor[3]));
+}
+
+std::shared_ptr<GPUMeshLOD> MeshPack::loadLOD(const std::string& name) const {
+    const MeshPackMesh* mesh = findMesh(name);
+    if (!mesh)
+        return nullptr;
+
+    std::vector<std::shared_ptr<GPUMesh>> levels;
+    for (uint32_t i = 0; i < mesh->lodCount; ++i)
+        levels.push_back(uploadLOD(lods[mesh->firstLOD + i]));
+    return std::make_shared<GPUMeshLOD>(levels, mesh->boundingRadius);
+}
+
+std::shared_ptr<GPUMesh> MeshPack::loadMesh(const std::string& name, size_t level) const {
+    const MeshPackMesh* mesh = findMesh(name);
+    if (!mesh || level >= mesh->lodCount)
+        return nullptr;
+    return uploadLOD(lods[mesh->firstLOD + level]);
+}
@@ -0,0 +1,106 @@
+#ifndef MESH_PACK_H
+#define MESH_PACK_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "MeshArena.h"
+#include "MeshLOD.h"
+
+// Cooked mesh pack, version 1. All fields little-endian, the file is used in place once mapped:
+//   MeshPackHeader
+//   MeshPackMesh[meshCount]  at meshTableOffset
+//   MeshPackLOD[lodCount]    at lodTableOffset
+//   data blob                at dataOffset (page aligned), every vertex/index range 16-byte aligned
+const uint32_t MESH_PACK_VERSION = 1;
+const uint32_t MESH_PACK_ENDIAN_TAG = 0x01020304;
+const size_t MESH_PACK_NAME_LENGTH = 32;
+const size_t MESH_PACK_DATA_ALIGNMENT = 4096;
+const size_t MESH_PACK_BLOB_ALIGNMENT = 16;
+
+// Written by --cook, loaded at startup when present
+const char* const DEFAULT_MESH_PACK_PATH = "Meshes.mpak";
+
+struct MeshPackHeader {
+    char magic[4];      // "MPAK"
+    uint32_t version;
+    uint32_t endianTag; // Reads back as MESH_PACK_ENDIAN_TAG only on a matching byte order
+    uint32_t meshCount;
+    uint32_t lodCount;
+    uint32_t reserved;
+    uint64_t meshTableOffset;
+    uint64_t lodTableOffset;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+};
+
+// Named mesh with its LOD chain and bounds in model space
+struct MeshPackMesh {
+    char name[MESH_PACK_NAME_LENGTH]; // Zero padded
+    uint32_t firstLOD;
+    uint32_t lodCount;
+    float boundsMin[3];
+    float boundsMax[3];
+    float boundingRadius; // Sphere around the origin, used for LOD selection
+    float reserved;
+};
+
+// One cooked level, offsets are relative to the data blob
+struct MeshPackLOD {
+    uint32_t format; // VertexFormat
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t reserved;
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    float baseColor[4];
+};
+
+static_assert(sizeof(MeshPackHeader) == 56, "MeshPackHeader layout is part of the file format");
+static_assert(sizeof(MeshPackMesh) == 72, "MeshPackMesh layout is part of the file format");
+static_assert(sizeof(MeshPackLOD) == 48, "MeshPackLOD layout is part of the file format");
+
+// Offline cooker, optimizes and quantizes meshes the same way MeshArena::upload does and writes a pack
+class MeshPackWriter {
+public:
+    // Level 0 first, later levels are usually built with MeshLOD::buildChain
+    void addMesh(const std::string& name, const std::vector<Mesh3D>& levels);
+
+    bool write(const std::string& path) const;
+
+private:
+    struct Entry {
+        std::string name;
+        std::vector<CookedMesh> levels;
+        glm::vec3 boundsMin{ 0.0f }, boundsMax{ 0.0f };
+        float boundingRadius{ 0.0f };
+    };
+    std::vector<Entry> entries;
+};
+
+// Runtime reader, validates the tables and uploads straight from the mapped pages without copying
+class MeshPack {
+public:
+    bool open(const std::string& path);
+    void close() { file.close(); }
+    bool isOpen() const { return file.isOpen(); }
+
+    // nullptr when the pack has no mesh with that name
+    const MeshPackMesh* findMesh(const std::string& name) const;
+
+    std::shared_ptr<GPUMeshLOD> loadLOD(const std::string& name) const;
+    std::shared_ptr<GPUMesh> loadMesh(const std::string& name, size_t level = 0) const;
+
+private:
+    MappedFile file;
+    const MeshPackHeader* header{ nullptr };
+    const MeshPackMesh* meshes{ nullptr };
+    const MeshPackLOD* lods{ nullptr };
+    const uint8_t* data{ nullptr };
+
+    std::shared_ptr<GPUMesh> uploadLOD(const MeshPackLOD& lod) const;
+};
+
+#endif
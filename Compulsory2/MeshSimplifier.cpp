@@ -0,0 +1,229 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <set>
+
+namespace {
+    // Symmetric 4x4 error quadric, upper triangle only
+    struct Quadric {
+        double a[10]{};
+
+        static Quadric fromPlane(double x, double y, double z, double d, double weight) {
+            Quadric q;
+            q.a[0] = x * x; q.a[1] = x * y; q.a[2] = x * z; q.a[3] = x * d;
+            q.a[4] = y * y; q.a[5] = y * z; q.a[6] = y * d;
+            q.a[7] = z * z; q.a[8] = z * d;
+            q.a[9] = d * d;
+            for (double& value : q.a)
+                value *= weight;
+            return q;
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            for (int i = 0; i < 10; ++i)
+                a[i] += other.a[i];
+            return *this;
+        }
+
+        double error(const glm::vec3& p) const {
+            double x = p.x, y = p.y, z = p.z;
+            return a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x
+                + a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y
+                + a[7] * z * z + 2 * a[8] * z
+                + a[9];
+        }
+    };
+
+    struct Collapse {
+        double cost;
+        unsigned int from, to;
+        glm::vec3 position;
+        unsigned int fromVersion, toVersion;
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+}
+
+Mesh3D MeshSimplifier::simplify(const Mesh3D& source, size_t targetTriangles, float maxError) {
+    // Work on a welded, validated copy so seams do not tear
+    Mesh3D mesh = source;
+    MeshOptimizer::removeInvalidTriangles(mesh);
+    MeshOptimizer::weldVertices(mesh);
+
+    size_t vertexCount = mesh.vertices.size();
+    size_t triangleCount = mesh.indices.size() / 3;
+    if (triangleCount <= targetTriangles)
+        return mesh;
+
+    std::vector<glm::vec3> positions(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        positions[v] = mesh.vertices[v].position;
+
+    std::vector<unsigned int>& indices = mesh.indices;
+    std::vector<bool> triangleAlive(triangleCount, true);
+    std::vector<std::vector<unsigned int>> vertexTriangles(vertexCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k)
+            vertexTriangles[indices[t * 3 + k]].push_back(static_cast<unsigned int>(t));
+    }
+
+    // Face quadrics, weighted by area
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& p0 = positions[indices[t * 3]];
+        glm::vec3 normal = glm::cross(positions[indices[t * 3 + 1]] - p0, positions[indices[t * 3 + 2]] - p0);
+        float area = glm::length(normal);
+        if (area <= 0.0f)
+            continue;
+        normal /= area;
+        Quadric q = Quadric::fromPlane(normal.x, normal.y, normal.z, -glm::dot(normal, p0), area);
+        for (int k = 0; k < 3; ++k)
+            quadrics[indices[t * 3 + k]] += q;
+    }
+
+    // Open borders get a heavily weighted plane perpendicular to the face so the outline is kept
+    std::map<std::pair<unsigned int, unsigned int>, int> edgeUse;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            unsigned int a = indices[t * 3 + k], b = indices[t * 3 + (k + 1) % 3];
+            ++edgeUse[{ std::min(a, b), std::max(a, b) }];
+        }
+    }
+    const double borderWeight = 1000.0;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& p0 = positions[indices[t * 3]];
+        glm::vec3 faceNormal = glm::cross(positions[indices[t * 3 + 1]] - p0, positions[indices[t * 3 + 2]] - p0);
+        for (int k = 0; k < 3; ++k) {
+            unsigned int a = indices[t * 3 + k], b = indices[t * 3 + (k + 1) % 3];
+            if (edgeUse[{ std::min(a, b), std::max(a, b) }] != 1)
+                continue;
+            glm::vec3 edge = positions[b] - positions[a];
+            glm::vec3 normal = glm::cross(edge, faceNormal);
+            float length = glm::length(normal);
+            if (length <= 0.0f)
+                continue;
+            normal /= length;
+            Quadric q = Quadric::fromPlane(normal.x, normal.y, normal.z, -glm::dot(normal, positions[a]), borderWeight * glm::length(edge));
+            quadrics[a] += q;
+            quadrics[b] += q;
+        }
+    }
+
+    std::vector<unsigned int> version(vertexCount, 0);
+    std::vector<bool> vertexAlive(vertexCount, true);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+
+    auto pushCollapse = [&](unsigned int a, unsigned int b) {
+        Quadric q = quadrics[a];
+        q += quadrics[b];
+
+        // Cheapest of the two endpoints and the midpoint, keeps vertices on the original surface
+        glm::vec3 candidates[3] = { positions[b], positions[a], (positions[a] + positions[b]) * 0.5f };
+        Collapse collapse{ 0.0, a, b, positions[b], version[a], version[b] };
+        collapse.cost = q.error(candidates[0]);
+        for (int i = 1; i < 3; ++i) {
+            double cost = q.error(candidates[i]);
+            if (cost < collapse.cost) {
+                collapse.cost = cost;
+                collapse.position = candidates[i];
+            }
+        }
+        queue.push(collapse);
+    };
+
+    for (const auto& edge : edgeUse)
+        pushCollapse(edge.first.first, edge.first.second);
+
+    // Rejects collapses that would flip a surviving triangle
+    auto flipsTriangle = [&](unsigned int from, unsigned int to, const glm::vec3& position) {
+        for (unsigned int t : vertexTriangles[from]) {
+            if (!triangleAlive[t])
+                continue;
+            unsigned int* tri = &indices[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to)
+                continue; // Removed by the collapse
+
+            glm::vec3 before[3], after[3];
+            for (int k = 0; k < 3; ++k) {
+                before[k] = positions[tri[k]];
+                after[k] = tri[k] == from ? position : before[k];
+            }
+            glm::vec3 oldNormal = glm::cross(before[1] - before[0], before[2] - before[0]);
+            glm::vec3 newNormal = glm::cross(after[1] - after[0], after[2] - after[0]);
+            if (glm::dot(oldNormal, newNormal) <= 0.0f)
+                return true;
+        }
+        return false;
+    };
+
+    size_t liveTriangles = triangleCount;
+    while (liveTriangles > targetTriangles && !queue.empty()) {
+        Collapse collapse = queue.top();
+        queue.pop();
+
+        if (collapse.cost > maxError)
+            break;
+
+        unsigned int from = collapse.from, to = collapse.to;
+        if (!vertexAlive[from] || !vertexAlive[to] || version[from] != collapse.fromVersion || version[to] != collapse.toVersion)
+            continue; // Stale entry
+
+        if (flipsTriangle(from, to, collapse.position) || flipsTriangle(to, from, collapse.position))
+            continue;
+
+        // Merge from into to
+        vertexAlive[from] = false;
+        positions[to] = collapse.position;
+        quadrics[to] += quadrics[from];
+        ++version[to];
+
+        for (unsigned int t : vertexTriangles[from]) {
+            if (!triangleAlive[t])
+                continue;
+            unsigned int* tri = &indices[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                triangleAlive[t] = false;
+                --liveTriangles;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                if (tri[k] == from)
+                    tri[k] = to;
+            }
+            vertexTriangles[to].push_back(t);
+        }
+        vertexTriangles[from].clear();
+
+        // Drop dead triangles from the adjacency list and requeue the new edges
+        std::vector<unsigned int>& adjacent = vertexTriangles[to];
+        adjacent.erase(std::remove_if(adjacent.begin(), adjacent.end(), [&](unsigned int t) { return !triangleAlive[t]; }), adjacent.end());
+
+        std::set<unsigned int> neighbours;
+        for (unsigned int t : adjacent) {
+            for (int k = 0; k < 3; ++k) {
+                if (indices[t * 3 + k] != to)
+                    neighbours.insert(indices[t * 3 + k]);
+            }
+        }
+        for (unsigned int neighbour : neighbours)
+            pushCollapse(to, neighbour);
+    }
+
+    // Rebuild the surviving triangles, attributes come from the vertex each slot collapsed into
+    Mesh3D result;
+    std::vector<unsigned int> remap(vertexCount, ~0u);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        if (!triangleAlive[t])
+            continue;
+        for (int k = 0; k < 3; ++k) {
+            unsigned int v = indices[t * 3 + k];
+            if (remap[v] == ~0u) {
+                remap[v] = static_cast<unsigned int>(result.vertices.size());
+                result.addVertex(Vertex3D(positions[v], mesh.vertices[v].color, mesh.vertices[v].normal));
+            }
+            result.addIndex(remap[v]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,13 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include "Mesh.h"
+
+// Quadric error metric edge-collapse simplification (Garland & Heckbert)
+class MeshSimplifier {
+public:
+    // Collapses edges until the mesh has at most targetTriangles or the next collapse would cost more than maxError
+    static Mesh3D simplify(const Mesh3D& mesh, size_t targetTriangles, float maxError = 1e30f);
+};
+
+#endif
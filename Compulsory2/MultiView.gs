@@ -0,0 +1,39 @@
+#version 410 core
+// One invocation per split-screen view, each emits the triangle into its own viewport
+layout (triangles, invocations = 4) in;
+layout (triangle_strip, max_vertices = 3) out;
+
+in vec3 vertexColor[];
+in vec3 vertexNormal[];
+flat in uint vertexHiddenViews[];
+
+// What Triangle.fs reads
+out vec3 ourColor;
+out vec3 worldPosition;
+out vec3 worldNormal;
+out float viewDepth;
+flat out int viewIndex;
+
+uniform mat4 viewMatrices[4];
+uniform mat4 projections[4];
+uniform int viewCount;
+
+void main() {
+    int view = gl_InvocationID;
+    // The mask is per instance, any vertex of the triangle has it
+    if (view >= viewCount || (vertexHiddenViews[0] & (1u << uint(view))) != 0u)
+        return;
+
+    for (int i = 0; i < 3; ++i) {
+        vec4 viewPos = viewMatrices[view] * gl_in[i].gl_Position;
+        ourColor = vertexColor[i];
+        worldPosition = gl_in[i].gl_Position.xyz;
+        worldNormal = vertexNormal[i];
+        viewDepth = -viewPos.z;
+        viewIndex = view;
+        gl_ViewportIndex = view;
+        gl_Position = projections[view] * viewPos;
+        EmitVertex();
+    }
+    EndPrimitive();
+}
@@ -0,0 +1,96 @@
+#ifndef MULTI_VIEW_H
+#define MULTI_VIEW_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+#include "Camera.h"
+#include "Frustum.h"
+
+// One split-screen view: its camera and the rectangle it covers in the target, in pixels from the bottom left
+struct RenderView {
+    Camera camera;
+    int x{ 0 }, y{ 0 }, width{ 0 }, height{ 0 };
+};
+
+// Frustums of every view, tested together so a culling pass visits each object once however many views
+// there are. Results are masks with bit v set when view v can see the object.
+class ViewFrustums {
+public:
+    static const unsigned int MaxViews = 4;
+
+    void clear() { count = 0; }
+    void add(const glm::mat4& viewProjection) {
+        if (count < MaxViews)
+            frustums[count++] = Frustum(viewProjection);
+    }
+
+    unsigned int getCount() const { return count; }
+    unsigned int allViews() const { return (1u << count) - 1u; }
+
+    unsigned int sphereMask(const glm::vec3& center, float radius) const {
+        unsigned int mask = 0;
+        for (unsigned int v = 0; v < count; ++v)
+            mask |= static_cast<unsigned int>(frustums[v].intersectsSphere(center, radius)) << v;
+        return mask;
+    }
+
+    unsigned int boxMask(const glm::vec3& min, const glm::vec3& max) const {
+        unsigned int mask = 0;
+        for (unsigned int v = 0; v < count; ++v)
+            mask |= static_cast<unsigned int>(frustums[v].intersectsBox(min, max)) << v;
+        return mask;
+    }
+
+private:
+    Frustum frustums[MaxViews]{ Frustum(glm::mat4(1.0f)), Frustum(glm::mat4(1.0f)), Frustum(glm::mat4(1.0f)), Frustum(glm::mat4(1.0f)) };
+    unsigned int count{ 0 };
+};
+
+// What one view saw of a multi-view frame
+struct ViewStats {
+    unsigned int instances{ 0 };
+    size_t triangles{ 0 };
+    size_t terrainNodes{ 0 };
+    size_t visibleLights{ 0 };
+};
+
+// Costs of a multi-view frame: the shared part is paid once for all views
+struct MultiViewStats {
+    bool singlePass{ false };         // One submission fanned out to every viewport by the geometry shader
+    unsigned int drawCalls{ 0 };      // Shared
+    unsigned int instances{ 0 };      // Uploaded once, shared by every view
+    size_t cullTests{ 0 };            // Objects tested against all frustums at once
+    float cpuMs{ 0.0f };              // beginFrame to the end of endFrame
+    std::vector<ViewStats> views;     // Empty for single-view frames
+};
+
+// Split-screen rectangles for views.size() players in a width x height target: stacked for two,
+// quadrants for three and four, player one always at the top left
+inline void layoutSplitScreen(std::vector<RenderView>& views, int width, int height) {
+    int halfWidth = width / 2, halfHeight = height / 2;
+    for (size_t i = 0; i < views.size(); ++i) {
+        RenderView& view = views[i];
+        if (views.size() == 1) {
+            view.x = 0;
+            view.y = 0;
+            view.width = width;
+            view.height = height;
+        }
+        else if (views.size() == 2) {
+            view.x = 0;
+            view.y = i == 0 ? height - halfHeight : 0;
+            view.width = width;
+            view.height = i == 0 ? halfHeight : height - halfHeight;
+        }
+        else {
+            bool right = i % 2 == 1, top = i < 2;
+            view.x = right ? halfWidth : 0;
+            view.y = top ? height - halfHeight : 0;
+            view.width = right ? width - halfWidth : halfWidth;
+            view.height = top ? halfHeight : height - halfHeight;
+        }
+    }
+}
+
+#endif
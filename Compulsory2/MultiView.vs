@@ -0,0 +1,22 @@
+#version 330 core
+// Triangle.vs for split-screen: stays in world space, MultiView.gs projects into every view
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec3 aNormal;
+layout (location = 3) in vec4 aInstanceColor;
+layout (location = 4) in mat4 aModel;
+layout (location = 8) in vec2 aPositionXZ;
+layout (location = 9) in float aScale;
+layout (location = 11) in uint aHiddenViews; // Bit per view that culled the instance
+
+out vec3 vertexColor;
+out vec3 vertexNormal;
+flat out uint vertexHiddenViews;
+
+void main() {
+    vertexColor = aColor.rgb * aInstanceColor.rgb;
+    vec4 worldPos = aModel * vec4(aPos * aScale, 1.0) + vec4(aPositionXZ.x, 0.0, aPositionXZ.y, 0.0);
+    vertexNormal = mat3(aModel) * aNormal;
+    vertexHiddenViews = aHiddenViews;
+    gl_Position = worldPos;
+}
@@ -0,0 +1,355 @@
+#include "NullGL.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+bool NullGL::loaded = false;
+
+namespace {
+    enum FunctionIndex {
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) Function##name,
+#include "GLFunctions.inl"
+        FunctionCount
+    };
+
+    const char* const functionNames[FunctionCount] = {
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) "gl" #name,
+#include "GLFunctions.inl"
+    };
+
+    // GL is single threaded, plain counters are enough
+    size_t callCounts[FunctionCount] = {};
+
+    template <typename T> struct NullResult {
+        static T get() { return T(); }
+    };
+    template <> struct NullResult<void> {
+        static void get() {}
+    };
+
+    // Marks the stubs' parameters as used
+    template <typename... Arguments> void ignore(const Arguments&...) {}
+
+    // Default stubs: count and return zero
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) \
+    result APIENTRY stub##name parameters { ignore arguments; ++callCounts[Function##name]; return NullResult<result>::get(); }
+#include "GLFunctions.inl"
+
+    // State behind the stubs that return something
+    GLuint nextName = 1;
+    std::vector<unsigned char> mappedMemory;
+    std::unordered_map<GLuint, std::string> shaderSources;
+    std::unordered_map<GLuint, std::vector<GLuint>> programShaders;
+    std::unordered_map<GLuint, std::vector<std::string>> programUniforms; // Index is the location
+
+    void generateNames(GLsizei count, GLuint* names) {
+        for (GLsizei i = 0; i < count; ++i)
+            names[i] = nextName++;
+    }
+
+    // Default-block uniform declarations of a GLSL source, arrays reported as name[0] like a driver does
+    void collectUniforms(const std::string& source, std::vector<std::string>& uniforms) {
+        size_t position = 0;
+        while ((position = source.find("uniform", position)) != std::string::npos) {
+            bool wordStart = position == 0 || !(std::isalnum(static_cast<unsigned char>(source[position - 1])) || source[position - 1] == '_');
+            position += 7;
+            if (!wordStart || position >= source.size() || !std::isspace(static_cast<unsigned char>(source[position])))
+                continue;
+
+            size_t end = source.find(';', position);
+            if (end == std::string::npos)
+                break;
+            std::string declaration = source.substr(position, end - position);
+            if (declaration.find('{') != std::string::npos)
+                continue; // Uniform block
+
+            // Last identifier before an optional array size or initializer
+            size_t cut = std::min(declaration.find('['), declaration.find('='));
+            bool array = cut != std::string::npos && declaration[cut] == '[';
+            std::string head = declaration.substr(0, cut);
+            size_t last = head.find_last_not_of(" \t\r\n");
+            if (last == std::string::npos)
+                continue;
+            size_t first = last;
+            while (first > 0 && (std::isalnum(static_cast<unsigned char>(head[first - 1])) || head[first - 1] == '_'))
+                --first;
+            std::string name = head.substr(first, last - first + 1);
+            if (array)
+                name += "[0]";
+            if (std::find(uniforms.begin(), uniforms.end(), name) == uniforms.end())
+                uniforms.push_back(name);
+        }
+    }
+
+    const GLubyte* APIENTRY nullGetString(GLenum name) {
+        ++callCounts[FunctionGetString];
+        switch (name) {
+        case GL_VERSION: return reinterpret_cast<const GLubyte*>("3.3.0 NullGL");
+        case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte*>("3.30");
+        case GL_VENDOR:
+        case GL_RENDERER: return reinterpret_cast<const GLubyte*>("NullGL");
+        default: return reinterpret_cast<const GLubyte*>("");
+        }
+    }
+
+    void APIENTRY nullGetIntegerv(GLenum pname, GLint* data) {
+        ++callCounts[FunctionGetIntegerv];
+        switch (pname) {
+        case GL_MAJOR_VERSION:
+        case GL_MINOR_VERSION:
+            data[0] = 3;
+            break;
+        case GL_VIEWPORT:
+        case GL_SCISSOR_BOX:
+            std::fill(data, data + 4, 0);
+            break;
+        default:
+            data[0] = 0;
+            break;
+        }
+    }
+
+    void APIENTRY nullGenBuffers(GLsizei n, GLuint* names) { ++callCounts[FunctionGenBuffers]; generateNames(n, names); }
+    void APIENTRY nullGenVertexArrays(GLsizei n, GLuint* names) { ++callCounts[FunctionGenVertexArrays]; generateNames(n, names); }
+    void APIENTRY nullGenTextures(GLsizei n, GLuint* names) { ++callCounts[FunctionGenTextures]; generateNames(n, names); }
+    void APIENTRY nullGenFramebuffers(GLsizei n, GLuint* names) { ++callCounts[FunctionGenFramebuffers]; generateNames(n, names); }
+    void APIENTRY nullGenRenderbuffers(GLsizei n, GLuint* names) { ++callCounts[FunctionGenRenderbuffers]; generateNames(n, names); }
+    void APIENTRY nullGenQueries(GLsizei n, GLuint* names) { ++callCounts[FunctionGenQueries]; generateNames(n, names); }
+    GLuint APIENTRY nullCreateShader(GLenum) { ++callCounts[FunctionCreateShader]; return nextName++; }
+    GLuint APIENTRY nullCreateProgram() { ++callCounts[FunctionCreateProgram]; return nextName++; }
+
+    void APIENTRY nullShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths) {
+        ++callCounts[FunctionShaderSource];
+        std::string& source = shaderSources[shader];
+        source.clear();
+        for (GLsizei i = 0; i < count; ++i)
+            source.append(strings[i], lengths && lengths[i] >= 0 ? static_cast<size_t>(lengths[i]) : std::strlen(strings[i]));
+    }
+
+    void APIENTRY nullAttachShader(GLuint program, GLuint shader) {
+        ++callCounts[FunctionAttachShader];
+        programShaders[program].push_back(shader);
+    }
+
+    void APIENTRY nullLinkProgram(GLuint program) {
+        ++callCounts[FunctionLinkProgram];
+        std::vector<std::string>& uniforms = programUniforms[program];
+        uniforms.clear();
+        for (GLuint shader : programShaders[program])
+            collectUniforms(shaderSources[shader], uniforms);
+    }
+
+    void APIENTRY nullDeleteShader(GLuint shader) {
+        ++callCounts[FunctionDeleteShader];
+        shaderSources.erase(shader);
+    }
+
+    void APIENTRY nullDeleteProgram(GLuint program) {
+        ++callCounts[FunctionDeleteProgram];
+        programShaders.erase(program);
+        programUniforms.erase(program);
+    }
+
+    void APIENTRY nullGetShaderiv(GLuint, GLenum pname, GLint* params) {
+        ++callCounts[FunctionGetShaderiv];
+        *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+    }
+
+    void APIENTRY nullGetProgramiv(GLuint program, GLenum pname, GLint* params) {
+        ++callCounts[FunctionGetProgramiv];
+        const std::vector<std::string>& uniforms = programUniforms[program];
+        switch (pname) {
+        case GL_LINK_STATUS:
+            *params = GL_TRUE;
+            break;
+        case GL_ACTIVE_UNIFORMS:
+            *params = static_cast<GLint>(uniforms.size());
+            break;
+        case GL_ACTIVE_UNIFORM_MAX_LENGTH: {
+            size_t longest = 0;
+            for (const std::string& uniform : uniforms)
+                longest = std::max(longest, uniform.size() + 1);
+            *params = static_cast<GLint>(longest);
+            break;
+        }
+        default:
+            *params = 0;
+            break;
+        }
+    }
+
+    void APIENTRY nullGetShaderInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+        ++callCounts[FunctionGetShaderInfoLog];
+        if (length)
+            *length = 0;
+        if (bufSize > 0)
+            infoLog[0] = '\0';
+    }
+
+    void APIENTRY nullGetProgramInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+        ++callCounts[FunctionGetProgramInfoLog];
+        if (length)
+            *length = 0;
+        if (bufSize > 0)
+            infoLog[0] = '\0';
+    }
+
+    void APIENTRY nullGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) {
+        ++callCounts[FunctionGetActiveUniform];
+        const std::vector<std::string>& uniforms = programUniforms[program];
+        std::string uniform = index < uniforms.size() ? uniforms[index] : std::string();
+        GLsizei copied = bufSize > 0 ? std::min(static_cast<GLsizei>(uniform.size()), bufSize - 1) : 0;
+        if (bufSize > 0) {
+            std::memcpy(name, uniform.data(), copied);
+            name[copied] = '\0';
+        }
+        if (length)
+            *length = copied;
+        *size = 1;
+        *type = GL_FLOAT;
+    }
+
+    GLint APIENTRY nullGetUniformLocation(GLuint program, const GLchar* name) {
+        ++callCounts[FunctionGetUniformLocation];
+        const std::vector<std::string>& uniforms = programUniforms[program];
+        for (size_t i = 0; i < uniforms.size(); ++i) {
+            if (uniforms[i] == name)
+                return static_cast<GLint>(i);
+        }
+        return -1;
+    }
+
+    void* APIENTRY nullMapBufferRange(GLenum, GLintptr, GLsizeiptr length, GLbitfield) {
+        ++callCounts[FunctionMapBufferRange];
+        // One scratch block serves every mapping, contents are meaningless
+        if (mappedMemory.size() < static_cast<size_t>(length))
+            mappedMemory.resize(length);
+        return mappedMemory.data();
+    }
+
+    GLboolean APIENTRY nullUnmapBuffer(GLenum) {
+        ++callCounts[FunctionUnmapBuffer];
+        return GL_TRUE;
+    }
+
+    GLsync APIENTRY nullFenceSync(GLenum, GLbitfield) {
+        ++callCounts[FunctionFenceSync];
+        static int fence;
+        return reinterpret_cast<GLsync>(&fence);
+    }
+
+    GLenum APIENTRY nullClientWaitSync(GLsync, GLbitfield, GLuint64) {
+        ++callCounts[FunctionClientWaitSync];
+        return GL_ALREADY_SIGNALED;
+    }
+
+    GLenum APIENTRY nullCheckFramebufferStatus(GLenum) {
+        ++callCounts[FunctionCheckFramebufferStatus];
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    void APIENTRY nullGetQueryObjectiv(GLuint, GLenum pname, GLint* params) {
+        ++callCounts[FunctionGetQueryObjectiv];
+        *params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+    }
+
+    void APIENTRY nullGetQueryObjectuiv(GLuint, GLenum pname, GLuint* params) {
+        ++callCounts[FunctionGetQueryObjectuiv];
+        *params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+    }
+
+    void APIENTRY nullGetQueryObjectui64v(GLuint, GLenum, GLuint64* params) {
+        ++callCounts[FunctionGetQueryObjectui64v];
+        *params = 0;
+    }
+
+    void APIENTRY nullGetBufferSubData(GLenum, GLintptr, GLsizeiptr size, void* data) {
+        ++callCounts[FunctionGetBufferSubData];
+        std::memset(data, 0, size);
+    }
+}
+
+bool NullGL::load() {
+#define GL_FUNCTION(pointer, result, name, parameters, arguments) glad_gl##name = &stub##name;
+#include "GLFunctions.inl"
+
+    glad_glGetString = &nullGetString;
+    glad_glGetIntegerv = &nullGetIntegerv;
+    glad_glGenBuffers = &nullGenBuffers;
+    glad_glGenVertexArrays = &nullGenVertexArrays;
+    glad_glGenTextures = &nullGenTextures;
+    glad_glGenFramebuffers = &nullGenFramebuffers;
+    glad_glGenRenderbuffers = &nullGenRenderbuffers;
+    glad_glGenQueries = &nullGenQueries;
+    glad_glCreateShader = &nullCreateShader;
+    glad_glCreateProgram = &nullCreateProgram;
+    glad_glShaderSource = &nullShaderSource;
+    glad_glAttachShader = &nullAttachShader;
+    glad_glLinkProgram = &nullLinkProgram;
+    glad_glDeleteShader = &nullDeleteShader;
+    glad_glDeleteProgram = &nullDeleteProgram;
+    glad_glGetShaderiv = &nullGetShaderiv;
+    glad_glGetProgramiv = &nullGetProgramiv;
+    glad_glGetShaderInfoLog = &nullGetShaderInfoLog;
+    glad_glGetProgramInfoLog = &nullGetProgramInfoLog;
+    glad_glGetActiveUniform = &nullGetActiveUniform;
+    glad_glGetUniformLocation = &nullGetUniformLocation;
+    glad_glMapBufferRange = &nullMapBufferRange;
+    glad_glUnmapBuffer = &nullUnmapBuffer;
+    glad_glFenceSync = &nullFenceSync;
+    glad_glClientWaitSync = &nullClientWaitSync;
+    glad_glCheckFramebufferStatus = &nullCheckFramebufferStatus;
+    glad_glGetQueryObjectiv = &nullGetQueryObjectiv;
+    glad_glGetQueryObjectuiv = &nullGetQueryObjectuiv;
+    glad_glGetQueryObjectui64v = &nullGetQueryObjectui64v;
+    glad_glGetBufferSubData = &nullGetBufferSubData;
+
+    GLVersion.major = 3;
+    GLVersion.minor = 3;
+    loaded = true;
+    std::cout << "NullGL: " << FunctionCount << " entry points stubbed\n";
+    return true;
+}
+
+void NullGL::resetCounters() {
+    std::fill(std::begin(callCounts), std::end(callCounts), 0);
+}
+
+size_t NullGL::getTotalCalls() {
+    size_t total = 0;
+    for (size_t count : callCounts)
+        total += count;
+    return total;
+}
+
+size_t NullGL::getDrawCalls() {
+    size_t total = 0;
+    for (size_t i = 0; i < FunctionCount; ++i) {
+        if (std::strncmp(functionNames[i], "glDraw", 6) == 0 || std::strncmp(functionNames[i], "glMultiDraw", 11) == 0)
+            total += callCounts[i];
+    }
+    return total;
+}
+
+size_t NullGL::getCallCount(const char* name) {
+    for (size_t i = 0; i < FunctionCount; ++i) {
+        if (std::strcmp(functionNames[i], name) == 0)
+            return callCounts[i];
+    }
+    return 0;
+}
+
+std::vector<std::pair<const char*, size_t>> NullGL::getCallCounts() {
+    std::vector<std::pair<const char*, size_t>> counts;
+    for (size_t i = 0; i < FunctionCount; ++i) {
+        if (callCounts[i] > 0)
+            counts.emplace_back(functionNames[i], callCounts[i]);
+    }
+    std::stable_sort(counts.begin(), counts.end(), [](const std::pair<const char*, size_t>& a, const std::pair<const char*, size_t>& b) {
+        return a.second > b.second;
+    });
+    return counts;
+}
@@ -0,0 +1,31 @@
+#ifndef NULL_GL_H
+#define NULL_GL_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// GL backend that does nothing: every glad function pointer is replaced with a stub that only counts its calls,
+// so the real Renderer can run without a GPU or a context and its CPU submission cost is measured alone.
+// Object names, compile and link status, active uniforms (read from the shader sources), mapped buffers and
+// fences get just enough behavior for callers to take the same paths as on a driver.
+class NullGL {
+public:
+    // Points every glad entry point at the stubs, no context needed. There is no way back to a real driver.
+    static bool load();
+    static bool isLoaded() { return loaded; }
+
+    static void resetCounters();
+    static size_t getTotalCalls();
+    // Draw entry points only (glDraw* and glMultiDraw*)
+    static size_t getDrawCalls();
+    static size_t getCallCount(const char* name); // e.g. "glDrawElements"
+    // Entry points called since the last reset, most called first
+    static std::vector<std::pair<const char*, size_t>> getCallCounts();
+
+private:
+    static bool loaded;
+};
+
+#endif
@@ -0,0 +1,13 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec4 particleColor;
+in vec2 corner;
+
+void main() {
+    // Round soft-edged sprite
+    float falloff = 1.0 - dot(corner, corner);
+    if (falloff <= 0.0)
+        discard;
+    FragColor = vec4(particleColor.rgb, particleColor.a * falloff);
+}
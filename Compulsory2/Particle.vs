@@ -0,0 +1,29 @@
+#version 330 core
+// Every attribute is per instance, the quad corner comes from gl_VertexID
+layout (location = 0) in float aX;
+layout (location = 1) in float aY;
+layout (location = 2) in float aZ;
+layout (location = 3) in float aLife;  // Seconds left
+layout (location = 4) in vec4 aColor;
+
+out vec4 particleColor;
+out vec2 corner;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 cameraRight;
+uniform vec3 cameraUp;
+uniform float size;             // Billboard half-width
+uniform float inverseLifetime;  // 1 / effect lifetime
+
+const vec2 corners[4] = vec2[4](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(-1.0, 1.0), vec2(1.0, 1.0));
+
+void main() {
+    corner = corners[gl_VertexID];
+    float fade = clamp(aLife * inverseLifetime, 0.0, 1.0);
+    particleColor = vec4(aColor.rgb, aColor.a * fade);
+
+    // Shrinks to half its size as it fades
+    vec3 offset = (cameraRight * corner.x + cameraUp * corner.y) * size * (0.5 + 0.5 * fade);
+    gl_Position = projection * view * vec4(vec3(aX, aY, aZ) + offset, 1.0);
+}
@@ -0,0 +1,261 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define PARTICLE_SYSTEM_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+    const float GroundHeight = -1.0f; // Top of the level's ground plane
+    const float GroundBounce = 0.4f;  // Fraction of vertical speed kept when hitting the ground
+    const float PI = 3.14159265f;
+
+    enum ParticleAttribute : GLuint {
+        ParticleX = 0,
+        ParticleY = 1,
+        ParticleZ = 2,
+        ParticleLife = 3,
+        ParticleColor = 4
+    };
+}
+
+ParticlePool::ParticlePool(size_t capacity) {
+    // Padded so the vector loop never needs a tail
+    size_t padded = (capacity + 3) & ~size_t(3);
+    x.assign(padded, 0.0f);
+    y.assign(padded, 0.0f);
+    z.assign(padded, 0.0f);
+    vx.assign(padded, 0.0f);
+    vy.assign(padded, 0.0f);
+    vz.assign(padded, 0.0f);
+    life.assign(padded, 0.0f);
+    color.assign(padded, ColorRGBA8{ 0, 0, 0, 0 });
+}
+
+size_t ParticlePool::emit(const glm::vec3& position, const ParticleEffect& effect, size_t requested, std::mt19937& rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    size_t emitted = std::min(requested, capacity() - count);
+    ColorRGBA8 base = packColor(effect.color);
+
+    for (size_t i = count; i < count + emitted; ++i) {
+        // Uniform over the upper hemisphere, speed varies between half and full
+        float up = unit(rng);
+        float angle = unit(rng) * 2.0f * PI;
+        float horizontal = std::sqrt(1.0f - up * up);
+        float speed = effect.speed * (0.5f + 0.5f * unit(rng));
+
+        x[i] = position.x;
+        y[i] = position.y;
+        z[i] = position.z;
+        vx[i] = std::cos(angle) * horizontal * speed;
+        vy[i] = up * speed;
+        vz[i] = std::sin(angle) * horizontal * speed;
+        life[i] = effect.lifetime * (0.5f + 0.5f * unit(rng));
+
+        // Slight brightness variation so bursts do not look flat
+        float shade = 0.75f + 0.25f * unit(rng);
+        color[i] = ColorRGBA8{ static_cast<uint8_t>(base.r * shade), static_cast<uint8_t>(base.g * shade), static_cast<uint8_t>(base.b * shade), 255 };
+    }
+    count += emitted;
+    return emitted;
+}
+
+void ParticlePool::update(float deltaTime, float gravity) {
+    integrate(deltaTime, gravity);
+    removeDead();
+}
+
+void ParticlePool::integrate(float deltaTime, float gravity) {
+    size_t end = (count + 3) & ~size_t(3);
+    size_t i = 0;
+#ifdef PARTICLE_SYSTEM_SSE
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 fall = _mm_set1_ps(gravity * deltaTime);
+    const __m128 bounce = _mm_set1_ps(-GroundBounce);
+    const __m128 ground = _mm_set1_ps(GroundHeight);
+    for (; i < end; i += 4) {
+        __m128 velocityY = _mm_sub_ps(_mm_loadu_ps(&vy[i]), fall);
+        __m128 positionY = _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(velocityY, dt));
+
+        // Below the ground: clamp and reflect with damping
+        __m128 below = _mm_cmplt_ps(positionY, ground);
+        velocityY = _mm_or_ps(_mm_and_ps(below, _mm_mul_ps(velocityY, bounce)), _mm_andnot_ps(below, velocityY));
+        positionY = _mm_max_ps(positionY, ground);
+
+        _mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(_mm_loadu_ps(&vx[i]), dt)));
+        _mm_storeu_ps(&z[i], _mm_add_ps(_mm_loadu_ps(&z[i]), _mm_mul_ps(_mm_loadu_ps(&vz[i]), dt)));
+        _mm_storeu_ps(&y[i], positionY);
+        _mm_storeu_ps(&vy[i], velocityY);
+        _mm_storeu_ps(&life[i], _mm_sub_ps(_mm_loadu_ps(&life[i]), dt));
+    }
+#endif
+    for (; i < end; ++i) {
+        vy[i] -= gravity * deltaTime;
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+        z[i] += vz[i] * deltaTime;
+        if (y[i] < GroundHeight) {
+            y[i] = GroundHeight;
+            vy[i] *= -GroundBounce;
+        }
+        life[i] -= deltaTime;
+    }
+}
+
+void ParticlePool::removeDead() {
+    size_t i = 0;
+    while (i < count) {
+#ifdef PARTICLE_SYSTEM_SSE
+        // Skip four live particles at a time, most of the pool survives a frame
+        if (i + 4 <= count && _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(&life[i]), _mm_setzero_ps())) == 0) {
+            i += 4;
+            continue;
+        }
+#endif
+        if (life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+
+        // Swap-remove; the moved particle is checked on the next pass through i
+        size_t last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        z[i] = z[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        vz[i] = vz[last];
+        life[i] = life[last];
+        color[i] = color[last];
+        life[last] = 0.0f;
+    }
+}
+
+ParticleSystem::ParticleSystem() : rng(std::random_device{}()) {
+    //                                          color                          speed lifetime gravity size  burst capacity
+    effects[static_cast<size_t>(ParticleEffectType::Hit)] = { glm::vec3(1.0f, 0.8f, 0.3f), 6.0f, 0.5f, 9.8f, 0.06f, 24, size_t(1) << 20 };
+    effects[static_cast<size_t>(ParticleEffectType::Death)] = { glm::vec3(1.0f, 0.3f, 0.2f), 8.0f, 1.2f, 9.8f, 0.1f, 200, size_t(1) << 18 };
+    effects[static_cast<size_t>(ParticleEffectType::Pickup)] = { glm::vec3(0.3f, 1.0f, 0.4f), 3.0f, 0.8f, -1.0f, 0.08f, 48, size_t(1) << 16 };
+
+    pools.reserve(EffectCount);
+    for (const ParticleEffect& effect : effects)
+        pools.emplace_back(effect.capacity);
+}
+
+void ParticleSystem::initialize() {
+    program = ShaderProgram(ShaderHelper::createCachedProgram({
+        { GL_VERTEX_SHADER, ShaderHelper::readFile("Particle.vs") },
+        { GL_FRAGMENT_SHADER, ShaderHelper::readFile("Particle.fs") } }));
+    if (!program.isValid()) {
+        std::cerr << "ERROR::SHADER::PROGRAM::CREATION_FAILED (particles)\n";
+        return;
+    }
+    viewLoc = program.getUniformLocation("view");
+    projectionLoc = program.getUniformLocation("projection");
+    cameraRightLoc = program.getUniformLocation("cameraRight");
+    cameraUpLoc = program.getUniformLocation("cameraUp");
+    sizeLoc = program.getUniformLocation("size");
+    inverseLifetimeLoc = program.getUniformLocation("inverseLifetime");
+
+    for (size_t type = 0; type < EffectCount; ++type) {
+        PoolBuffers& poolBuffers = buffers[type];
+        size_t capacity = pools[type].capacity();
+        poolBuffers.bytes = capacity * (4 * sizeof(float) + sizeof(ColorRGBA8));
+
+        glGenVertexArrays(1, &poolBuffers.vao);
+        glGenBuffers(1, &poolBuffers.vbo);
+        glBindVertexArray(poolBuffers.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, poolBuffers.vbo);
+        glBufferData(GL_ARRAY_BUFFER, poolBuffers.bytes, nullptr, GL_STREAM_DRAW);
+
+        // The quad corner comes from gl_VertexID, every attribute is per instance
+        const GLuint floatAttributes[4] = { ParticleX, ParticleY, ParticleZ, ParticleLife };
+        for (GLuint a = 0; a < 4; ++a) {
+            glEnableVertexAttribArray(floatAttributes[a]);
+            glVertexAttribPointer(floatAttributes[a], 1, GL_FLOAT, GL_FALSE, sizeof(float),
+                reinterpret_cast<const void*>(a * capacity * sizeof(float)));
+            glVertexAttribDivisor(floatAttributes[a], 1);
+        }
+        glEnableVertexAttribArray(ParticleColor);
+        glVertexAttribPointer(ParticleColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ColorRGBA8),
+            reinterpret_cast<const void*>(4 * capacity * sizeof(float)));
+        glVertexAttribDivisor(ParticleColor, 1);
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ParticleSystem::cleanup() {
+    for (PoolBuffers& poolBuffers : buffers) {
+        glDeleteVertexArrays(1, &poolBuffers.vao);
+        glDeleteBuffers(1, &poolBuffers.vbo);
+        poolBuffers = PoolBuffers();
+    }
+    program.destroy();
+}
+
+void ParticleSystem::emit(ParticleEffectType type, const glm::vec3& position) {
+    emit(type, position, getEffect(type).burst);
+}
+
+void ParticleSystem::emit(ParticleEffectType type, const glm::vec3& position, size_t count) {
+    getPool(type).emit(position, getEffect(type), count, rng);
+}
+
+void ParticleSystem::Update(float deltaTime) {
+    for (size_t type = 0; type < EffectCount; ++type)
+        pools[type].update(deltaTime, effects[type].gravity);
+}
+
+size_t ParticleSystem::getLiveCount() const {
+    size_t live = 0;
+    for (const ParticlePool& pool : pools)
+        live += pool.size();
+    return live;
+}
+
+void ParticleSystem::draw(const glm::mat4& view, const glm::mat4& projection) {
+    if (!program.isValid() || getLiveCount() == 0)
+        return;
+
+    glUseProgram(program.getId());
+    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, &view[0][0]);
+    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, &projection[0][0]);
+    // Rows of the view rotation are the camera axes in world space
+    glUniform3f(cameraRightLoc, view[0][0], view[1][0], view[2][0]);
+    glUniform3f(cameraUpLoc, view[0][1], view[1][1], view[2][1]);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+
+    for (size_t type = 0; type < EffectCount; ++type) {
+        const ParticlePool& pool = pools[type];
+        size_t count = pool.size();
+        if (count == 0)
+            continue;
+
+        // Orphan, then copy only the live prefix of each array
+        const PoolBuffers& poolBuffers = buffers[type];
+        size_t capacity = pool.capacity();
+        glBindBuffer(GL_ARRAY_BUFFER, poolBuffers.vbo);
+        glBufferData(GL_ARRAY_BUFFER, poolBuffers.bytes, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0 * capacity * sizeof(float), count * sizeof(float), pool.x.data());
+        glBufferSubData(GL_ARRAY_BUFFER, 1 * capacity * sizeof(float), count * sizeof(float), pool.y.data());
+        glBufferSubData(GL_ARRAY_BUFFER, 2 * capacity * sizeof(float), count * sizeof(float), pool.z.data());
+        glBufferSubData(GL_ARRAY_BUFFER, 3 * capacity * sizeof(float), count * sizeof(float), pool.life.data());
+        glBufferSubData(GL_ARRAY_BUFFER, 4 * capacity * sizeof(float), count * sizeof(ColorRGBA8), pool.color.data());
+
+        glUniform1f(sizeLoc, effects[type].size);
+        glUniform1f(inverseLifetimeLoc, 1.0f / effects[type].lifetime);
+        glBindVertexArray(poolBuffers.vao);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(count));
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+}
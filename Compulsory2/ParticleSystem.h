@@ -0,0 +1,97 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <random>
+#include <vector>
+#include "ShaderHelper.h"
+#include "Vertex.h"
+
+// Effects the game can trigger, each has its own pool and one draw
+enum class ParticleEffectType {
+    Hit,    // Combat contact
+    Death,  // Enemy killed
+    Pickup, // Potion collected
+    Count
+};
+
+// Tuning of one effect
+struct ParticleEffect {
+    glm::vec3 color;
+    float speed;      // Initial speed, direction is random over the upper hemisphere
+    float lifetime;   // Seconds, each particle lives between half and all of it
+    float gravity;
+    float size;       // Billboard half-width in world units
+    unsigned int burst;
+    size_t capacity;  // Live particles beyond this are not emitted
+};
+
+// Structure-of-arrays particle storage, allocated once at its full capacity.
+// Update integrates four particles per step and removes dead ones by moving the last particle into their slot.
+class ParticlePool {
+public:
+    explicit ParticlePool(size_t capacity);
+
+    // Returns how many were actually emitted
+    size_t emit(const glm::vec3& position, const ParticleEffect& effect, size_t count, std::mt19937& rng);
+    void update(float deltaTime, float gravity);
+    void clear() { count = 0; }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return x.size(); }
+
+    // Arrays are padded to a multiple of 4, entries at size() and above are dead
+    std::vector<float> x, y, z;
+    std::vector<float> vx, vy, vz;
+    std::vector<float> life;
+    std::vector<ColorRGBA8> color;
+
+private:
+    size_t count{ 0 };
+
+    void integrate(float deltaTime, float gravity);
+    void removeDead();
+};
+
+// Owns one pool per effect and draws each as instanced camera-facing quads straight from the SoA arrays
+class ParticleSystem {
+public:
+    ParticleSystem();
+
+    // Creates the program and buffers, needs a current GL context
+    void initialize();
+    void cleanup();
+
+    void emit(ParticleEffectType type, const glm::vec3& position);
+    void emit(ParticleEffectType type, const glm::vec3& position, size_t count);
+    void Update(float deltaTime);
+    // Additive, depth-tested but not depth-writing, so it goes after the opaque geometry
+    void draw(const glm::mat4& view, const glm::mat4& projection);
+
+    ParticlePool& getPool(ParticleEffectType type) { return pools[static_cast<size_t>(type)]; }
+    const ParticleEffect& getEffect(ParticleEffectType type) const { return effects[static_cast<size_t>(type)]; }
+    size_t getLiveCount() const;
+
+private:
+    // One buffer per pool laid out as [x][y][z][life][color], each array capacity entries long,
+    // so the attribute offsets never change and every frame is five sub-uploads
+    struct PoolBuffers {
+        GLuint vao{ 0 };
+        GLuint vbo{ 0 };
+        size_t bytes{ 0 };
+    };
+
+    static const size_t EffectCount = static_cast<size_t>(ParticleEffectType::Count);
+    std::array<ParticleEffect, EffectCount> effects;
+    std::vector<ParticlePool> pools;
+    std::array<PoolBuffers, EffectCount> buffers;
+    std::mt19937 rng;
+
+    ShaderProgram program;
+    GLint viewLoc{ -1 }, projectionLoc{ -1 }, cameraRightLoc{ -1 }, cameraUpLoc{ -1 };
+    GLint sizeLoc{ -1 }, inverseLifetimeLoc{ -1 };
+};
+
+#endif
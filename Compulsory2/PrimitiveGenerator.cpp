@@ -1,59 +1,31 @@
 #include "PrimitiveGenerator.h"
 #include "corecrt_math_defines.h"
 
+namespace {
+    // Adds a quad with flat normal, corners counter-clockwise seen from the side the normal points to
+    void addQuad(Mesh3D& mesh, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d, const glm::vec3& color) {
+        glm::vec3 normal = glm::normalize(glm::cross(b - a, c - a));
+        unsigned int base = static_cast<unsigned int>(mesh.vertices.size());
+        mesh.addVertex(Vertex3D(a, color, normal));
+        mesh.addVertex(Vertex3D(b, color, normal));
+        mesh.addVertex(Vertex3D(c, color, normal));
+        mesh.addVertex(Vertex3D(d, color, normal));
+        mesh.addIndices({ base, base + 1, base + 2, base + 2, base + 3, base });
+    }
+}
+
 Mesh3D PrimitiveGenerator::createPlane(float width, float depth, const glm::vec3& color) {
     Mesh3D mesh;
     float x = width / 2.0f;
     float z = depth / 2.0f;
 
-    // Vertices
-    std::vector<Vertex3D> vertices = {
-        {{-x, 0.0, -z}, color},
-        {{ x, 0.0, -z}, color},
-        {{ x, 0.0,  z}, color},
-        {{-x, 0.0,  z}, color}
-    };
-
-    // Indices for two triangles that make up the rectangle
-    std::vector<unsigned int> indices = {
-        0, 1, 2,
-        2, 3, 0
-    };
-
-    mesh.addVertices(vertices);
-    mesh.addIndices(indices);
+    // Two triangles facing up
+    addQuad(mesh, { -x, 0.0f, z }, { x, 0.0f, z }, { x, 0.0f, -z }, { -x, 0.0f, -z }, color);
     return mesh;
 }
 
 Mesh3D PrimitiveGenerator::createCube(float sideLength, const glm::vec3& color) {
-    Mesh3D mesh;
-    float halfSide = sideLength / 2.0f;
-
-    // Define vertices
-    std::vector<Vertex3D> vertices = {
-        Vertex3D(glm::vec3(-halfSide, -halfSide, -halfSide), color),
-        Vertex3D(glm::vec3(halfSide, -halfSide, -halfSide), color),
-        Vertex3D(glm::vec3(halfSide, halfSide, -halfSide), color),
-        Vertex3D(glm::vec3(-halfSide, halfSide, -halfSide), color),
-        Vertex3D(glm::vec3(-halfSide, -halfSide, halfSide), color),
-        Vertex3D(glm::vec3(halfSide, -halfSide, halfSide), color),
-        Vertex3D(glm::vec3(halfSide, halfSide, halfSide), color),
-        Vertex3D(glm::vec3(-halfSide, halfSide, halfSide), color)
-    };
-
-    // 12 triangles, two per face
-    std::vector<unsigned int> indices = {
-        0, 1, 2, 2, 3, 0, // Front face
-        1, 5, 6, 6, 2, 1, // Right face
-        7, 6, 5, 5, 4, 7, // Back face
-        4, 0, 3, 3, 7, 4, // Left face
-        4, 5, 1, 1, 0, 4, // Bottom face
-        3, 2, 6, 6, 7, 3  // Top face
-    };
-
-    mesh.addVertices(vertices);
-    mesh.addIndices(indices);
-    return mesh;
+    return createBox(sideLength, sideLength, sideLength, color);
 }
 
 Mesh3D PrimitiveGenerator::createBox(float width, float height, float depth, const glm::vec3& color) {
@@ -63,39 +35,64 @@ Mesh3D PrimitiveGenerator::createBox(float width, float height, float depth, con
     float h = height / 2.0f;
     float d = depth / 2.0f;
 
-    // Define the 8 vertices of the box
-    std::vector<Vertex3D> vertices = {
-        // Front face
-        { glm::vec3(-w, -h,  d), color },
-        { glm::vec3(w, -h,  d), color },
-        { glm::vec3(w,  h,  d), color },
-        { glm::vec3(-w,  h,  d), color },
-        // Back face
-        { glm::vec3(-w, -h, -d), color },
-        { glm::vec3(w, -h, -d), color },
-        { glm::vec3(w,  h, -d), color },
-        { glm::vec3(-w,  h, -d), color },
-    };
+    // Four vertices per face so every face keeps its own flat normal, wound counter-clockwise from outside
+    addQuad(mesh, { -w, -h, d }, { w, -h, d }, { w, h, d }, { -w, h, d }, color);     // Front
+    addQuad(mesh, { w, -h, d }, { w, -h, -d }, { w, h, -d }, { w, h, d }, color);     // Right
+    addQuad(mesh, { w, -h, -d }, { -w, -h, -d }, { -w, h, -d }, { w, h, -d }, color); // Back
+    addQuad(mesh, { -w, -h, -d }, { -w, -h, d }, { -w, h, d }, { -w, h, -d }, color); // Left
+    addQuad(mesh, { -w, -h, -d }, { w, -h, -d }, { w, -h, d }, { -w, -h, d }, color); // Bottom
+    addQuad(mesh, { -w, h, d }, { w, h, d }, { w, h, -d }, { -w, h, -d }, color);     // Top
+
+    return mesh;
+}
+
+Mesh3D PrimitiveGenerator::createRoundedBox(float width, float height, float depth, float radius, int segments, const glm::vec3& color) {
+    if (segments <= 0 || radius <= 0.0f)
+        return createBox(width, height, depth, color);
 
-    // Define indices for the 12 triangles (two per face)
-    std::vector<unsigned int> indices = {
-        // Front face
-        0, 1, 2, 2, 3, 0,
-        // Right face
-        1, 5, 6, 6, 2, 1,
-        // Back face
-        5, 4, 7, 7, 6, 5,
-        // Left face
-        4, 0, 3, 3, 7, 4,
-        // Bottom face
-        4, 5, 1, 1, 0, 4,
-        // Top face
-        3, 2, 6, 6, 7, 3
+    Mesh3D mesh;
+    std::vector<Vertex3D> vertices;
+    std::vector<unsigned int> indices;
+
+    // The bevels wrap an inner box, every face is a grid whose middle row and column are the flat part
+    glm::vec3 inner = glm::max(glm::vec3(width, height, depth) * 0.5f - radius, glm::vec3(0.0f));
+    const glm::vec3 axes[6][3] = {
+        // Normal, u, v with u x v = normal so grid quads wind counter-clockwise from outside
+        { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }, { { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+        { { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 0 } }, { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+        { { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } }, { { 0, 0, -1 }, { 0, 1, 0 }, { 1, 0, 0 } }
     };
+    int samples = 2 * segments + 2;
+
+    for (const auto& face : axes) {
+        const glm::vec3& n = face[0];
+        const glm::vec3& u = face[1];
+        const glm::vec3& v = face[2];
+        unsigned int base = static_cast<unsigned int>(vertices.size());
+
+        for (int i = 0; i < samples; ++i) {
+            // Direction runs -1..0 over the low bevel and 0..1 over the high one, so face edges meet the neighbour's
+            float su = i <= segments ? -1.0f : 1.0f;
+            float tu = i <= segments ? -float(segments - i) / segments : float(i - segments - 1) / segments;
+            for (int j = 0; j < samples; ++j) {
+                float sv = j <= segments ? -1.0f : 1.0f;
+                float tv = j <= segments ? -float(segments - j) / segments : float(j - segments - 1) / segments;
+
+                glm::vec3 normal = glm::normalize(n + tu * u + tv * v);
+                glm::vec3 corner = (n + su * u + sv * v) * inner;
+                vertices.push_back(Vertex3D(corner + normal * radius, color, normal));
+
+                if (i + 1 < samples && j + 1 < samples) {
+                    unsigned int a = base + i * samples + j;
+                    unsigned int b = a + samples;
+                    indices.insert(indices.end(), { a, b, b + 1, b + 1, a + 1, a });
+                }
+            }
+        }
+    }
 
     mesh.addVertices(vertices);
     mesh.addIndices(indices);
-
     return mesh;
 }
 
@@ -104,8 +101,9 @@ Mesh3D PrimitiveGenerator::createCircle(float radius, int segments, const glm::v
     std::vector<Vertex3D> vertices;
     std::vector<unsigned int> indices;
 
-    // Center vertex
-    vertices.push_back(Vertex3D({ 0.0f, 0.0f, 0.0f }, color));
+    // Center vertex, the circle faces +Z
+    const glm::vec3 normal(0.0f, 0.0f, 1.0f);
+    vertices.push_back(Vertex3D({ 0.0f, 0.0f, 0.0f }, color, normal));
 
     // Angle between vertices
     float angle = 2.0f * M_PI / segments;
@@ -113,7 +111,7 @@ Mesh3D PrimitiveGenerator::createCircle(float radius, int segments, const glm::v
     for (int i = 0; i <= segments; i++) {
         float x = radius * cosf(angle * i);
         float y = radius * sinf(angle * i);
-        vertices.push_back(Vertex3D({ x, y, 0.0f }, color));
+        vertices.push_back(Vertex3D({ x, y, 0.0f }, color, normal));
         if (i > 0) {
             indices.push_back(0);
             indices.push_back(i);
@@ -133,26 +131,44 @@ Mesh3D PrimitiveGenerator::createCylinder(float radius, float height, int segmen
 
     float halfHeight = height / 2.0f;
     float angleStep = 2.0f * M_PI / segments;
+    const glm::vec3 up(0.0f, 1.0f, 0.0f);
 
     // Top and bottom center vertices
-    vertices.push_back(Vertex3D({ 0.0f, halfHeight, 0.0f }, color)); // Top center
-    vertices.push_back(Vertex3D({ 0.0f, -halfHeight, 0.0f }, color)); // Bottom center
+    vertices.push_back(Vertex3D({ 0.0f, halfHeight, 0.0f }, color, up)); // Top center
+    vertices.push_back(Vertex3D({ 0.0f, -halfHeight, 0.0f }, color, -up)); // Bottom center
 
+    // Rim vertices are split between side and caps so the edge stays sharp
     for (int i = 0; i <= segments; ++i) {
         float x = radius * cosf(i * angleStep);
         float z = radius * sinf(i * angleStep);
-        vertices.push_back(Vertex3D({ x, halfHeight, z }, color)); // Top rim
-        vertices.push_back(Vertex3D({ x, -halfHeight, z }, color)); // Bottom rim
+        glm::vec3 sideNormal(cosf(i * angleStep), 0.0f, sinf(i * angleStep));
+        vertices.push_back(Vertex3D({ x, halfHeight, z }, color, sideNormal)); // Top rim, side
+        vertices.push_back(Vertex3D({ x, -halfHeight, z }, color, sideNormal)); // Bottom rim, side
+        vertices.push_back(Vertex3D({ x, halfHeight, z }, color, up)); // Top rim, cap
+        vertices.push_back(Vertex3D({ x, -halfHeight, z }, color, -up)); // Bottom rim, cap
 
         if (i > 0) {
-            int base = 2 + 2 * (i - 1);
+            int base = 2 + 4 * (i - 1);
+            int next = base + 4;
+
+            // Side, wound counter-clockwise seen from outside
             indices.push_back(base);
+            indices.push_back(next);
             indices.push_back(base + 1);
-            indices.push_back(base + 2);
 
             indices.push_back(base + 1);
-            indices.push_back(base + 3);
+            indices.push_back(next);
+            indices.push_back(next + 1);
+
+            // Top cap
+            indices.push_back(0);
+            indices.push_back(next + 2);
             indices.push_back(base + 2);
+
+            // Bottom cap
+            indices.push_back(1);
+            indices.push_back(base + 3);
+            indices.push_back(next + 3);
         }
     }
 
@@ -176,7 +192,11 @@ Mesh3D PrimitiveGenerator::createSphere(float radius, int rings, int sectors, co
             float const x = cos(2 * M_PI * s * S) * sin(M_PI * r * R);
             float const z = sin(2 * M_PI * s * S) * sin(M_PI * r * R);
 
-            vertices.push_back(Vertex3D({ x * radius, y * radius, z * radius }, color));
+            vertices.push_back(Vertex3D({ x * radius, y * radius, z * radius }, color, { x, y, z }));
+
+            // The last ring and sector only close the seams, they start no quads
+            if (r == rings - 1 || s == sectors - 1)
+                continue;
 
             int curRow = r * sectors;
             int nextRow = (r + 1) * sectors;
@@ -194,3 +214,24 @@ Mesh3D PrimitiveGenerator::createSphere(float radius, int rings, int sectors, co
     mesh.addIndices(indices);
     return mesh;
 }
+
+std::vector<Mesh3D> PrimitiveGenerator::createCylinderLODs(float radius, float height, int segments, const glm::vec3& color, int levels) {
+    std::vector<Mesh3D> chain;
+    for (int level = 0; level < levels && segments >= 6; ++level) {
+        chain.push_back(createCylinder(radius, height, segments, color));
+        segments /= 2;
+    }
+    return chain;
+}
+
+std::vector<Mesh3D> PrimitiveGenerator::createSphereLODs(float radius, int rings, int sectors, const glm::vec3& color, int levels) {
+    std::vector<Mesh3D> chain;
+    for (int level = 0; level < levels && rings >= 4 && sectors >= 5; ++level) {
+        chain.push_back(createSphere(radius, rings, sectors, color));
+
+        // Keep one extra ring/sector for the seam so every level closes
+        rings = (rings - 1) / 2 + 1;
+        sectors = (sectors - 1) / 2 + 1;
+    }
+    return chain;
+}
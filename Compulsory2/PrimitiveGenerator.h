@@ -3,7 +3,9 @@
 
 #include "Mesh.h"
 #include <glm/glm.hpp>
+#include <vector>
 
+// Every primitive carries normals and winds counter-clockwise seen from outside
 class PrimitiveGenerator {
 public:
     // Generates a plane in the XZ plane
@@ -15,6 +17,9 @@ public:
     // Generates a box
     static Mesh3D createBox(float width, float height, float depth, const glm::vec3& color);
 
+    // Generates a box with edges and corners rounded by radius, segments per quarter bevel (0 gives createBox)
+    static Mesh3D createRoundedBox(float width, float height, float depth, float radius, int segments, const glm::vec3& color);
+
     // Generates a circle in the XY plane
     static Mesh3D createCircle(float radius, int segments, const glm::vec3& color);
 
@@ -23,6 +28,10 @@ public:
 
     // Generates a sphere (optional implementation)
     static Mesh3D createSphere(float radius, int rings, int sectors, const glm::vec3& color);
+
+    // LOD chains, each level halves the tessellation of the previous one
+    static std::vector<Mesh3D> createCylinderLODs(float radius, float height, int segments, const glm::vec3& color, int levels);
+    static std::vector<Mesh3D> createSphereLODs(float radius, int rings, int sectors, const glm::vec3& color, int levels);
 };
 
 #endif
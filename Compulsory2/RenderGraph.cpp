@@ -0,0 +1,454 @@
+#include "RenderGraph.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+
+GLuint RenderGraphContext::getTexture(unsigned int resource) const {
+    int physical = graph.resources[resource].physical;
+    return physical < 0 ? 0 : graph.textures[physical].id;
+}
+
+void RenderGraphContext::blit(unsigned int resource) const {
+    int physical = graph.resources[resource].physical;
+    if (physical < 0)
+        return;
+    const RenderGraph::Texture& texture = graph.textures[physical];
+    const RenderGraph::Pass& target = graph.passes[pass];
+
+    // Only the drawn corner of a dynamically scaled resource holds the image
+    bool dynamic = graph.resources[resource].desc.dynamicScale;
+    unsigned int sourceWidth = graph.scaled(texture.desc.width, dynamic), sourceHeight = graph.scaled(texture.desc.height, dynamic);
+    unsigned int targetWidth = getWidth(), targetHeight = getHeight();
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, graph.blitFramebuffer);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.id, 0);
+    glBlitFramebuffer(0, 0, sourceWidth, sourceHeight, 0, 0, targetWidth, targetHeight,
+        GL_COLOR_BUFFER_BIT, sourceWidth == targetWidth && sourceHeight == targetHeight ? GL_NEAREST : GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+}
+
+unsigned int RenderGraphContext::getWidth() const {
+    const RenderGraph::Pass& target = graph.passes[pass];
+    return graph.scaled(target.width, target.dynamicScale);
+}
+
+unsigned int RenderGraphContext::getHeight() const {
+    const RenderGraph::Pass& target = graph.passes[pass];
+    return graph.scaled(target.height, target.dynamicScale);
+}
+
+unsigned int RenderGraph::createTexture(const std::string& name, const RenderTextureDesc& desc) {
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    resources.push_back(resource);
+    compiled = false;
+    return static_cast<unsigned int>(resources.size() - 1);
+}
+
+unsigned int RenderGraph::importBackbuffer(const std::string& name) {
+    Resource resource;
+    resource.name = name;
+    resource.imported = true;
+    resources.push_back(resource);
+    compiled = false;
+    return static_cast<unsigned int>(resources.size() - 1);
+}
+
+void RenderGraph::addPass(const std::string& name, const std::vector<unsigned int>& reads, const std::vector<unsigned int>& writes,
+    Execute execute, bool sideEffects) {
+    Pass pass;
+    pass.name = name;
+    pass.reads = reads;
+    pass.writes = writes;
+    pass.execute = std::move(execute);
+    pass.sideEffects = sideEffects;
+    passes.push_back(std::move(pass));
+    compiled = false;
+}
+
+void RenderGraph::resize(unsigned int width, unsigned int height) {
+    if (width == backbufferWidth && height == backbufferHeight)
+        return;
+    backbufferWidth = width;
+    backbufferHeight = height;
+    if (compiled)
+        compile();
+}
+
+void RenderGraph::setRenderScale(float scale) {
+    renderScale = std::min(std::max(scale, 0.01f), 1.0f);
+}
+
+void RenderGraph::release() {
+    for (Texture& texture : textures)
+        glDeleteTextures(1, &texture.id);
+    textures.clear();
+    for (Pass& pass : passes) {
+        if (pass.framebuffer)
+            glDeleteFramebuffers(1, &pass.framebuffer);
+        pass.framebuffer = 0;
+    }
+    if (blitFramebuffer)
+        glDeleteFramebuffers(1, &blitFramebuffer);
+    blitFramebuffer = 0;
+    compiled = false;
+}
+
+namespace {
+    bool contains(const std::vector<unsigned int>& list, unsigned int value) {
+        return std::find(list.begin(), list.end(), value) != list.end();
+    }
+}
+
+bool RenderGraph::compile() {
+    release();
+    if (backbufferWidth == 0 || backbufferHeight == 0) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        backbufferWidth = viewport[2];
+        backbufferHeight = viewport[3];
+    }
+
+    // Writers of each resource in declaration order
+    std::vector<std::vector<size_t>> writers(resources.size());
+    for (size_t p = 0; p < passes.size(); ++p) {
+        for (unsigned int r : passes[p].writes)
+            writers[r].push_back(p);
+    }
+
+    // Cull: start from passes with visible results and keep whatever produced their inputs.
+    // A pass that reads and writes the same resource only needs the writers declared before it.
+    std::vector<size_t> pending;
+    for (size_t p = 0; p < passes.size(); ++p) {
+        Pass& pass = passes[p];
+        pass.culled = true;
+        bool visible = pass.sideEffects;
+        for (unsigned int r : pass.writes)
+            visible |= resources[r].imported;
+        if (visible) {
+            pass.culled = false;
+            pending.push_back(p);
+        }
+    }
+    while (!pending.empty()) {
+        size_t p = pending.back();
+        pending.pop_back();
+        for (unsigned int r : passes[p].reads) {
+            bool modifies = contains(passes[p].writes, r);
+            for (size_t writer : writers[r]) {
+                if (modifies && writer >= p)
+                    break;
+                if (passes[writer].culled) {
+                    passes[writer].culled = false;
+                    pending.push_back(writer);
+                }
+            }
+        }
+    }
+
+    if (!sortPasses())
+        return false;
+
+    // Lifetimes in execution order
+    for (Resource& resource : resources) {
+        resource.firstUse = SIZE_MAX;
+        resource.lastUse = 0;
+        resource.physical = -1;
+    }
+    for (size_t position = 0; position < order.size(); ++position) {
+        const Pass& pass = passes[order[position]];
+        for (const std::vector<unsigned int>* list : { &pass.reads, &pass.writes }) {
+            for (unsigned int r : *list) {
+                resources[r].firstUse = std::min(resources[r].firstUse, position);
+                resources[r].lastUse = std::max(resources[r].lastUse, position);
+            }
+        }
+    }
+
+    assignTextures();
+    createFramebuffers();
+    compiled = true;
+    return true;
+}
+
+bool RenderGraph::sortPasses() {
+    // Edges: writers of a resource run in declaration order, plain readers after every writer,
+    // read-modify-write passes after the writers declared before them
+    std::vector<std::vector<size_t>> next(passes.size());
+    std::vector<size_t> incoming(passes.size(), 0);
+    auto addEdge = [&](size_t from, size_t to) {
+        if (from == to || passes[from].culled || passes[to].culled)
+            return;
+        if (std::find(next[from].begin(), next[from].end(), to) != next[from].end())
+            return;
+        next[from].push_back(to);
+        ++incoming[to];
+    };
+
+    for (size_t r = 0; r < resources.size(); ++r) {
+        std::vector<size_t> resourceWriters;
+        for (size_t p = 0; p < passes.size(); ++p) {
+            if (!passes[p].culled && contains(passes[p].writes, static_cast<unsigned int>(r)))
+                resourceWriters.push_back(p);
+        }
+        for (size_t i = 1; i < resourceWriters.size(); ++i)
+            addEdge(resourceWriters[i - 1], resourceWriters[i]);
+
+        for (size_t p = 0; p < passes.size(); ++p) {
+            if (passes[p].culled || !contains(passes[p].reads, static_cast<unsigned int>(r)))
+                continue;
+            bool modifies = contains(passes[p].writes, static_cast<unsigned int>(r));
+            for (size_t writer : resourceWriters) {
+                if (modifies && writer >= p)
+                    break;
+                addEdge(writer, p);
+            }
+        }
+    }
+
+    // Kahn's algorithm, ties go to the pass declared first so the order stays predictable
+    order.clear();
+    std::vector<size_t> ready;
+    size_t alive = 0;
+    for (size_t p = 0; p < passes.size(); ++p) {
+        if (passes[p].culled)
+            continue;
+        ++alive;
+        if (incoming[p] == 0)
+            ready.push_back(p);
+    }
+    while (!ready.empty()) {
+        auto first = std::min_element(ready.begin(), ready.end());
+        size_t p = *first;
+        ready.erase(first);
+        order.push_back(p);
+        for (size_t to : next[p]) {
+            if (--incoming[to] == 0)
+                ready.push_back(to);
+        }
+    }
+
+    if (order.size() != alive) {
+        std::cerr << "RenderGraph: dependency cycle, graph not compiled\n";
+        order.clear();
+        return false;
+    }
+    return true;
+}
+
+RenderTextureDesc RenderGraph::resolve(const RenderTextureDesc& desc) const {
+    RenderTextureDesc resolved = desc;
+    if (resolved.width == 0)
+        resolved.width = backbufferWidth;
+    if (resolved.height == 0)
+        resolved.height = backbufferHeight;
+    return resolved;
+}
+
+unsigned int RenderGraph::scaled(unsigned int size, bool dynamic) const {
+    if (!dynamic || renderScale >= 1.0f)
+        return size;
+    return std::max(1u, static_cast<unsigned int>(size * renderScale + 0.5f));
+}
+
+void RenderGraph::assignTextures() {
+    // Greedy interval assignment: the earliest starting resource takes the first matching texture that is free again
+    std::vector<unsigned int> transient;
+    for (unsigned int r = 0; r < resources.size(); ++r) {
+        if (!resources[r].imported && resources[r].firstUse != SIZE_MAX)
+            transient.push_back(r);
+    }
+    std::stable_sort(transient.begin(), transient.end(), [&](unsigned int a, unsigned int b) {
+        return resources[a].firstUse < resources[b].firstUse;
+    });
+
+    requestedBytes = 0;
+    allocatedBytes = 0;
+    for (unsigned int r : transient) {
+        Resource& resource = resources[r];
+        RenderTextureDesc desc = resolve(resource.desc);
+        size_t bytes = static_cast<size_t>(desc.width) * desc.height * bytesPerPixel(desc.internalFormat);
+        requestedBytes += bytes;
+
+        for (size_t t = 0; t < textures.size(); ++t) {
+            const Texture& texture = textures[t];
+            if (texture.busyUntil < resource.firstUse && texture.desc.internalFormat == desc.internalFormat &&
+                texture.desc.width == desc.width && texture.desc.height == desc.height) {
+                resource.physical = static_cast<int>(t);
+                break;
+            }
+        }
+        if (resource.physical < 0) {
+            Texture texture;
+            texture.desc = desc;
+            textures.push_back(texture);
+            resource.physical = static_cast<int>(textures.size() - 1);
+            allocatedBytes += bytes;
+        }
+        textures[resource.physical].busyUntil = resource.lastUse;
+    }
+
+    for (Texture& texture : textures) {
+        glGenTextures(1, &texture.id);
+        glBindTexture(GL_TEXTURE_2D, texture.id);
+        GLenum format = GL_RGBA, type = GL_UNSIGNED_BYTE;
+        if (texture.desc.internalFormat == GL_DEPTH24_STENCIL8) {
+            format = GL_DEPTH_STENCIL;
+            type = GL_UNSIGNED_INT_24_8;
+        }
+        else if (isDepthFormat(texture.desc.internalFormat)) {
+            format = GL_DEPTH_COMPONENT;
+            type = GL_FLOAT;
+        }
+        glTexImage2D(GL_TEXTURE_2D, 0, texture.desc.internalFormat, texture.desc.width, texture.desc.height, 0, format, type, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void RenderGraph::createFramebuffers() {
+    glGenFramebuffers(1, &blitFramebuffer);
+
+    for (size_t p : order) {
+        Pass& pass = passes[p];
+        pass.width = backbufferWidth;
+        pass.height = backbufferHeight;
+        pass.dynamicScale = false;
+
+        bool writesBackbuffer = false;
+        for (unsigned int r : pass.writes)
+            writesBackbuffer |= resources[r].imported;
+        if (writesBackbuffer || pass.writes.empty())
+            continue; // Draws into framebuffer 0
+
+        glGenFramebuffers(1, &pass.framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+        std::vector<GLenum> drawBuffers;
+        for (unsigned int r : pass.writes) {
+            const Texture& texture = textures[resources[r].physical];
+            pass.width = texture.desc.width;
+            pass.height = texture.desc.height;
+            pass.dynamicScale |= resources[r].desc.dynamicScale;
+
+            GLenum attachment = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(drawBuffers.size());
+            if (texture.desc.internalFormat == GL_DEPTH24_STENCIL8)
+                attachment = GL_DEPTH_STENCIL_ATTACHMENT;
+            else if (isDepthFormat(texture.desc.internalFormat))
+                attachment = GL_DEPTH_ATTACHMENT;
+            else
+                drawBuffers.push_back(attachment);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture.id, 0);
+        }
+        if (drawBuffers.empty())
+            glDrawBuffer(GL_NONE);
+        else
+            glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            std::cerr << "RenderGraph: framebuffer of pass '" << pass.name << "' is incomplete\n";
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void RenderGraph::execute() {
+    if (!compiled && !compile())
+        return;
+
+    for (size_t p : order) {
+        const Pass& pass = passes[p];
+        RenderGraphContext context(*this, p);
+        glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+        glViewport(0, 0, context.getWidth(), context.getHeight());
+        // Clears stay inside the scaled region too
+        if (pass.dynamicScale) {
+            glScissor(0, 0, context.getWidth(), context.getHeight());
+            glEnable(GL_SCISSOR_TEST);
+        }
+        pass.execute(context);
+        if (pass.dynamicScale)
+            glDisable(GL_SCISSOR_TEST);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+size_t RenderGraph::bytesPerPixel(GLenum internalFormat) {
+    switch (internalFormat) {
+    case GL_R8: return 1;
+    case GL_RG8: case GL_R16F: return 2;
+    case GL_RGBA16F: case GL_RG32F: return 8;
+    case GL_RGBA32F: return 16;
+    default: return 4; // RGBA8, R11F_G11F_B10F, R32F, RG16F and the depth formats
+    }
+}
+
+bool RenderGraph::isDepthFormat(GLenum internalFormat) {
+    return internalFormat == GL_DEPTH_COMPONENT16 || internalFormat == GL_DEPTH_COMPONENT24 ||
+        internalFormat == GL_DEPTH_COMPONENT32F || internalFormat == GL_DEPTH24_STENCIL8;
+}
+
+namespace {
+    const char* formatName(GLenum internalFormat) {
+        switch (internalFormat) {
+        case GL_RGBA8: return "RGBA8";
+        case GL_RGBA16F: return "RGBA16F";
+        case GL_RGBA32F: return "RGBA32F";
+        case GL_R11F_G11F_B10F: return "R11G11B10F";
+        case GL_R8: return "R8";
+        case GL_R32F: return "R32F";
+        case GL_DEPTH_COMPONENT24: return "D24";
+        case GL_DEPTH_COMPONENT32F: return "D32F";
+        case GL_DEPTH24_STENCIL8: return "D24S8";
+        default: return "other";
+        }
+    }
+
+    void appendNames(std::ostringstream& out, const char* label, const std::vector<unsigned int>& list, const std::vector<std::string>& names) {
+        if (list.empty())
+            return;
+        out << " " << label;
+        for (size_t i = 0; i < list.size(); ++i)
+            out << (i ? ", " : " ") << names[list[i]];
+    }
+}
+
+std::string RenderGraph::dump() const {
+    std::vector<std::string> names;
+    for (const Resource& resource : resources)
+        names.push_back(resource.name);
+
+    std::ostringstream out;
+    out << "Render graph: " << order.size() << " of " << passes.size() << " passes live\n";
+    for (size_t position = 0; position < order.size(); ++position) {
+        const Pass& pass = passes[order[position]];
+        out << "  " << position << " " << pass.name;
+        appendNames(out, "reads", pass.reads, names);
+        appendNames(out, "writes", pass.writes, names);
+        out << "\n";
+    }
+    for (const Pass& pass : passes) {
+        if (pass.culled)
+            out << "  culled " << pass.name << "\n";
+    }
+
+    out << "Resources:\n";
+    for (const Resource& resource : resources) {
+        out << "  " << resource.name;
+        if (resource.imported)
+            out << " imported\n";
+        else if (resource.physical < 0)
+            out << " unused\n";
+        else {
+            RenderTextureDesc desc = resolve(resource.desc);
+            out << " " << formatName(desc.internalFormat) << " " << desc.width << "x" << desc.height << (desc.dynamicScale ? " dynamic" : "")
+                << " passes " << resource.firstUse << "-" << resource.lastUse << " texture #" << resource.physical << "\n";
+        }
+    }
+    out << "Transient memory: " << requestedBytes / 1024 << " KB requested, " << allocatedBytes / 1024
+        << " KB allocated, " << (requestedBytes - allocatedBytes) / 1024 << " KB saved by aliasing\n";
+    return out.str();
+}
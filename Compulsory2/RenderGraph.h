@@ -0,0 +1,118 @@
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include <glad/glad.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Size and format of a transient render target, 0 width/height follows the backbuffer
+struct RenderTextureDesc {
+    GLenum internalFormat{ GL_RGBA8 };
+    unsigned int width{ 0 };
+    unsigned int height{ 0 };
+    bool dynamicScale{ false }; // Drawn at the graph's render scale inside the full-size texture, so scaling never reallocates
+};
+
+class RenderGraph;
+
+// Handed to a pass while it runs, its targets are already bound
+class RenderGraphContext {
+public:
+    RenderGraphContext(const RenderGraph& graph, size_t pass) : graph(graph), pass(pass) {}
+
+    // GL texture behind a resource the pass declared as a read
+    GLuint getTexture(unsigned int resource) const;
+    // Copies a color resource into the pass's target, scaling to fit
+    void blit(unsigned int resource) const;
+
+    // Viewport of the pass, smaller than its targets when it writes dynamically scaled resources
+    unsigned int getWidth() const;
+    unsigned int getHeight() const;
+
+private:
+    const RenderGraph& graph;
+    size_t pass;
+};
+
+// Frame described as passes that declare what they read and write.
+// compile() drops passes whose output nobody consumes, orders the rest by their dependencies and lets
+// transient targets with disjoint lifetimes share one texture. Build once, compile, then execute every frame;
+// compile again after adding passes, resize() reallocates on its own.
+class RenderGraph {
+public:
+    using Execute = std::function<void(const RenderGraphContext&)>;
+
+    // Resources are identified by the returned index
+    unsigned int createTexture(const std::string& name, const RenderTextureDesc& desc);
+    // The default framebuffer, writing it keeps a pass alive
+    unsigned int importBackbuffer(const std::string& name);
+
+    // sideEffects keeps the pass even if nothing reads its outputs
+    void addPass(const std::string& name, const std::vector<unsigned int>& reads, const std::vector<unsigned int>& writes,
+        Execute execute, bool sideEffects = false);
+
+    bool compile();
+    void execute();
+    void resize(unsigned int width, unsigned int height);
+    // Fraction of the full size dynamically scaled resources are drawn at, in (0, 1]. Takes effect immediately.
+    void setRenderScale(float scale);
+    float getRenderScale() const { return renderScale; }
+    // Releases every GL object, the description stays. Not done on destruction, call it while the context is current.
+    void release();
+
+    // Pass order, culled passes, lifetimes and which texture each resource landed in
+    std::string dump() const;
+
+    size_t getRequestedBytes() const { return requestedBytes; }
+    size_t getAllocatedBytes() const { return allocatedBytes; }
+
+private:
+    friend class RenderGraphContext;
+
+    struct Resource {
+        std::string name;
+        RenderTextureDesc desc;
+        bool imported{ false };
+        size_t firstUse{ 0 }, lastUse{ 0 }; // Positions in the compiled order
+        int physical{ -1 };                 // Index into textures, -1 for imported or unused
+    };
+
+    struct Pass {
+        std::string name;
+        std::vector<unsigned int> reads, writes;
+        Execute execute;
+        bool sideEffects{ false };
+        bool culled{ false };
+        GLuint framebuffer{ 0 };            // 0 when the pass writes the backbuffer
+        unsigned int width{ 0 }, height{ 0 };
+        bool dynamicScale{ false };         // Writes a dynamically scaled resource
+    };
+
+    struct Texture {
+        GLuint id{ 0 };
+        RenderTextureDesc desc;             // Resolved size
+        size_t busyUntil{ 0 };              // Last compiled position using it
+    };
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<size_t> order;              // Live passes in execution order
+    std::vector<Texture> textures;
+    GLuint blitFramebuffer{ 0 };
+    unsigned int backbufferWidth{ 0 }, backbufferHeight{ 0 };
+    float renderScale{ 1.0f };
+    size_t requestedBytes{ 0 }, allocatedBytes{ 0 };
+    bool compiled{ false };
+
+    bool sortPasses();
+    void assignTextures();
+    void createFramebuffers();
+    RenderTextureDesc resolve(const RenderTextureDesc& desc) const;
+    // Full size reduced by the render scale when dynamic is set
+    unsigned int scaled(unsigned int size, bool dynamic) const;
+    static size_t bytesPerPixel(GLenum internalFormat);
+    static bool isDepthFormat(GLenum internalFormat);
+};
+
+#endif
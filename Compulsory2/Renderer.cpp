@@ -1,24 +1,62 @@
 #include "Renderer.h"
 
+namespace {
+    float projectedSizeFrom(const glm::vec3& center, float radius, const glm::vec3& eye, float projectionScale) {
+        float distance = glm::length(center - eye);
+        if (distance <= radius)
+            return 1.0f;
+        return radius * projectionScale / distance;
+    }
+}
+
 void Renderer::initializeShaders() {
     std::string vertexShaderSource = ShaderHelper::readShader(VertexSource);
     std::string fragmentShaderSource = ShaderHelper::readShader(FragmentSource);
 
-    // Debug: Print the shader source
-    std::cout << "Vertex Shader Source:\n" << vertexShaderSource << std::endl;
-    std::cout << "Fragment Shader Source:\n" << fragmentShaderSource << std::endl;
+    // Linked binaries are reused across launches, sources are only compiled when they or the driver change
+    shaderProgram = ShaderProgram(ShaderHelper::createCachedProgram({
+        { GL_VERTEX_SHADER, vertexShaderSource },
+        { GL_FRAGMENT_SHADER, fragmentShaderSource } }));
 
-    shaderProgram = ShaderHelper::createProgram(vertexShaderSource.c_str(), fragmentShaderSource.c_str());
-
-    if (shaderProgram == 0) {
+    if (!shaderProgram.isValid()) {
         std::cerr << "ERROR::SHADER::PROGRAM::CREATION_FAILED\n";
         return;  // Exit the function if the shader program failed to create
     }
 
     // Get uniform locations
-    viewLoc = glGetUniformLocation(shaderProgram, "view");
-    projLoc = glGetUniformLocation(shaderProgram, "projection");
-    modelLoc = glGetUniformLocation(shaderProgram, "model");
+    viewLoc = shaderProgram.getUniformLocation("view");
+    projLoc = shaderProgram.getUniformLocation("projection");
+
+    // Optional, -1 when the shader does not use them
+    lightPosLoc = shaderProgram.getUniformLocation("lightPos");
+    viewPosLoc = shaderProgram.getUniformLocation("viewPos");
+    lightColorLoc = shaderProgram.getUniformLocation("lightColor");
+    clusterDepthLoc = shaderProgram.getUniformLocation("clusterDepth");
+    viewportsLoc = shaderProgram.getUniformLocation("viewports");
+    currentViewLoc = shaderProgram.getUniformLocation("currentView");
+
+    setupLightingSamplers(shaderProgram);
+
+    // Terrain shares the lighting, only vertex placement differs
+    terrainProgram = ShaderProgram(ShaderHelper::createCachedProgram({
+        { GL_VERTEX_SHADER, ShaderHelper::readFile("Terrain.vs") },
+        { GL_FRAGMENT_SHADER, fragmentShaderSource } }));
+    if (terrainProgram.isValid())
+        setupLightingSamplers(terrainProgram);
+    else
+        std::cerr << "Terrain shader unavailable, terrain will not be drawn\n";
+
+    // Split-screen in one pass, only where the geometry shader can pick the viewport
+    if (GLExtensions::viewportArray) {
+        multiViewProgram = ShaderProgram(ShaderHelper::createCachedProgram({
+            { GL_VERTEX_SHADER, ShaderHelper::readFile("MultiView.vs") },
+            { GL_GEOMETRY_SHADER, ShaderHelper::readFile("MultiView.gs") },
+            { GL_FRAGMENT_SHADER, fragmentShaderSource } }));
+        if (multiViewProgram.isValid())
+            setupLightingSamplers(multiViewProgram);
+        else
+            std::cerr << "Multi-view shader unavailable, split-screen views are drawn one at a time\n";
+    }
 
     // Check if uniform locations are valid
     if (viewLoc == -1) {
@@ -27,38 +65,690 @@ void Renderer::initializeShaders() {
     if (projLoc == -1) {
         std::cerr << "Error: 'projection' uniform location not found in shader program.\n";
     }
-    if (modelLoc == -1) {
-        std::cerr << "Error: 'model' uniform location not found in shader program.\n";
+
+    glGenBuffers(1, &instanceVBO);
+    glGenBuffers(1, &positionVBO);
+    glGenBuffers(1, &styleVBO);
+    glGenBuffers(1, &hiddenViewsVBO);
+    glGenBuffers(1, &positionHiddenViewsVBO);
+    lighting.initialize();
+}
+
+void Renderer::beginFrame(const Camera& camera) {
+    viewStates.clear();
+    glUseProgram(shaderProgram.getId());
+    updateUniforms(camera);
+    if (lightPosLoc != -1)
+        glUniform3fv(lightPosLoc, 1, glm::value_ptr(lightPos));
+    if (viewPosLoc != -1)
+        glUniform3fv(viewPosLoc, 1, glm::value_ptr(camera.position));
+    if (lightColorLoc != -1)
+        glUniform3fv(lightColorLoc, 1, glm::value_ptr(lightColor));
+
+    cameraPosition = camera.position;
+    projectionScale = 1.0f / tanf(glm::radians(camera.FoV) * 0.5f);
+    frustums.clear();
+    frustums.add(getViewProjection());
+
+    stats.drawCalls = 0;
+    stats.instances = 0;
+    stats.triangles = 0;
+    std::fill(stats.instancesPerLOD.begin(), stats.instancesPerLOD.end(), 0u);
+    stats.multiView = MultiViewStats();
+}
+
+void Renderer::beginFrame(const std::vector<RenderView>& views) {
+    if (views.size() <= 1) {
+        if (!views.empty()) {
+            glViewport(views[0].x, views[0].y, views[0].width, views[0].height);
+            setAspect(views[0].width, views[0].height);
+            beginFrame(views[0].camera);
+            if (viewportsLoc != -1)
+                glUniform4f(viewportsLoc, static_cast<float>(views[0].x), static_cast<float>(views[0].y), SCR_WIDTH, SCR_HEIGHT);
+        }
+        return;
     }
+
+    frameStart = std::chrono::steady_clock::now();
+    size_t count = std::min<size_t>(views.size(), ViewFrustums::MaxViews);
+    viewStates.resize(count);
+    frustums.clear();
+    glm::mat4 viewMatrices[ViewFrustums::MaxViews], projections[ViewFrustums::MaxViews];
+    for (size_t v = 0; v < count; ++v) {
+        const RenderView& view = views[v];
+        const Camera& camera = view.camera;
+        ViewState& state = viewStates[v];
+        float aspect = static_cast<float>(view.width) / static_cast<float>(std::max(view.height, 1));
+        state.view = glm::lookAt(camera.position, camera.position + camera.front, camera.up);
+        state.projection = glm::perspective(glm::radians(camera.FoV), aspect, camera.nearClip, camera.farClip);
+        state.position = camera.position;
+        state.projectionScale = 1.0f / tanf(glm::radians(camera.FoV) * 0.5f);
+        state.nearClip = camera.nearClip;
+        state.farClip = camera.farClip;
+        state.viewport = glm::vec4(view.x, view.y, view.width, view.height);
+        frustums.add(state.projection * state.view);
+        viewMatrices[v] = state.view;
+        projections[v] = state.projection;
+    }
+
+    // View 0 stands in wherever a single camera is expected
+    viewMatrix = viewStates[0].view;
+    projectionMatrix = viewStates[0].projection;
+    cameraPosition = viewStates[0].position;
+    projectionScale = viewStates[0].projectionScale;
+    nearClip = viewStates[0].nearClip;
+    farClip = viewStates[0].farClip;
+
+    singlePass = singlePassViews && multiViewProgram.isValid();
+    if (singlePass) {
+        glUseProgram(multiViewProgram.getId());
+        glUniformMatrix4fv(multiViewProgram.getUniformLocation("viewMatrices"), static_cast<GLsizei>(count), GL_FALSE, glm::value_ptr(viewMatrices[0]));
+        glUniformMatrix4fv(multiViewProgram.getUniformLocation("projections"), static_cast<GLsizei>(count), GL_FALSE, glm::value_ptr(projections[0]));
+        glUniform1i(multiViewProgram.getUniformLocation("viewCount"), static_cast<GLint>(count));
+        glUniform3fv(multiViewProgram.getUniformLocation("lightPos"), 1, glm::value_ptr(lightPos));
+        glUniform3fv(multiViewProgram.getUniformLocation("lightColor"), 1, glm::value_ptr(lightColor));
+        setViewArrays(multiViewProgram);
+    }
+    // Per-view passes: terrain always, everything else without viewport arrays
+    glUseProgram(shaderProgram.getId());
+    if (lightPosLoc != -1)
+        glUniform3fv(lightPosLoc, 1, glm::value_ptr(lightPos));
+    if (lightColorLoc != -1)
+        glUniform3fv(lightColorLoc, 1, glm::value_ptr(lightColor));
+    setViewArrays(shaderProgram);
+    lighting.bind(LightTextureUnit);
+    // Instances drawn without the hidden view stream are visible everywhere
+    glVertexAttribI4ui(HiddenViewsLocation, 0, 0, 0, 0);
+
+    stats.drawCalls = 0;
+    stats.instances = 0;
+    stats.triangles = 0;
+    std::fill(stats.instancesPerLOD.begin(), stats.instancesPerLOD.end(), 0u);
+    stats.multiView.singlePass = singlePass;
+    stats.multiView.drawCalls = 0;
+    stats.multiView.instances = 0;
+    stats.multiView.cullTests = 0;
+    stats.multiView.cpuMs = 0.0f;
+    stats.multiView.views.assign(count, ViewStats());
 }
 
+unsigned int Renderer::visibleViews(const glm::vec3& min, const glm::vec3& max) {
+    ++stats.multiView.cullTests;
+    return frustums.boxMask(min, max);
+}
+
+unsigned int Renderer::visibleViews(const glm::vec3& center, float radius) {
+    ++stats.multiView.cullTests;
+    return frustums.sphereMask(center, radius);
+}
+
+void Renderer::setViewArrays(const ShaderProgram& program) const {
+    glm::vec2 slices[ViewFrustums::MaxViews];
+    glm::vec4 viewports[ViewFrustums::MaxViews];
+    for (size_t v = 0; v < viewStates.size(); ++v) {
+        slices[v] = ClusteredLighting::sliceParameters(viewStates[v].nearClip, viewStates[v].farClip);
+        viewports[v] = viewStates[v].viewport;
+    }
+    GLsizei count = static_cast<GLsizei>(viewStates.size());
+    glUniform2fv(program.getUniformLocation("clusterDepth"), count, glm::value_ptr(slices[0]));
+    glUniform4fv(program.getUniformLocation("viewports"), count, glm::value_ptr(viewports[0]));
+}
+
+void Renderer::applyView(const ShaderProgram& program, size_t view) const {
+    const ViewState& state = viewStates[view];
+    glViewport(static_cast<GLint>(state.viewport.x), static_cast<GLint>(state.viewport.y),
+        static_cast<GLsizei>(state.viewport.z), static_cast<GLsizei>(state.viewport.w));
+    glUniformMatrix4fv(program.getUniformLocation("view"), 1, GL_FALSE, glm::value_ptr(state.view));
+    glUniformMatrix4fv(program.getUniformLocation("projection"), 1, GL_FALSE, glm::value_ptr(state.projection));
+    glUniform3fv(program.getUniformLocation("viewPos"), 1, glm::value_ptr(state.position));
+    glUniform1i(program.getUniformLocation("currentView"), static_cast<GLint>(view));
+}
+
+void Renderer::bindSinglePass() const {
+    glUseProgram(multiViewProgram.getId());
+    // glViewport in a per-view pass resets every viewport, so they are set again before each single-pass draw
+    GLfloat viewports[ViewFrustums::MaxViews * 4];
+    for (size_t v = 0; v < viewStates.size(); ++v) {
+        for (int i = 0; i < 4; ++i)
+            viewports[v * 4 + i] = viewStates[v].viewport[i];
+    }
+    GLExtensions::ViewportArrayv(0, static_cast<GLsizei>(viewStates.size()), viewports);
+}
+
+void Renderer::drawCulled(GPUCulling& culling) {
+    if (isMultiView()) {
+        // One CPU pass tests every view, the compute shader writes the draw commands of a single view
+        stats.multiView.cullTests += culling.getObjectCount();
+        auto screenSize = [this](const glm::vec3& center, float radius) { return projectedSize(center, radius); };
+        culling.forEachVisible(frustums, screenSize, [this](const MeshAllocation& mesh, const glm::mat4& model, ColorRGBA8 color, unsigned int visibleViews) {
+            InstanceData instance = makeInstance(model, glm::vec4(1.0f));
+            instance.color = color;
+            InstanceBucket& bucket = getBucket(mesh);
+            bucket.instances.push_back(instance);
+            bucket.hiddenViews.push_back(static_cast<uint8_t>(frustums.allViews() & ~visibleViews));
+        });
+        return;
+    }
+
+    glm::mat4 viewProjection = getViewProjection();
+    if (!culling.isActive()) {
+        // 3.3 path, same sphere test and level selection
+        auto screenSize = [this](const glm::vec3& center, float radius) { return projectedSize(center, radius); };
+        culling.forEachVisible(viewProjection, screenSize, [this](const MeshAllocation& mesh, const glm::mat4& model, ColorRGBA8 color) {
+            InstanceData instance = makeInstance(model, glm::vec4(1.0f));
+            instance.color = color;
+            getBucket(mesh).instances.push_back(instance);
+        });
+        return;
+    }
+
+    culling.cull(viewProjection, cameraPosition, projectionScale);
+    glUseProgram(shaderProgram.getId());
+
+    glVertexAttrib4f(ColorLocation, 1.0f, 1.0f, 1.0f, 1.0f);
+    glVertexAttrib2f(InstancePositionLocation, 0.0f, 0.0f);
+    glVertexAttrib1f(InstanceScaleLocation, 1.0f);
+
+    // Each command's baseInstance selects its mesh's range of the compacted instances
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, culling.getCommandBuffer());
+    for (const GPUCulling::FormatRange& range : culling.getFormatRanges()) {
+        glBindVertexArray(MeshArena::instance().getVAO(range.format));
+        glBindBuffer(GL_ARRAY_BUFFER, culling.getInstanceBuffer());
+        applyVertexLayout<InstanceData>(1);
+        glDisableVertexAttribArray(InstancePositionLocation);
+        glDisableVertexAttribArray(InstanceScaleLocation);
+
+        GLExtensions::MultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>(range.firstCommand * sizeof(DrawElementsIndirectCommand)),
+            static_cast<GLsizei>(range.commandCount), 0);
+        ++stats.drawCalls;
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void Renderer::drawTerrain(Terrain& terrain) {
+    stats.terrainNodes = 0;
+    if (!terrainProgram.isValid())
+        return;
+
+    if (isMultiView()) {
+        // Node selection and morphing follow the camera, so each view selects and draws its own nodes
+        glUseProgram(terrainProgram.getId());
+        glUniform3fv(terrainProgram.getUniformLocation("lightPos"), 1, glm::value_ptr(lightPos));
+        glUniform3fv(terrainProgram.getUniformLocation("lightColor"), 1, glm::value_ptr(lightColor));
+        setViewArrays(terrainProgram);
+        for (size_t v = 0; v < viewStates.size(); ++v) {
+            const ViewState& state = viewStates[v];
+            terrain.select(Frustum(state.projection * state.view), state.position, terrainNodes);
+            stats.multiView.views[v].terrainNodes = terrainNodes.size();
+            if (terrainNodes.empty())
+                continue;
+
+            applyView(terrainProgram, v);
+            terrain.draw(terrainProgram, terrainNodes, state.position);
+
+            size_t triangles = terrainNodes.size() * terrain.getTrianglesPerNode();
+            stats.multiView.views[v].triangles += triangles;
+            stats.terrainNodes += terrainNodes.size();
+            stats.triangles += triangles;
+            ++stats.drawCalls;
+        }
+        glUseProgram(shaderProgram.getId());
+        return;
+    }
+
+    terrain.select(Frustum(getViewProjection()), cameraPosition, terrainNodes);
+    if (terrainNodes.empty())
+        return;
+
+    glUseProgram(terrainProgram.getId());
+    glUniformMatrix4fv(terrainProgram.getUniformLocation("view"), 1, GL_FALSE, glm::value_ptr(viewMatrix));
+    glUniformMatrix4fv(terrainProgram.getUniformLocation("projection"), 1, GL_FALSE, glm::value_ptr(projectionMatrix));
+    glUniform3fv(terrainProgram.getUniformLocation("lightPos"), 1, glm::value_ptr(lightPos));
+    glUniform3fv(terrainProgram.getUniformLocation("lightColor"), 1, glm::value_ptr(lightColor));
+    glUniform2fv(terrainProgram.getUniformLocation("clusterDepth"), 1, glm::value_ptr(ClusteredLighting::sliceParameters(nearClip, farClip)));
+    glUniform4f(terrainProgram.getUniformLocation("viewports"), 0.0f, 0.0f, SCR_WIDTH, SCR_HEIGHT);
+    glUniform1i(terrainProgram.getUniformLocation("currentView"), 0);
+    terrain.draw(terrainProgram, terrainNodes, cameraPosition);
+
+    stats.terrainNodes = terrainNodes.size();
+    stats.triangles += terrainNodes.size() * terrain.getTrianglesPerNode();
+    stats.instances += static_cast<unsigned int>(terrainNodes.size());
+    ++stats.drawCalls;
+    glUseProgram(shaderProgram.getId());
+}
+
+void Renderer::setupLightingSamplers(const ShaderProgram& program) {
+    glUseProgram(program.getId());
+    glUniform1i(program.getUniformLocation("lightData"), LightTextureUnit);
+    glUniform1i(program.getUniformLocation("clusterData"), LightTextureUnit + 1);
+    glUniform1i(program.getUniformLocation("lightIndices"), LightTextureUnit + 2);
+    glUniform3i(program.getUniformLocation("clusterGrid"), ClusteredLighting::GridX, ClusteredLighting::GridY, ClusteredLighting::GridZ);
+    glUseProgram(0);
+}
+
+void Renderer::setLights(const std::vector<PointLight>& lights) {
+    if (isMultiView()) {
+        ClusterView clusterViews[ViewFrustums::MaxViews];
+        for (size_t v = 0; v < viewStates.size(); ++v)
+            clusterViews[v] = { viewStates[v].view, viewStates[v].projection, viewStates[v].nearClip, viewStates[v].farClip };
+        lighting.update(lights.data(), lights.size(), clusterViews, viewStates.size());
+        for (size_t v = 0; v < viewStates.size(); ++v)
+            stats.multiView.views[v].visibleLights = lighting.getVisibleLightCount(v);
+    }
+    else
+        lighting.update(lights.data(), lights.size(), viewMatrix, projectionMatrix, nearClip, farClip);
+    lighting.bind(LightTextureUnit);
+    stats.visibleLights = lighting.getVisibleLightCount();
+    stats.lightIndices = lighting.getIndexCount();
+}
+
+InstanceData Renderer::makeInstance(const glm::mat4& modelMatrix, const glm::vec4& color) {
+    InstanceData instance;
+    instance.model0 = modelMatrix[0];
+    instance.model1 = modelMatrix[1];
+    instance.model2 = modelMatrix[2];
+    instance.model3 = modelMatrix[3];
+    instance.color = packColor(color);
+    return instance;
+}
+
+Renderer::InstanceBucket& Renderer::getBucket(const MeshAllocation& mesh) {
+    // Index ranges never overlap between live meshes, so the index range identifies the mesh
+    uint64_t key = static_cast<uint64_t>(mesh.firstIndex) << 32 | static_cast<uint32_t>(mesh.indexCount);
+    auto it = bucketLookup.find(key);
+    if (it != bucketLookup.end()) {
+        // Refresh in case the arena handed this range to another mesh since last frame
+        buckets[it->second].mesh = mesh;
+        return buckets[it->second];
+    }
+
+    bucketLookup[key] = buckets.size();
+    buckets.push_back({ mesh, {}, {} });
+    return buckets.back();
+}
+
+void Renderer::submit(const MeshAllocation& mesh, const glm::mat4& modelMatrix, const glm::vec4& color) {
+    submit(mesh, modelMatrix, color, frustums.allViews());
+}
+
+void Renderer::submit(const MeshAllocation& mesh, const glm::mat4& modelMatrix, const glm::vec4& color, unsigned int visibleViews) {
+    InstanceBucket& bucket = getBucket(mesh);
+    bucket.instances.push_back(makeInstance(modelMatrix, color));
+    if (isMultiView())
+        bucket.hiddenViews.push_back(static_cast<uint8_t>(frustums.allViews() & ~visibleViews));
+}
+
+void Renderer::submit(const MeshBatch& batch, unsigned int visibleViews) {
+    if (batch.parts.empty())
+        return;
+    QueuedBatch queued;
+    queued.firstPart = batchParts.size();
+    queued.partCount = batch.parts.size();
+    queued.instance = makeInstance(batch.modelMatrix, batch.color);
+    queued.hiddenViews = static_cast<uint8_t>(frustums.allViews() & ~visibleViews);
+    batches.push_back(queued);
+    batchParts.insert(batchParts.end(), batch.parts.begin(), batch.parts.end());
+}
+
+void Renderer::submit(const MeshAllocation& mesh, const TransformSoA& transforms, const glm::vec4& color) {
+    std::vector<InstanceData>& instances = getBucket(mesh).instances;
+    size_t first = instances.size();
+    instances.resize(first + transforms.count);
+    TransformBatch::compose(transforms, instances.data() + first, packColor(color));
+    if (isMultiView())
+        getBucket(mesh).hiddenViews.resize(instances.size(), 0);
+}
+
+float Renderer::projectedSize(const glm::vec3& center, float radius) const {
+    if (viewStates.empty())
+        return projectedSizeFrom(center, radius, cameraPosition, projectionScale);
+
+    // One mesh level serves every view, so the closest view decides
+    float size = 0.0f;
+    for (const ViewState& state : viewStates)
+        size = std::max(size, projectedSizeFrom(center, radius, state.position, state.projectionScale));
+    return size;
+}
+
+size_t Renderer::selectLevel(const GPUMeshLOD& mesh, const glm::vec3& center, float scale) {
+    size_t level = mesh.selectLevel(projectedSize(center, mesh.getBoundingRadius() * scale));
+
+    if (stats.instancesPerLOD.size() <= level)
+        stats.instancesPerLOD.resize(level + 1, 0);
+    ++stats.instancesPerLOD[level];
+    return level;
+}
+
+void Renderer::submit(const GPUMeshLOD& mesh, const glm::mat4& modelMatrix, float scale, const glm::vec4& color) {
+    size_t level = selectLevel(mesh, glm::vec3(modelMatrix[3]), scale);
+    submit(mesh.getLevel(level).getAllocation(), modelMatrix, color);
+}
+
+void Renderer::submit(const std::shared_ptr<WorldObject>& worldObject) {
+    if (worldObject->getLOD()) {
+        float scale = glm::max(worldObject->scale.x, glm::max(worldObject->scale.y, worldObject->scale.z));
+        submit(*worldObject->getLOD(), worldObject->getModelMatrix(), scale, worldObject->color);
+        return;
+    }
+    submit(worldObject->getMeshAllocation(), worldObject->getModelMatrix(), worldObject->color);
+}
+
+void Renderer::uploadStream(GLuint buffer, size_t& capacity, const void* data, size_t size) {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    if (size > capacity)
+        capacity = std::max(size, capacity * 2);
+    // Orphan last frame's storage so the driver does not wait for it
+    glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+}
+
+void Renderer::uploadInstances(const InstanceData* instances, size_t count) {
+    uploadStream(instanceVBO, instanceCapacity, instances, count * sizeof(InstanceData));
+}
+
+void Renderer::bindMatrixInstances(size_t byteOffset) {
+    // The top-down attributes fall back to their current values, set in endFrame
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    applyVertexLayout<InstanceData>(1, byteOffset);
+    glDisableVertexAttribArray(InstancePositionLocation);
+    glDisableVertexAttribArray(InstanceScaleLocation);
+}
+
+void Renderer::setPositionStream(const Position* positions, size_t count) {
+    positionCount = count;
+    if (count > 0)
+        uploadStream(positionVBO, positionCapacity, positions, count * sizeof(Position));
+}
+
+void Renderer::setStyleStream(const InstanceStyle* styles, size_t count) {
+    styleCount = count;
+    if (count > 0)
+        uploadStream(styleVBO, styleCapacity, styles, count * sizeof(InstanceStyle));
+}
+
+void Renderer::setHiddenViewsStream(const uint8_t* hiddenViews, size_t count) {
+    positionHiddenViews.assign(hiddenViews, hiddenViews + count);
+    if (count > 0)
+        uploadStream(positionHiddenViewsVBO, positionHiddenViewsCapacity, hiddenViews, count);
+}
+
+void Renderer::drawPositionRange(const MeshAllocation& mesh, size_t first, size_t count, const InstanceStyle& style) {
+    if (count == 0 || first + count > positionCount)
+        return;
+
+    glBindVertexArray(MeshArena::instance().getVAO(mesh.format));
+
+    // Identity model matrix, the translation comes from the Position stream
+    for (GLuint column = 0; column < 4; ++column) {
+        glDisableVertexAttribArray(InstanceModelLocation + column);
+        glVertexAttrib4f(InstanceModelLocation + column, column == 0 ? 1.0f : 0.0f, column == 1 ? 1.0f : 0.0f,
+            column == 2 ? 1.0f : 0.0f, column == 3 ? 1.0f : 0.0f);
+    }
+    glVertexAttrib4f(ColorLocation, 1.0f, 1.0f, 1.0f, 1.0f);
+
+    glBindBuffer(GL_ARRAY_BUFFER, positionVBO);
+    applyVertexLayout<Position>(1, first * sizeof(Position));
+
+    if (first + count <= styleCount) {
+        glBindBuffer(GL_ARRAY_BUFFER, styleVBO);
+        applyVertexLayout<InstanceStyle>(1, first * sizeof(InstanceStyle));
+    }
+    else {
+        glDisableVertexAttribArray(InstanceScaleLocation);
+        glDisableVertexAttribArray(InstanceColorLocation);
+        glVertexAttrib1f(InstanceScaleLocation, style.scale);
+        glVertexAttrib4Nub(InstanceColorLocation, style.color.r, style.color.g, style.color.b, style.color.a);
+    }
+
+    if (!isMultiView()) {
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, mesh.indexOffset(),
+            static_cast<GLsizei>(count), mesh.baseVertex);
+        ++stats.drawCalls;
+        stats.triangles += static_cast<size_t>(mesh.indexCount / 3) * count;
+    }
+    else {
+        // Entries a view culled are dropped in that view by the hidden view stream, as in drawBuckets
+        bool culled = first + count <= positionHiddenViews.size();
+        if (culled)
+            bindHiddenViews(positionHiddenViewsVBO, first);
+        if (singlePass)
+            bindSinglePass();
+        else
+            glUseProgram(shaderProgram.getId());
+        size_t passes = singlePass ? 1 : viewStates.size();
+        for (size_t pass = 0; pass < passes; ++pass) {
+            if (!singlePass)
+                applyView(shaderProgram, pass);
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, mesh.indexOffset(),
+                static_cast<GLsizei>(count), mesh.baseVertex);
+            ++stats.drawCalls;
+        }
+        if (culled)
+            glDisableVertexAttribArray(HiddenViewsLocation);
+
+        for (size_t v = 0; v < stats.multiView.views.size(); ++v) {
+            size_t visible = count;
+            if (culled) {
+                for (size_t i = first; i < first + count; ++i)
+                    visible -= (positionHiddenViews[i] >> v) & 1u;
+            }
+            size_t viewTriangles = static_cast<size_t>(mesh.indexCount / 3) * visible;
+            stats.multiView.views[v].instances += static_cast<unsigned int>(visible);
+            stats.multiView.views[v].triangles += viewTriangles;
+            stats.triangles += viewTriangles;
+        }
+    }
+    stats.instances += static_cast<unsigned int>(count);
 
-void Renderer::render(const std::shared_ptr<WorldObject>& worldObject, const Camera& camera) {
-    glUseProgram(shaderProgram);
-    updateUniforms(camera);
-    /*
-    glUniform3fv(glGetUniformLocation(shaderProgram, "lightPos"), 1, glm::value_ptr(lightPos));
-    glUniform3fv(glGetUniformLocation(shaderProgram, "viewPos"), 1, glm::value_ptr(camera.position));
-    glUniform3fv(glGetUniformLocation(shaderProgram, "lightColor"), 1, glm::value_ptr(lightColor));
-    */
-    // Calculate and set the model matrix for the current object
-    glm::mat4 modelMatrix = worldObject->getModelMatrix();
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(modelMatrix));
-
-    // Bind the VAO and draw the object
-    glBindVertexArray(worldObject->getGLObject(VAOtype));
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(worldObject->model.getIndices().size()), GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Renderer::endFrame() {
+    // Gather every bucket into one contiguous upload, shared by all views
+    instanceStaging.clear();
+    hiddenViewsStaging.clear();
+    for (const InstanceBucket& bucket : buckets) {
+        instanceStaging.insert(instanceStaging.end(), bucket.instances.begin(), bucket.instances.end());
+        hiddenViewsStaging.insert(hiddenViewsStaging.end(), bucket.hiddenViews.begin(), bucket.hiddenViews.end());
+    }
+    // One instance per batch after the buckets, shared by all of its parts
+    for (const QueuedBatch& batch : batches) {
+        instanceStaging.push_back(batch.instance);
+        hiddenViewsStaging.push_back(batch.hiddenViews);
+    }
+
+    if (!instanceStaging.empty()) {
+        uploadInstances(instanceStaging.data(), instanceStaging.size());
+        if (isMultiView())
+            uploadStream(hiddenViewsVBO, hiddenViewsCapacity, hiddenViewsStaging.data(), hiddenViewsStaging.size());
+
+        // Formats without vertex colors read white, the top-down translation and scale are neutral
+        glVertexAttrib4f(ColorLocation, 1.0f, 1.0f, 1.0f, 1.0f);
+        glVertexAttrib2f(InstancePositionLocation, 0.0f, 0.0f);
+        glVertexAttrib1f(InstanceScaleLocation, 1.0f);
+
+        if (!isMultiView())
+            drawBuckets();
+        else if (singlePass) {
+            bindSinglePass();
+            drawBuckets();
+        }
+        else {
+            glUseProgram(shaderProgram.getId());
+            for (size_t v = 0; v < viewStates.size(); ++v) {
+                applyView(shaderProgram, v);
+                drawBuckets();
+            }
+        }
+        glVertexAttribI4ui(HiddenViewsLocation, 0, 0, 0, 0);
+
+        for (const InstanceBucket& bucket : buckets) {
+            size_t triangles = static_cast<size_t>(bucket.mesh.indexCount / 3);
+            stats.instances += static_cast<unsigned int>(bucket.instances.size());
+            if (!isMultiView()) {
+                stats.triangles += triangles * bucket.instances.size();
+                continue;
+            }
+
+            unsigned int hidden[ViewFrustums::MaxViews] = {};
+            for (uint8_t mask : bucket.hiddenViews) {
+                for (size_t v = 0; v < viewStates.size(); ++v)
+                    hidden[v] += (mask >> v) & 1u;
+            }
+            for (size_t v = 0; v < viewStates.size(); ++v) {
+                unsigned int visible = static_cast<unsigned int>(bucket.instances.size()) - hidden[v];
+                stats.multiView.views[v].instances += visible;
+                stats.multiView.views[v].triangles += triangles * visible;
+                stats.triangles += triangles * visible;
+            }
+        }
+        for (const QueuedBatch& batch : batches) {
+            size_t triangles = 0;
+            for (size_t i = 0; i < batch.partCount; ++i)
+                triangles += static_cast<size_t>(batchParts[batch.firstPart + i].indexCount / 3);
+            stats.instances += static_cast<unsigned int>(batch.partCount);
+            if (!isMultiView()) {
+                stats.triangles += triangles;
+                continue;
+            }
+            for (size_t v = 0; v < viewStates.size(); ++v) {
+                if ((batch.hiddenViews >> v) & 1u)
+                    continue;
+                stats.multiView.views[v].instances += static_cast<unsigned int>(batch.partCount);
+                stats.multiView.views[v].triangles += triangles;
+                stats.triangles += triangles;
+            }
+        }
+    }
+    batches.clear();
+    batchParts.clear();
+
+    if (isMultiView()) {
+        // Back to the whole target for what is drawn after the scene
+        glViewport(0, 0, static_cast<GLsizei>(SCR_WIDTH), static_cast<GLsizei>(SCR_HEIGHT));
+        glUseProgram(shaderProgram.getId());
+        stats.multiView.drawCalls = stats.drawCalls;
+        stats.multiView.instances = stats.instances;
+        stats.multiView.cpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    }
+
+    // Keep bucket storage for the next frame, forget meshes nobody drew
+    for (size_t i = 0; i < buckets.size();) {
+        if (buckets[i].instances.empty()) {
+            buckets[i] = std::move(buckets.back());
+            buckets.pop_back();
+            continue;
+        }
+        buckets[i].instances.clear();
+        buckets[i].hiddenViews.clear();
+        ++i;
+    }
+    bucketLookup.clear();
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        const MeshAllocation& mesh = buckets[i].mesh;
+        bucketLookup[static_cast<uint64_t>(mesh.firstIndex) << 32 | static_cast<uint32_t>(mesh.indexCount)] = i;
+    }
+}
+
+void Renderer::drawBuckets() {
+    size_t offset = 0;
+    for (const InstanceBucket& bucket : buckets) {
+        if (bucket.instances.empty())
+            continue;
+
+        // Without base instance support the instance attributes are re-pointed per bucket
+        const MeshAllocation& mesh = bucket.mesh;
+        glBindVertexArray(MeshArena::instance().getVAO(mesh.format));
+        bindMatrixInstances(offset * sizeof(InstanceData));
+        bindHiddenViews(hiddenViewsVBO, offset);
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT, mesh.indexOffset(),
+            static_cast<GLsizei>(bucket.instances.size()), mesh.baseVertex);
+        if (isMultiView())
+            glDisableVertexAttribArray(HiddenViewsLocation);
+
+        ++stats.drawCalls;
+        offset += bucket.instances.size();
+    }
+
+    // A batch's parts share program, instance and format, so each format goes out as one call
+    for (const QueuedBatch& batch : batches) {
+        for (size_t format = 0; format < static_cast<size_t>(VertexFormat::Count); ++format) {
+            multiDrawCounts.clear();
+            multiDrawOffsets.clear();
+            multiDrawBaseVertices.clear();
+            for (size_t i = 0; i < batch.partCount; ++i) {
+                const MeshAllocation& part = batchParts[batch.firstPart + i];
+                if (static_cast<size_t>(part.format) != format)
+                    continue;
+                multiDrawCounts.push_back(part.indexCount);
+                multiDrawOffsets.push_back(part.indexOffset());
+                multiDrawBaseVertices.push_back(part.baseVertex);
+            }
+            if (multiDrawCounts.empty())
+                continue;
+
+            glBindVertexArray(MeshArena::instance().getVAO(static_cast<VertexFormat>(format)));
+            bindMatrixInstances(offset * sizeof(InstanceData));
+            bindHiddenViews(hiddenViewsVBO, offset);
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, multiDrawCounts.data(), GL_UNSIGNED_INT,
+                multiDrawOffsets.data(), static_cast<GLsizei>(multiDrawCounts.size()), multiDrawBaseVertices.data());
+            if (isMultiView())
+                glDisableVertexAttribArray(HiddenViewsLocation);
+            ++stats.drawCalls;
+        }
+        ++offset;
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Renderer::bindHiddenViews(GLuint buffer, size_t offset) {
+    if (!isMultiView())
+        return;
+    // The arena VAOs are shared with every other path, so the stream is only enabled for one draw
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glEnableVertexAttribArray(HiddenViewsLocation);
+    glVertexAttribIPointer(HiddenViewsLocation, 1, GL_UNSIGNED_BYTE, 0, reinterpret_cast<const void*>(offset));
+    glVertexAttribDivisor(HiddenViewsLocation, 1);
+}
+
+void Renderer::render(const std::shared_ptr<WorldObject>& worldObject, const Camera& camera) {
+    beginFrame(camera);
+    submit(worldObject);
+    endFrame();
 }
 
 void Renderer::updateUniforms(const Camera& camera) {
-    glm::mat4 view = glm::lookAt(camera.position, camera.position + camera.front, camera.up);
-    glm::mat4 projection = glm::perspective(glm::radians(camera.FoV), SCR_WIDTH / SCR_HEIGHT, camera.nearClip, camera.farClip);
+    viewMatrix = glm::lookAt(camera.position, camera.position + camera.front, camera.up);
+    projectionMatrix = glm::perspective(glm::radians(camera.FoV), SCR_WIDTH / SCR_HEIGHT, camera.nearClip, camera.farClip);
+    nearClip = camera.nearClip;
+    farClip = camera.farClip;
+
+    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(viewMatrix));
+    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projectionMatrix));
 
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+    // The fragment shader finds its cluster from the pixel position and view depth
+    if (clusterDepthLoc != -1)
+        glUniform2fv(clusterDepthLoc, 1, glm::value_ptr(ClusteredLighting::sliceParameters(nearClip, farClip)));
+    if (viewportsLoc != -1)
+        glUniform4f(viewportsLoc, 0.0f, 0.0f, SCR_WIDTH, SCR_HEIGHT);
+    if (currentViewLoc != -1)
+        glUniform1i(currentViewLoc, -1);
+    lighting.bind(LightTextureUnit);
 }
 
 void Renderer::cleanup() {
-    glDeleteProgram(shaderProgram);
+    glDeleteBuffers(1, &instanceVBO);
+    glDeleteBuffers(1, &positionVBO);
+    glDeleteBuffers(1, &styleVBO);
+    glDeleteBuffers(1, &hiddenViewsVBO);
+    glDeleteBuffers(1, &positionHiddenViewsVBO);
+    lighting.cleanup();
+    shaderProgram.destroy();
+    terrainProgram.destroy();
+    multiViewProgram.destroy();
 }
@@ -5,30 +5,202 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <chrono>
+#include <unordered_map>
 #include <vector>
 #include "ShaderHelper.h"
 #include "WorldObject.h"
+#include "MeshLOD.h"
 #include "Camera.h"
+#include "TransformBatch.h"
+#include "ClusteredLighting.h"
+#include "GPUCulling.h"
+#include "Terrain.h"
+#include "MultiView.h"
+
+// Per-frame submission counters
+struct RenderStats {
+    unsigned int drawCalls{ 0 };
+    unsigned int instances{ 0 };
+    size_t triangles{ 0 };
+    std::vector<unsigned int> instancesPerLOD; // Index is the selected LOD level
+    size_t visibleLights{ 0 };
+    size_t lightIndices{ 0 };                  // Entries in the cluster light lists
+    size_t terrainNodes{ 0 };
+    MultiViewStats multiView;                  // Split-screen frames only
+};
 
 class Renderer {
 public:
-    Renderer() : shaderProgram(0), viewLoc(-1), projLoc(-1) { initializeShaders(); }
+    Renderer() : viewLoc(-1), projLoc(-1) { initializeShaders(); }
 
     void initializeShaders();
+
+    // Frame submission: beginFrame sets camera state once, submit queues instances,
+    // endFrame draws every mesh with one instanced call
+    void beginFrame(const Camera& camera);
+    void submit(const MeshAllocation& mesh, const glm::mat4& modelMatrix, const glm::vec4& color);
+    void submit(const GPUMeshLOD& mesh, const glm::mat4& modelMatrix, float scale, const glm::vec4& color);
+    void submit(const std::shared_ptr<WorldObject>& worldObject);
+    // Many instances of one mesh, matrices are composed in bulk straight into the instance list
+    void submit(const MeshAllocation& mesh, const TransformSoA& transforms, const glm::vec4& color);
+    void endFrame();
+
+    // Split-screen frame, up to ViewFrustums::MaxViews views. Objects are culled against all views at once and
+    // instances are uploaded once; with viewport arrays each bucket is then a single draw that MultiView.gs
+    // sends to every view, otherwise the buckets are drawn once per view. One view is beginFrame(camera).
+    void beginFrame(const std::vector<RenderView>& views);
+    // Queues an instance for the views in visibleViews only, see visibleViews()
+    void submit(const MeshAllocation& mesh, const glm::mat4& modelMatrix, const glm::vec4& color, unsigned int visibleViews);
+    // Queues meshes sharing one model matrix and color, drawn with one glMultiDrawElementsBaseVertex per vertex format
+    void submit(const MeshBatch& batch, unsigned int visibleViews);
+    // Bit per view of this frame that sees the bounds, counted in the cull tests
+    unsigned int visibleViews(const glm::vec3& min, const glm::vec3& max);
+    unsigned int visibleViews(const glm::vec3& center, float radius);
+    size_t getViewCount() const { return viewStates.empty() ? 1 : viewStates.size(); }
+    bool isMultiView() const { return !viewStates.empty(); }
+
+    // Top-down path: the vertex shader builds translate(x, 0, z) * scale straight from the ECS Position pool.
+    // The pool is uploaded once per frame, ranges of it are then drawn per mesh between beginFrame and endFrame.
+    void setPositionStream(const Position* positions, size_t count);
+    // Optional scale/color parallel to the Position stream, upload only when they change; count 0 turns it off
+    void setStyleStream(const InstanceStyle* styles, size_t count);
+    // Bit per split-screen view that culled each entry of the Position stream, see visibleViews. Set every
+    // frame after setPositionStream; without it (count 0) split-screen views draw whole ranges.
+    void setHiddenViewsStream(const uint8_t* hiddenViews, size_t count);
+    // Draws positions [first, first + count), style applies to all of them unless a style stream covers the range
+    void drawPositionRange(const MeshAllocation& mesh, size_t first, size_t count, const InstanceStyle& style);
+
+    // Every visible object of culling. With GL 4.3 the compute shader culls and each vertex format is one
+    // glMultiDrawElementsIndirect drawn right away; otherwise objects are culled on the CPU and queued like submit
+    void drawCulled(GPUCulling& culling);
+
+    // Selects and draws the terrain's visible nodes right away with the scene lighting, one instanced call
+    void drawTerrain(Terrain& terrain);
+
+    // Point lights for the rest of the frame, call after beginFrame and before anything is drawn
+    void setLights(const std::vector<PointLight>& lights);
+
+    // Immediate helpers, each is a frame of its own
     void render(const std::shared_ptr<WorldObject>& worldObject, const Camera& camera);
+
     void cleanup();
     void setAspect(unsigned int width, unsigned int height) { SCR_HEIGHT = static_cast<float>(height); SCR_WIDTH = static_cast<float>(width); }
 
-    glm::vec3 lightPos = glm::vec3(0.0f, 1.0f, 0.0f);
-    glm::vec3 lightColor = glm::vec3(1.0f, 1.0f, 1.0f);
+    // Projected diameter of a bounding sphere as a fraction of the viewport height, the largest of all views
+    float projectedSize(const glm::vec3& center, float radius) const;
+
+    // LOD level for an instance of mesh at center, counted in the frame stats
+    size_t selectLevel(const GPUMeshLOD& mesh, const glm::vec3& center, float scale);
+
+    const RenderStats& getStats() const { return stats; }
+    glm::mat4 getViewProjection() const { return projectionMatrix * viewMatrix; }
+    const glm::mat4& getViewMatrix() const { return viewMatrix; }
+    const glm::mat4& getProjectionMatrix() const { return projectionMatrix; }
+    // Per split-screen view, view 0 is also what the single-view getters return
+    const glm::mat4& getViewMatrix(size_t view) const { return viewStates.empty() ? viewMatrix : viewStates[view].view; }
+    const glm::mat4& getProjectionMatrix(size_t view) const { return viewStates.empty() ? projectionMatrix : viewStates[view].projection; }
+
+    // Draw all split-screen views in one pass when the driver has viewport arrays
+    bool singlePassViews{ true };
+
+    // Distant key light: lightPos is the direction towards it
+    glm::vec3 lightPos = glm::vec3(0.3f, 1.0f, 0.2f);
+    glm::vec3 lightColor = glm::vec3(0.8f, 0.8f, 0.8f);
 
 private:
-    GLuint shaderProgram;
+    // All instances of one arena mesh
+    struct InstanceBucket {
+        MeshAllocation mesh;
+        std::vector<InstanceData> instances;
+        std::vector<uint8_t> hiddenViews; // Parallel to instances in split-screen frames, bit per view that culled it
+    };
+
+    // MeshBatch queued for endFrame, its parts are kept in batchParts
+    struct QueuedBatch {
+        size_t firstPart, partCount;
+        InstanceData instance;
+        uint8_t hiddenViews;
+    };
+
+    // Camera state of one split-screen view
+    struct ViewState {
+        glm::mat4 view, projection;
+        glm::vec3 position;
+        float projectionScale, nearClip, farClip;
+        glm::vec4 viewport; // x, y, width, height
+    };
+
+    ShaderProgram shaderProgram;
+    ShaderProgram terrainProgram;   // Terrain.vs with the scene fragment shader
+    ShaderProgram multiViewProgram; // MultiView.vs and .gs with the scene fragment shader, needs viewport arrays
     GLint viewLoc, projLoc;
-    GLint modelLoc;
+    GLint lightPosLoc{ -1 }, viewPosLoc{ -1 }, lightColorLoc{ -1 };
+    GLint clusterDepthLoc{ -1 }, viewportsLoc{ -1 }, currentViewLoc{ -1 };
     float SCR_WIDTH{ 800 };
     float SCR_HEIGHT{ 600 };
 
+    // Camera state captured by beginFrame
+    glm::vec3 cameraPosition{ 0.0f };
+    float projectionScale{ 1.0f }; // 1 / tan(fov / 2)
+    glm::mat4 viewMatrix{ 1.0f }, projectionMatrix{ 1.0f };
+    float nearClip{ 0.1f }, farClip{ 100.0f };
+
+    // Split-screen state, empty outside split-screen frames. View 0 is mirrored into the fields above.
+    std::vector<ViewState> viewStates;
+    ViewFrustums frustums;  // Also holds the single view's frustum
+    bool singlePass{ false };
+    std::chrono::steady_clock::time_point frameStart;
+
+    // Light lists live in buffer textures on units LightTextureUnit .. LightTextureUnit + 2
+    static const GLuint LightTextureUnit = 0;
+    ClusteredLighting lighting;
+
+    // Buckets persist across frames so steady-state submission does not allocate
+    std::vector<InstanceBucket> buckets;
+    std::unordered_map<uint64_t, size_t> bucketLookup;
+    std::vector<QueuedBatch> batches;
+    std::vector<MeshAllocation> batchParts;
+    std::vector<InstanceData> instanceStaging;
+    GLuint instanceVBO{ 0 };
+    size_t instanceCapacity{ 0 }; // Bytes
+    std::vector<uint8_t> hiddenViewsStaging;
+    GLuint hiddenViewsVBO{ 0 };
+    size_t hiddenViewsCapacity{ 0 }; // Bytes
+
+    // Top-down streams, see setPositionStream
+    GLuint positionVBO{ 0 }, styleVBO{ 0 }, positionHiddenViewsVBO{ 0 };
+    size_t positionCapacity{ 0 }, styleCapacity{ 0 }, positionHiddenViewsCapacity{ 0 }; // Bytes
+    size_t positionCount{ 0 }, styleCount{ 0 };
+    std::vector<uint8_t> positionHiddenViews; // Kept for the per-view statistics
+
+    RenderStats stats;
+
+    // Scratch arrays for glMultiDrawElementsBaseVertex, reused between batches
+    std::vector<GLsizei> multiDrawCounts;
+    std::vector<const void*> multiDrawOffsets;
+    std::vector<GLint> multiDrawBaseVertices;
+
+    std::vector<TerrainNode> terrainNodes;
+
     void updateUniforms(const Camera& camera);
+    // Viewports and cluster slices of every view of the frame, for programs using Triangle.fs
+    void setViewArrays(const ShaderProgram& program) const;
+    // Viewport, camera matrices and currentView of one split-screen view, for the per-view passes
+    void applyView(const ShaderProgram& program, size_t view) const;
+    // Binds the single-pass program with every view's viewport
+    void bindSinglePass() const;
+    // One instanced draw per bucket, then one multi-draw per vertex format of each batch, with the bound program
+    // and the hidden view stream in split-screen frames
+    void drawBuckets();
+    // Points location 11 at entry offset of a hidden view stream, split-screen frames only
+    void bindHiddenViews(GLuint buffer, size_t offset);
+    // Light samplers and cluster grid, fixed for the lifetime of a program using Triangle.fs
+    static void setupLightingSamplers(const ShaderProgram& program);
+    InstanceBucket& getBucket(const MeshAllocation& mesh);
+    void uploadInstances(const InstanceData* instances, size_t count);
+    static void uploadStream(GLuint buffer, size_t& capacity, const void* data, size_t size);
+    void bindMatrixInstances(size_t byteOffset);
+    static InstanceData makeInstance(const glm::mat4& modelMatrix, const glm::vec4& color);
 };
 #endif
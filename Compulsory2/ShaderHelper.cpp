@@ -1 +1,189 @@
 #include "ShaderHelper.h"
+#include "GLExtensions.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+    // Cache file: header followed by the driver's binary blob
+    struct ProgramCacheHeader {
+        char magic[4]; // "SBIN"
+        uint32_t version;
+        uint64_t key;
+        uint32_t binaryFormat;
+        uint32_t length;
+    };
+    const uint32_t PROGRAM_CACHE_VERSION = 1;
+
+    void hashBytes(uint64_t& hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    void hashString(uint64_t& hash, const char* text) {
+        if (text)
+            hashBytes(hash, text, std::strlen(text) + 1); // Terminator separates neighbouring strings
+    }
+
+    std::string cachePath(uint64_t key) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "ShaderCache_%016llx.bin", static_cast<unsigned long long>(key));
+        return name;
+    }
+
+    GLuint loadBinary(const std::string& path, uint64_t key) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return 0;
+
+        ProgramCacheHeader header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return 0;
+        if (std::memcmp(header.magic, "SBIN", 4) != 0 || header.version != PROGRAM_CACHE_VERSION || header.key != key)
+            return 0;
+
+        std::vector<char> binary(header.length);
+        if (!file.read(binary.data(), binary.size()))
+            return 0;
+
+        GLuint program = glCreateProgram();
+        GLExtensions::ProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+        // Drivers reject binaries after an update even when the version string did not change
+        GLint success = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success) {
+            glDeleteProgram(program);
+            return 0;
+        }
+        return program;
+    }
+
+    void storeBinary(const std::string& path, uint64_t key, GLuint program) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(length);
+        GLenum binaryFormat = 0;
+        GLExtensions::GetProgramBinary(program, length, nullptr, &binaryFormat, binary.data());
+
+        ProgramCacheHeader header;
+        std::memcpy(header.magic, "SBIN", 4);
+        header.version = PROGRAM_CACHE_VERSION;
+        header.key = key;
+        header.binaryFormat = binaryFormat;
+        header.length = static_cast<uint32_t>(length);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), binary.size());
+        if (!file)
+            std::cerr << "Failed to write shader cache " << path << std::endl;
+    }
+}
+
+ShaderProgram::ShaderProgram(GLuint id) : id(id) {
+    if (id == 0)
+        return;
+
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<GLchar> name(maxLength > 0 ? maxLength : 1);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(id, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+
+        std::string uniformName(name.data(), length);
+        GLint location = glGetUniformLocation(id, uniformName.c_str());
+        if (location == -1)
+            continue; // Uniform block member
+
+        uniforms[uniformName] = location;
+        size_t bracket = uniformName.find("[0]");
+        if (bracket != std::string::npos)
+            uniforms[uniformName.substr(0, bracket)] = location;
+    }
+}
+
+GLint ShaderProgram::getUniformLocation(const std::string& name) const {
+    auto it = uniforms.find(name);
+    return it != uniforms.end() ? it->second : -1;
+}
+
+void ShaderProgram::destroy() {
+    if (id)
+        glDeleteProgram(id);
+    id = 0;
+    uniforms.clear();
+}
+
+GLuint ShaderHelper::createProgram(const std::vector<ShaderStage>& stages, bool retrievable) {
+    std::vector<GLuint> shaders;
+    for (const ShaderStage& stage : stages) {
+        GLuint shader = compileShader(stage.source.c_str(), stage.type);
+        if (!shader) {
+            std::cerr << "ERROR::SHADER::PROGRAM::SHADER_CREATION_FAILED\n";
+            for (GLuint compiled : shaders)
+                glDeleteShader(compiled);
+            return 0;  // Failed to compile
+        }
+        shaders.push_back(shader);
+    }
+
+    GLuint program = glCreateProgram();
+    for (GLuint shader : shaders)
+        glAttachShader(program, shader);
+    if (retrievable && GLExtensions::programBinary)
+        GLExtensions::ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
+
+    if (!checkLinkStatus(program)) {
+        glDeleteProgram(program);
+        program = 0;  // Return 0 to indicate failure
+    }
+
+    // Clean up shaders after linking
+    for (GLuint shader : shaders)
+        glDeleteShader(shader);
+
+    return program;
+}
+
+GLuint ShaderHelper::createCachedProgram(const std::vector<ShaderStage>& stages) {
+    if (!GLExtensions::programBinary)
+        return createProgram(stages);
+
+    uint64_t key = computeCacheKey(stages);
+    std::string path = cachePath(key);
+
+    GLuint program = loadBinary(path, key);
+    if (program)
+        return program;
+
+    program = createProgram(stages, true);
+    if (program)
+        storeBinary(path, key, program);
+    return program;
+}
+
+uint64_t ShaderHelper::computeCacheKey(const std::vector<ShaderStage>& stages) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const ShaderStage& stage : stages) {
+        hashBytes(hash, &stage.type, sizeof(stage.type));
+        hashString(hash, stage.source.c_str());
+    }
+
+    // A different GPU or driver build cannot load our binaries
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    return hash;
+}
@@ -1,6 +1,12 @@
+#ifndef SHADER_HELPER_H
+#define SHADER_HELPER_H
+
 #include <glad/glad.h>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 enum shaderEnum {
@@ -8,6 +14,30 @@ enum shaderEnum {
     FragmentSource
 };
 
+struct ShaderStage {
+    GLenum type;
+    std::string source;
+};
+
+// Linked program plus its active uniform locations, queried once after linking so draws never look up by name
+class ShaderProgram {
+public:
+    ShaderProgram() = default;
+    explicit ShaderProgram(GLuint id);
+
+    GLuint getId() const { return id; }
+    bool isValid() const { return id != 0; }
+
+    // -1 when the uniform is not active; arrays answer to both "name" and "name[0]"
+    GLint getUniformLocation(const std::string& name) const;
+
+    void destroy();
+
+private:
+    GLuint id{ 0 };
+    std::unordered_map<std::string, GLint> uniforms;
+};
+
 class ShaderHelper
 {
 public:
@@ -31,19 +61,16 @@ public:
     }
 
     static GLuint createProgram(const GLchar* vertexSource, const GLchar* fragmentSource) {
-        GLuint vertexShader = compileShader(vertexSource, GL_VERTEX_SHADER);
-        GLuint fragmentShader = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
+        return createProgram({ { GL_VERTEX_SHADER, vertexSource }, { GL_FRAGMENT_SHADER, fragmentSource } });
+    }
 
-        if (!vertexShader || !fragmentShader) {
-            std::cerr << "ERROR::SHADER::PROGRAM::SHADER_CREATION_FAILED\n";
-            return 0;  // Failed to compile
-        }
+    // retrievable asks the driver to keep the binary around for glGetProgramBinary
+    static GLuint createProgram(const std::vector<ShaderStage>& stages, bool retrievable = false);
 
-        GLuint program = glCreateProgram();
-        glAttachShader(program, vertexShader);
-        glAttachShader(program, fragmentShader);
-        glLinkProgram(program);
+    // Loads the program from the on-disk binary cache when sources and driver match, compiles and stores it otherwise
+    static GLuint createCachedProgram(const std::vector<ShaderStage>& stages);
 
+    static bool checkLinkStatus(GLuint program) {
         // Check for linking errors
         GLint success;
         glGetProgramiv(program, GL_LINK_STATUS, &success);
@@ -51,65 +78,27 @@ public:
             char infoLog[512];
             glGetProgramInfoLog(program, 512, NULL, infoLog);
             std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-            glDeleteProgram(program);
-            program = 0;  // Return 0 to indicate failure
+            return false;
         }
-
-        // Clean up shaders after linking
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-
-        return program;
+        return true;
     }
 
-    template <typename T, typename I>
-    static void setupObjects(GLuint& VAO, GLuint& VBO, GLuint& EBO, const std::vector<T>& vertices, const std::vector<I>& indices) {
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
-
-        glBindVertexArray(VAO);
-
-        // Bind and set the vertex buffer
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(T), vertices.data(), GL_STATIC_DRAW);
-
-        // Position attribute
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(T), (void*)0);
-
-        // Color attribute
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(T), (void*)(3 * sizeof(float)));
-
-        // Normal attribute
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(T), (void*)(6 * sizeof(float)));
-
-        // Bind and set the element buffer
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(I), indices.data(), GL_STATIC_DRAW);
-
-        // Unbind the VAO
-        glBindVertexArray(0);
-
-        // Unbind the VBO and EBO to avoid accidental modifications
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    }
-
-
     // reads from current folder
     static std::string readShader(bool fragment) {
-        std::ifstream shaderFile;
-        if (fragment)
-            shaderFile.open("Triangle.fs");
-        else
-            shaderFile.open("Triangle.vs");
+        return readFile(fragment ? "Triangle.fs" : "Triangle.vs");
+    }
 
+    static std::string readFile(const std::string& path) {
+        std::ifstream shaderFile(path, std::ios::binary);
         std::string str((std::istreambuf_iterator<char>(shaderFile)),
             std::istreambuf_iterator<char>());
         return str;
     }
+
+private:
+    // FNV-1a over every stage and the driver identification strings
+    static uint64_t computeCacheKey(const std::vector<ShaderStage>& stages);
 };
 
+#endif
+
@@ -0,0 +1,726 @@
+#include "SoftwareRenderer.h"
+#include "FrameCapture.h"
+#include "ThreadPool.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define SOFTWARE_RASTER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define SOFTWARE_RASTER_AVX2
+#else
+#define SOFTWARE_RASTER_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+    // Instances per geometry job are chosen so each job sets up about this many triangles
+    const size_t JobTriangles = 4096;
+
+    // Screen coordinates stay within +-MaxScreenCoordinate pixels so edge functions fit in 32 bits inside a block
+    const float MaxScreenCoordinate = 8192.0f;
+
+    const glm::vec3 Ambient(0.25f);
+
+    // Edge functions and depth of one 8x8 block. Edges that cover the whole block have a, b and e set to zero.
+    struct BlockSetup {
+        int32_t e[3];  // At the block's first pixel
+        int32_t a[3];  // Per pixel to the right
+        int32_t b[3];  // Per row up
+        float depth;   // At the block's first pixel
+        float dzdx, dzdy;
+        uint32_t laneMask;     // Columns inside the triangle's bounds
+        int firstRow, lastRow; // Rows inside the triangle's bounds
+    };
+
+    // Reference kernel. Returns one byte per row with the pixels that are covered and pass the depth test,
+    // their depth is already written. Depth math matches the AVX2 kernel operation for operation.
+    uint64_t coverBlockScalar(const BlockSetup& s, float* depth, size_t stride) {
+        uint64_t mask = 0;
+        for (int row = s.firstRow; row <= s.lastRow; ++row) {
+            float zRow = s.depth + s.dzdy * static_cast<float>(row);
+            float* depthRow = depth + row * stride;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (!(s.laneMask & (1u << lane)))
+                    continue;
+                int32_t inside = (s.e[0] + s.a[0] * lane + s.b[0] * row) | (s.e[1] + s.a[1] * lane + s.b[1] * row) |
+                    (s.e[2] + s.a[2] * lane + s.b[2] * row);
+                if (inside < 0)
+                    continue;
+                float z = std::min(std::max(zRow + s.dzdx * static_cast<float>(lane), 0.0f), 1.0f);
+                if (z < depthRow[lane]) {
+                    depthRow[lane] = z;
+                    mask |= uint64_t(1) << (row * 8 + lane);
+                }
+            }
+        }
+        return mask;
+    }
+
+#ifdef SOFTWARE_RASTER_X86
+    // Same as coverBlockScalar, one row of 8 pixels per step
+    SOFTWARE_RASTER_AVX2 uint64_t coverBlockAVX2(const BlockSetup& s, float* depth, size_t stride) {
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256 laneOffsets = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        const __m256i laneBits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+        const __m256i columns = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int>(s.laneMask)), laneBits), laneBits);
+        const __m256 dzdx = _mm256_mul_ps(_mm256_set1_ps(s.dzdx), laneOffsets);
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+
+        __m256i e[3];
+        for (int k = 0; k < 3; ++k) {
+            e[k] = _mm256_add_epi32(_mm256_set1_epi32(s.e[k] + s.b[k] * s.firstRow), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(s.a[k])));
+        }
+
+        uint64_t mask = 0;
+        for (int row = s.firstRow; row <= s.lastRow; ++row) {
+            __m256i inside = _mm256_or_si256(_mm256_or_si256(e[0], e[1]), e[2]);
+            __m256i covered = _mm256_and_si256(_mm256_cmpgt_epi32(inside, _mm256_set1_epi32(-1)), columns);
+            for (int k = 0; k < 3; ++k)
+                e[k] = _mm256_add_epi32(e[k], _mm256_set1_epi32(s.b[k]));
+            if (_mm256_testz_si256(covered, covered))
+                continue;
+
+            float* depthRow = depth + row * stride;
+            __m256 stored = _mm256_loadu_ps(depthRow);
+            __m256 z = _mm256_add_ps(_mm256_set1_ps(s.depth + s.dzdy * static_cast<float>(row)), dzdx);
+            z = _mm256_min_ps(_mm256_max_ps(z, zero), one);
+            __m256 pass = _mm256_and_ps(_mm256_castsi256_ps(covered), _mm256_cmp_ps(z, stored, _CMP_LT_OQ));
+            _mm256_storeu_ps(depthRow, _mm256_blendv_ps(stored, z, pass));
+            mask |= static_cast<uint64_t>(_mm256_movemask_ps(pass)) << (row * 8);
+        }
+        return mask;
+    }
+#endif
+
+    typedef uint64_t (*CoverBlockFunction)(const BlockSetup&, float*, size_t);
+
+    CoverBlockFunction selectCoverBlock(bool vectorized) {
+#ifdef SOFTWARE_RASTER_X86
+        if (vectorized)
+            return &coverBlockAVX2;
+#endif
+        return &coverBlockScalar;
+    }
+
+    uint8_t toUnorm8(float value) {
+        return static_cast<uint8_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    InstanceData makeInstance(const glm::mat4& modelMatrix, const glm::vec4& color) {
+        InstanceData instance;
+        instance.model0 = modelMatrix[0];
+        instance.model1 = modelMatrix[1];
+        instance.model2 = modelMatrix[2];
+        instance.model3 = modelMatrix[3];
+        instance.color = packColor(color);
+        return instance;
+    }
+}
+
+SoftwareRenderer::SoftwareRenderer(unsigned int width, unsigned int height) {
+    setAspect(width, height);
+    clear(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+MeshAllocation SoftwareRenderer::upload(const CookedMesh& mesh) {
+    size_t vertexOffset, indexOffset;
+    while (!vertexAllocator.allocate(mesh.vertexCount, vertexOffset))
+        vertexAllocator.grow(std::max(vertexAllocator.capacity() * 2, vertexAllocator.capacity() + mesh.vertexCount));
+    while (!indexAllocator.allocate(mesh.indices.size(), indexOffset))
+        indexAllocator.grow(std::max(indexAllocator.capacity() * 2, indexAllocator.capacity() + mesh.indices.size()));
+    vertices.resize(vertexAllocator.capacity());
+    indices.resize(indexAllocator.capacity());
+
+    // Decode the GPU format once, the mesh-wide color goes back into the vertices
+    size_t stride = MeshArena::vertexStride(mesh.format);
+    glm::vec3 baseColor(mesh.baseColor);
+    for (size_t i = 0; i < mesh.vertexCount; ++i) {
+        const uint8_t* data = mesh.vertexData.data() + i * stride;
+        SourceVertex& vertex = vertices[vertexOffset + i];
+        if (mesh.format == VertexFormat::Float) {
+            Vertex3D source;
+            std::memcpy(&source, data, sizeof(source));
+            vertex.position = source.position;
+            vertex.normal = source.normal;
+            vertex.color = source.color;
+            continue;
+        }
+
+        PackedVertex source;
+        std::memcpy(&source, data, sizeof(source));
+        glm::uint64 position;
+        std::memcpy(&position, &source.position, sizeof(position));
+        vertex.position = glm::vec3(glm::unpackHalf4x16(position));
+        vertex.normal = glm::vec3(glm::unpackSnorm3x10_1x2(source.normal.bits));
+        vertex.color = baseColor;
+        if (mesh.format == VertexFormat::PackedColor) {
+            PackedColorVertex colored;
+            std::memcpy(&colored, data, sizeof(colored));
+            glm::uint32 bits;
+            std::memcpy(&bits, &colored.color, sizeof(bits));
+            vertex.color = glm::vec3(glm::unpackUnorm4x8(bits));
+        }
+    }
+    std::copy(mesh.indices.begin(), mesh.indices.end(), indices.begin() + indexOffset);
+
+    MeshAllocation allocation;
+    allocation.format = mesh.format;
+    allocation.baseVertex = static_cast<GLint>(vertexOffset);
+    allocation.vertexCount = static_cast<GLuint>(mesh.vertexCount);
+    allocation.firstIndex = static_cast<GLuint>(indexOffset);
+    allocation.indexCount = static_cast<GLsizei>(mesh.indices.size());
+    return allocation;
+}
+
+void SoftwareRenderer::free(const MeshAllocation& allocation) {
+    vertexAllocator.free(allocation.baseVertex, allocation.vertexCount);
+    indexAllocator.free(allocation.firstIndex, allocation.indexCount);
+}
+
+void SoftwareRenderer::setAspect(unsigned int newWidth, unsigned int newHeight) {
+    newWidth = std::max(1u, std::min(newWidth, static_cast<unsigned int>(MaxScreenCoordinate)));
+    newHeight = std::max(1u, std::min(newHeight, static_cast<unsigned int>(MaxScreenCoordinate)));
+    if (newWidth == width && newHeight == height)
+        return;
+
+    width = newWidth;
+    height = newHeight;
+    binsX = (width + BinSize - 1) / BinSize;
+    binsY = (height + BinSize - 1) / BinSize;
+    color.assign(static_cast<size_t>(width) * height * 4, 0);
+    // Depth is padded to whole bins so every block can be read as full rows
+    depth.assign(static_cast<size_t>(binsX) * BinSize * binsY * BinSize, 1.0f);
+    blockMaxDepth.assign(static_cast<size_t>(binsX) * binsY * (BinSize / BlockSize) * (BinSize / BlockSize), 1.0f);
+    binLights.assign(static_cast<size_t>(binsX) * binsY, {});
+}
+
+void SoftwareRenderer::clear(const glm::vec4& clearColor) {
+    uint8_t rgba[4] = { toUnorm8(clearColor.r), toUnorm8(clearColor.g), toUnorm8(clearColor.b), toUnorm8(clearColor.a) };
+    for (size_t i = 0; i < color.size(); i += 4)
+        std::memcpy(&color[i], rgba, 4);
+    std::fill(depth.begin(), depth.end(), 1.0f);
+    std::fill(blockMaxDepth.begin(), blockMaxDepth.end(), 1.0f);
+}
+
+void SoftwareRenderer::beginFrame(const Camera& camera) {
+    viewMatrix = glm::lookAt(camera.position, camera.position + camera.front, camera.up);
+    projectionMatrix = glm::perspective(glm::radians(camera.FoV), static_cast<float>(width) / height, camera.nearClip, camera.farClip);
+
+    stats = SoftwareRenderStats();
+    draws.clear();
+    instances.clear();
+    lights.clear();
+}
+
+SoftwareRenderer::InstanceBucket& SoftwareRenderer::getBucket(const MeshAllocation& mesh) {
+    uint64_t key = static_cast<uint64_t>(mesh.firstIndex) << 32 | static_cast<uint32_t>(mesh.indexCount);
+    auto it = bucketLookup.find(key);
+    if (it != bucketLookup.end())
+        return buckets[it->second];
+
+    bucketLookup[key] = buckets.size();
+    buckets.push_back({ mesh, {} });
+    return buckets.back();
+}
+
+void SoftwareRenderer::submit(const MeshAllocation& mesh, const glm::mat4& modelMatrix, const glm::vec4& instanceColor) {
+    getBucket(mesh).instances.push_back(makeInstance(modelMatrix, instanceColor));
+}
+
+void SoftwareRenderer::submit(const MeshAllocation& mesh, const TransformSoA& transforms, const glm::vec4& instanceColor) {
+    std::vector<InstanceData>& bucket = getBucket(mesh).instances;
+    size_t first = bucket.size();
+    bucket.resize(first + transforms.count);
+    if (vectorized)
+        TransformBatch::compose(transforms, bucket.data() + first, packColor(instanceColor));
+    else
+        TransformBatch::composeScalar(transforms, 0, transforms.count, bucket.data() + first, packColor(instanceColor));
+}
+
+void SoftwareRenderer::addDraw(const MeshAllocation& mesh, const InstanceData* first, size_t count) {
+    draws.push_back({ mesh, instances.size(), count });
+    instances.insert(instances.end(), first, first + count);
+
+    ++stats.drawCalls;
+    stats.instances += static_cast<unsigned int>(count);
+    stats.triangles += static_cast<size_t>(mesh.indexCount / 3) * count;
+}
+
+void SoftwareRenderer::setPositionStream(const Position* positions, size_t count) {
+    // Copied like the GL upload, the caller may reuse its array before endFrame
+    positionStream.assign(positions, positions + count);
+}
+
+void SoftwareRenderer::setStyleStream(const InstanceStyle* styles, size_t count) {
+    styleStream.assign(styles, styles + count);
+}
+
+void SoftwareRenderer::drawPositionRange(const MeshAllocation& mesh, size_t first, size_t count, const InstanceStyle& style) {
+    if (count == 0 || first + count > positionStream.size())
+        return;
+
+    // translate(x, 0, z) * scale, the transform Triangle.vs builds from the streams
+    bool styled = first + count <= styleStream.size();
+    size_t start = instances.size();
+    draws.push_back({ mesh, start, count });
+    instances.resize(start + count);
+    for (size_t i = 0; i < count; ++i) {
+        const Position& position = positionStream[first + i];
+        const InstanceStyle& instanceStyle = styled ? styleStream[first + i] : style;
+        InstanceData& instance = instances[start + i];
+        instance.model0 = glm::vec4(instanceStyle.scale, 0.0f, 0.0f, 0.0f);
+        instance.model1 = glm::vec4(0.0f, instanceStyle.scale, 0.0f, 0.0f);
+        instance.model2 = glm::vec4(0.0f, 0.0f, instanceStyle.scale, 0.0f);
+        instance.model3 = glm::vec4(position.x, 0.0f, position.z, 1.0f);
+        instance.color = instanceStyle.color;
+    }
+
+    ++stats.drawCalls;
+    stats.instances += static_cast<unsigned int>(count);
+    stats.triangles += static_cast<size_t>(mesh.indexCount / 3) * count;
+}
+
+void SoftwareRenderer::setLights(const std::vector<PointLight>& frameLights) {
+    lights = frameLights;
+    for (PointLight& light : lights)
+        light.color *= light.intensity;
+}
+
+void SoftwareRenderer::endFrame() {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Queued instances are drawn after the position ranges, as on the GPU path
+    for (InstanceBucket& bucket : buckets) {
+        if (!bucket.instances.empty())
+            addDraw(bucket.mesh, bucket.instances.data(), bucket.instances.size());
+        bucket.instances.clear();
+    }
+
+    // Cut the draws into jobs of similar triangle counts, independent of the thread count
+    size_t jobCount = 0;
+    for (size_t d = 0; d < draws.size(); ++d) {
+        size_t trianglesPerInstance = static_cast<size_t>(draws[d].mesh.indexCount / 3);
+        if (trianglesPerInstance == 0)
+            continue;
+        size_t perJob = std::max<size_t>(1, JobTriangles / trianglesPerInstance);
+        for (size_t first = 0; first < draws[d].instanceCount; first += perJob) {
+            if (jobCount == jobs.size())
+                jobs.emplace_back();
+            GeometryJob& job = jobs[jobCount++];
+            job.draw = d;
+            job.firstInstance = first;
+            job.instanceCount = std::min(perJob, draws[d].instanceCount - first);
+        }
+    }
+
+    ThreadPool& pool = threadPool ? *threadPool : ThreadPool::instance();
+    pool.parallelFor(jobCount, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            runGeometry(jobs[i]);
+    });
+    for (size_t i = 0; i < jobCount; ++i) {
+        stats.trianglesRasterized += jobs[i].triangles.size();
+        stats.trianglesClipped += jobs[i].trianglesClipped;
+        for (const std::vector<uint32_t>& bin : jobs[i].bins)
+            stats.binEntries += bin.size();
+    }
+    binLightsToScreen();
+
+    auto geometryEnd = std::chrono::high_resolution_clock::now();
+
+    std::atomic<size_t> blocksTested(0), blocksRejected(0), pixelsShaded(0);
+    size_t binCount = static_cast<size_t>(binsX) * binsY;
+    pool.parallelFor(binCount, [&](size_t begin, size_t end) {
+        size_t tested = 0, rejected = 0, shaded = 0;
+        for (size_t bin = begin; bin < end; ++bin)
+            rasterizeBin(static_cast<unsigned int>(bin % binsX), static_cast<unsigned int>(bin / binsX), jobCount, tested, rejected, shaded);
+        blocksTested += tested;
+        blocksRejected += rejected;
+        pixelsShaded += shaded;
+    });
+
+    auto rasterEnd = std::chrono::high_resolution_clock::now();
+    stats.blocksTested = blocksTested;
+    stats.blocksHiZRejected = blocksRejected;
+    stats.pixelsShaded = pixelsShaded;
+    stats.geometryMs = std::chrono::duration<float, std::milli>(geometryEnd - start).count();
+    stats.rasterMs = std::chrono::duration<float, std::milli>(rasterEnd - geometryEnd).count();
+
+    // Forget meshes nobody drew this frame
+    for (size_t i = 0; i < buckets.size();) {
+        if (draws.empty() || std::none_of(draws.begin(), draws.end(), [&](const Draw& draw) {
+            return draw.mesh.firstIndex == buckets[i].mesh.firstIndex && draw.mesh.indexCount == buckets[i].mesh.indexCount; })) {
+            buckets[i] = std::move(buckets.back());
+            buckets.pop_back();
+            continue;
+        }
+        ++i;
+    }
+    bucketLookup.clear();
+    for (size_t i = 0; i < buckets.size(); ++i)
+        bucketLookup[static_cast<uint64_t>(buckets[i].mesh.firstIndex) << 32 | static_cast<uint32_t>(buckets[i].mesh.indexCount)] = i;
+}
+
+void SoftwareRenderer::runGeometry(GeometryJob& job) const {
+    job.triangles.clear();
+    job.bins.resize(static_cast<size_t>(binsX) * binsY);
+    for (std::vector<uint32_t>& bin : job.bins)
+        bin.clear();
+    job.trianglesClipped = 0;
+
+    const Draw& draw = draws[job.draw];
+    const SourceVertex* source = vertices.data() + draw.mesh.baseVertex;
+    const uint32_t* meshIndices = indices.data() + draw.mesh.firstIndex;
+    glm::mat4 viewProjection = projectionMatrix * viewMatrix;
+
+    // Guard band in NDC, clipping against it keeps every snapped coordinate within MaxScreenCoordinate
+    glm::vec2 guard(2.0f * MaxScreenCoordinate / width - 1.0f, 2.0f * MaxScreenCoordinate / height - 1.0f);
+    const glm::vec4 planes[6] = {
+        glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), glm::vec4(0.0f, 0.0f, -1.0f, 1.0f), // Near, far
+        glm::vec4(1.0f, 0.0f, 0.0f, guard.x), glm::vec4(-1.0f, 0.0f, 0.0f, guard.x),
+        glm::vec4(0.0f, 1.0f, 0.0f, guard.y), glm::vec4(0.0f, -1.0f, 0.0f, guard.y)
+    };
+
+    job.transformed.resize(draw.mesh.vertexCount);
+    for (size_t i = 0; i < job.instanceCount; ++i) {
+        const InstanceData& instance = instances[draw.firstInstance + job.firstInstance + i];
+        glm::mat4 model(instance.model0, instance.model1, instance.model2, instance.model3);
+        glm::mat3 normalMatrix(model);
+        glm::vec3 instanceColor = glm::vec3(instance.color.r, instance.color.g, instance.color.b) / 255.0f;
+
+        // Triangle.vs
+        for (size_t v = 0; v < draw.mesh.vertexCount; ++v) {
+            ClipVertex& out = job.transformed[v];
+            glm::vec4 world = model * glm::vec4(source[v].position, 1.0f);
+            out.worldPosition = glm::vec3(world);
+            out.worldNormal = normalMatrix * source[v].normal;
+            out.color = source[v].color * instanceColor;
+            out.position = viewProjection * world;
+        }
+
+        for (GLsizei t = 0; t + 2 < draw.mesh.indexCount; t += 3) {
+            const ClipVertex* corners[3] = { &job.transformed[meshIndices[t]], &job.transformed[meshIndices[t + 1]], &job.transformed[meshIndices[t + 2]] };
+
+            // Reject against the view frustum, clip only against planes some corner is outside of
+            unsigned int outsideAll = 0x3F, outsideAny = 0;
+            for (const ClipVertex* corner : corners) {
+                const glm::vec4& p = corner->position;
+                unsigned int frustum = (p.x < -p.w) | (p.x > p.w) << 1 | (p.y < -p.w) << 2 | (p.y > p.w) << 3 | (p.z < -p.w) << 4 | (p.z > p.w) << 5;
+                outsideAll &= frustum;
+                for (int k = 0; k < 6; ++k) {
+                    if (glm::dot(planes[k], p) < 0.0f)
+                        outsideAny |= 1u << k;
+                }
+            }
+            if (outsideAll)
+                continue;
+            if (!outsideAny) {
+                setupTriangle(job, *corners[0], *corners[1], *corners[2]);
+                continue;
+            }
+
+            // Sutherland-Hodgman, clip space attributes interpolate linearly
+            ClipVertex polygon[2][9];
+            int count = 3;
+            for (int k = 0; k < 3; ++k)
+                polygon[0][k] = *corners[k];
+            int current = 0;
+            for (int k = 0; k < 6 && count >= 3; ++k) {
+                if (!(outsideAny & (1u << k)))
+                    continue;
+                const ClipVertex* in = polygon[current];
+                ClipVertex* out = polygon[current ^ 1];
+                int outCount = 0;
+                for (int j = 0; j < count; ++j) {
+                    const ClipVertex& a = in[j];
+                    const ClipVertex& b = in[(j + 1) % count];
+                    float da = glm::dot(planes[k], a.position), db = glm::dot(planes[k], b.position);
+                    if (da >= 0.0f)
+                        out[outCount++] = a;
+                    if ((da >= 0.0f) != (db >= 0.0f)) {
+                        float f = da / (da - db);
+                        ClipVertex& c = out[outCount++];
+                        c.position = glm::mix(a.position, b.position, f);
+                        c.color = glm::mix(a.color, b.color, f);
+                        c.worldPosition = glm::mix(a.worldPosition, b.worldPosition, f);
+                        c.worldNormal = glm::mix(a.worldNormal, b.worldNormal, f);
+                    }
+                }
+                count = outCount;
+                current ^= 1;
+            }
+            ++job.trianglesClipped;
+            for (int k = 1; k + 1 < count; ++k)
+                setupTriangle(job, polygon[current][0], polygon[current][k], polygon[current][k + 1]);
+        }
+    }
+}
+
+void SoftwareRenderer::setupTriangle(GeometryJob& job, const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2) const {
+    const ClipVertex* corners[3] = { &v0, &v1, &v2 };
+
+    // Perspective divide and viewport transform into GL window coordinates, y up
+    float invW[3], z[3];
+    int64_t fixedX[3], fixedY[3];
+    for (int k = 0; k < 3; ++k) {
+        const glm::vec4& p = corners[k]->position;
+        invW[k] = 1.0f / p.w;
+        float sx = (p.x * invW[k] * 0.5f + 0.5f) * width;
+        float sy = (p.y * invW[k] * 0.5f + 0.5f) * height;
+        z[k] = p.z * invW[k] * 0.5f + 0.5f;
+        fixedX[k] = static_cast<int64_t>(std::floor(sx * (1 << SubpixelBits) + 0.5f));
+        fixedY[k] = static_cast<int64_t>(std::floor(sy * (1 << SubpixelBits) + 0.5f));
+    }
+
+    // Counter-clockwise from here on, there is no face culling
+    int64_t area = (fixedX[1] - fixedX[0]) * (fixedY[2] - fixedY[0]) - (fixedY[1] - fixedY[0]) * (fixedX[2] - fixedX[0]);
+    if (area == 0)
+        return;
+    if (area < 0) {
+        std::swap(corners[1], corners[2]);
+        std::swap(invW[1], invW[2]);
+        std::swap(z[1], z[2]);
+        std::swap(fixedX[1], fixedX[2]);
+        std::swap(fixedY[1], fixedY[2]);
+        area = -area;
+    }
+
+    // Pixels whose centers can be covered
+    const int64_t half = 1 << (SubpixelBits - 1);
+    int64_t minFixedX = std::min({ fixedX[0], fixedX[1], fixedX[2] }), maxFixedX = std::max({ fixedX[0], fixedX[1], fixedX[2] });
+    int64_t minFixedY = std::min({ fixedY[0], fixedY[1], fixedY[2] }), maxFixedY = std::max({ fixedY[0], fixedY[1], fixedY[2] });
+    RasterTriangle triangle;
+    triangle.minX = static_cast<int>(std::max<int64_t>((minFixedX - half + (1 << SubpixelBits) - 1) >> SubpixelBits, 0));
+    triangle.minY = static_cast<int>(std::max<int64_t>((minFixedY - half + (1 << SubpixelBits) - 1) >> SubpixelBits, 0));
+    triangle.maxX = static_cast<int>(std::min<int64_t>((maxFixedX - half) >> SubpixelBits, width - 1));
+    triangle.maxY = static_cast<int>(std::min<int64_t>((maxFixedY - half) >> SubpixelBits, height - 1));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+        return;
+
+    // Edge k runs from corner k to k + 1, rescaled so x and y are whole pixels sampled at their centers.
+    // Top-left rule: an edge exactly through a pixel center owns it on one side of a shared edge only.
+    for (int k = 0; k < 3; ++k) {
+        int next = (k + 1) % 3;
+        int64_t a = fixedY[k] - fixedY[next];
+        int64_t b = fixedX[next] - fixedX[k];
+        int64_t c = -(a * fixedX[k] + b * fixedY[k]);
+        bool topLeft = a > 0 || (a == 0 && b < 0);
+        triangle.edgeA[k] = static_cast<int32_t>(a << SubpixelBits);
+        triangle.edgeB[k] = static_cast<int32_t>(b << SubpixelBits);
+        triangle.edgeC[k] = c + (a + b) * half - (topLeft ? 0 : 1);
+    }
+
+    // Planes through the snapped corners, relative to the first one
+    float px[3], py[3];
+    for (int k = 0; k < 3; ++k) {
+        px[k] = static_cast<float>(fixedX[k]) / (1 << SubpixelBits);
+        py[k] = static_cast<float>(fixedY[k]) / (1 << SubpixelBits);
+    }
+    float x1 = px[1] - px[0], y1 = py[1] - py[0], x2 = px[2] - px[0], y2 = py[2] - py[0];
+    float inverseArea = 1.0f / (x1 * y2 - x2 * y1);
+    auto plane = [&](float q0, float q1, float q2, float* out) {
+        out[0] = q0;
+        out[1] = ((q1 - q0) * y2 - (q2 - q0) * y1) * inverseArea;
+        out[2] = ((q2 - q0) * x1 - (q1 - q0) * x2) * inverseArea;
+    };
+
+    triangle.originX = px[0];
+    triangle.originY = py[0];
+    plane(z[0], z[1], z[2], triangle.depth);
+    triangle.minDepth = std::min({ z[0], z[1], z[2] });
+
+    plane(invW[0], invW[1], invW[2], triangle.varyings[0]);
+    for (int c = 0; c < 3; ++c) {
+        plane(corners[0]->color[c] * invW[0], corners[1]->color[c] * invW[1], corners[2]->color[c] * invW[2], triangle.varyings[1 + c]);
+        plane(corners[0]->worldPosition[c] * invW[0], corners[1]->worldPosition[c] * invW[1], corners[2]->worldPosition[c] * invW[2], triangle.varyings[4 + c]);
+        plane(corners[0]->worldNormal[c] * invW[0], corners[1]->worldNormal[c] * invW[1], corners[2]->worldNormal[c] * invW[2], triangle.varyings[7 + c]);
+    }
+
+    uint32_t index = static_cast<uint32_t>(job.triangles.size());
+    job.triangles.push_back(triangle);
+    for (unsigned int by = triangle.minY / BinSize; by <= static_cast<unsigned int>(triangle.maxY) / BinSize; ++by) {
+        for (unsigned int bx = triangle.minX / BinSize; bx <= static_cast<unsigned int>(triangle.maxX) / BinSize; ++bx)
+            job.bins[by * binsX + bx].push_back(index);
+    }
+}
+
+void SoftwareRenderer::binLightsToScreen() {
+    for (std::vector<uint32_t>& list : binLights)
+        list.clear();
+    keyLightDirection = glm::normalize(lightPos);
+
+    glm::mat4 viewProjection = projectionMatrix * viewMatrix;
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const PointLight& light = lights[i];
+        if (light.radius <= 0.0f)
+            continue;
+
+        // Screen bounds of the sphere's box, the whole screen when it reaches behind the camera
+        glm::vec2 low(0.0f), high(static_cast<float>(width), static_cast<float>(height));
+        bool bounded = true, visible = false;
+        glm::vec2 boxLow(1e30f), boxHigh(-1e30f);
+        for (int corner = 0; corner < 8 && bounded; ++corner) {
+            glm::vec3 offset((corner & 1) ? light.radius : -light.radius, (corner & 2) ? light.radius : -light.radius, (corner & 4) ? light.radius : -light.radius);
+            glm::vec4 clip = viewProjection * glm::vec4(light.position + offset, 1.0f);
+            if (clip.w <= 1e-4f) {
+                bounded = false;
+                break;
+            }
+            glm::vec2 screen((clip.x / clip.w * 0.5f + 0.5f) * width, (clip.y / clip.w * 0.5f + 0.5f) * height);
+            boxLow = glm::min(boxLow, screen);
+            boxHigh = glm::max(boxHigh, screen);
+            visible |= clip.z <= clip.w;
+        }
+        if (bounded) {
+            if (!visible)
+                continue;
+            low = glm::max(low, boxLow);
+            high = glm::min(high, boxHigh);
+            if (low.x > high.x || low.y > high.y)
+                continue;
+        }
+
+        int binX0 = static_cast<int>(low.x) / static_cast<int>(BinSize), binY0 = static_cast<int>(low.y) / static_cast<int>(BinSize);
+        int binX1 = std::min(static_cast<int>(high.x) / static_cast<int>(BinSize), static_cast<int>(binsX) - 1);
+        int binY1 = std::min(static_cast<int>(high.y) / static_cast<int>(BinSize), static_cast<int>(binsY) - 1);
+        for (int by = binY0; by <= binY1; ++by) {
+            for (int bx = binX0; bx <= binX1; ++bx)
+                binLights[by * binsX + bx].push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void SoftwareRenderer::rasterizeBin(unsigned int binX, unsigned int binY, size_t jobCount, size_t& blocksTested, size_t& blocksRejected, size_t& pixelsShaded) {
+    const CoverBlockFunction coverBlock = selectCoverBlock(vectorized);
+
+    size_t bin = static_cast<size_t>(binY) * binsX + binX;
+    const std::vector<uint32_t>& lightList = binLights[bin];
+    const int binLeft = binX * BinSize, binBottom = binY * BinSize;
+    const int binRight = std::min(binLeft + static_cast<int>(BinSize), static_cast<int>(width)) - 1;
+    const int binTop = std::min(binBottom + static_cast<int>(BinSize), static_cast<int>(height)) - 1;
+    const size_t depthStride = static_cast<size_t>(binsX) * BinSize;
+    const size_t blocksPerRow = static_cast<size_t>(binsX) * (BinSize / BlockSize);
+
+    for (size_t j = 0; j < jobCount; ++j) {
+        const GeometryJob& job = jobs[j];
+        for (uint32_t index : job.bins[bin]) {
+            const RasterTriangle& triangle = job.triangles[index];
+            int left = std::max(triangle.minX, binLeft), right = std::min(triangle.maxX, binRight);
+            int bottom = std::max(triangle.minY, binBottom), top = std::min(triangle.maxY, binTop);
+
+            for (int blockY = bottom & ~static_cast<int>(BlockSize - 1); blockY <= top; blockY += BlockSize) {
+                for (int blockX = left & ~static_cast<int>(BlockSize - 1); blockX <= right; blockX += BlockSize) {
+                    ++blocksTested;
+                    float& blockMax = blockMaxDepth[(blockY / BlockSize) * blocksPerRow + blockX / BlockSize];
+                    if (triangle.minDepth >= blockMax) {
+                        ++blocksRejected;
+                        continue;
+                    }
+
+                    // Classify each edge over the block's pixel centers: outside rejects, fully inside drops the test
+                    BlockSetup setup;
+                    bool outside = false;
+                    for (int k = 0; k < 3 && !outside; ++k) {
+                        int64_t e = static_cast<int64_t>(triangle.edgeA[k]) * blockX + static_cast<int64_t>(triangle.edgeB[k]) * blockY + triangle.edgeC[k];
+                        int64_t spanX = static_cast<int64_t>(triangle.edgeA[k]) * (BlockSize - 1);
+                        int64_t spanY = static_cast<int64_t>(triangle.edgeB[k]) * (BlockSize - 1);
+                        int64_t low = e + std::min<int64_t>(spanX, 0) + std::min<int64_t>(spanY, 0);
+                        int64_t high = e + std::max<int64_t>(spanX, 0) + std::max<int64_t>(spanY, 0);
+                        if (high < 0) {
+                            outside = true;
+                        }
+                        else if (low >= 0) {
+                            setup.e[k] = setup.a[k] = setup.b[k] = 0;
+                        }
+                        else {
+                            setup.e[k] = static_cast<int32_t>(e);
+                            setup.a[k] = triangle.edgeA[k];
+                            setup.b[k] = triangle.edgeB[k];
+                        }
+                    }
+                    if (outside)
+                        continue;
+
+                    float fx = blockX + 0.5f - triangle.originX, fy = blockY + 0.5f - triangle.originY;
+                    setup.depth = triangle.depth[0] + triangle.depth[1] * fx + triangle.depth[2] * fy;
+                    setup.dzdx = triangle.depth[1];
+                    setup.dzdy = triangle.depth[2];
+                    int firstColumn = std::max(left - blockX, 0), lastColumn = std::min(right - blockX, static_cast<int>(BlockSize) - 1);
+                    setup.laneMask = ((1u << (lastColumn + 1)) - 1) & ~((1u << firstColumn) - 1);
+                    setup.firstRow = std::max(bottom - blockY, 0);
+                    setup.lastRow = std::min(top - blockY, static_cast<int>(BlockSize) - 1);
+
+                    float* blockDepth = depth.data() + static_cast<size_t>(blockY) * depthStride + blockX;
+                    uint64_t covered = coverBlock(setup, blockDepth, depthStride);
+                    if (!covered)
+                        continue;
+
+                    for (int pixel = 0; pixel < 64; ++pixel) {
+                        if (!(covered >> pixel & 1))
+                            continue;
+                        shadePixel(triangle, lightList, blockX + (pixel & 7), blockY + (pixel >> 3));
+                        ++pixelsShaded;
+                    }
+
+                    float farthest = 0.0f;
+                    for (unsigned int row = 0; row < BlockSize; ++row) {
+                        for (unsigned int column = 0; column < BlockSize; ++column)
+                            farthest = std::max(farthest, blockDepth[row * depthStride + column]);
+                    }
+                    blockMax = farthest;
+                }
+            }
+        }
+    }
+}
+
+void SoftwareRenderer::shadePixel(const RasterTriangle& triangle, const std::vector<uint32_t>& lightList, int x, int y) {
+    float fx = x + 0.5f - triangle.originX, fy = y + 0.5f - triangle.originY;
+    float values[RasterTriangle::Varyings];
+    for (int i = 0; i < RasterTriangle::Varyings; ++i)
+        values[i] = triangle.varyings[i][0] + triangle.varyings[i][1] * fx + triangle.varyings[i][2] * fy;
+    float w = 1.0f / values[0];
+    glm::vec3 ourColor = glm::vec3(values[1], values[2], values[3]) * w;
+    glm::vec3 worldPosition = glm::vec3(values[4], values[5], values[6]) * w;
+    glm::vec3 worldNormal = glm::vec3(values[7], values[8], values[9]) * w;
+
+    // Triangle.fs
+    glm::vec3 normal = glm::normalize(worldNormal);
+    glm::vec3 lighting = Ambient + lightColor * std::max(glm::dot(normal, keyLightDirection), 0.0f);
+    for (uint32_t index : lightList) {
+        const PointLight& light = lights[index];
+        glm::vec3 toLight = light.position - worldPosition;
+        float distanceSquared = glm::dot(toLight, toLight);
+        float radiusSquared = light.radius * light.radius;
+        if (distanceSquared >= radiusSquared)
+            continue;
+
+        float window = 1.0f - distanceSquared / radiusSquared;
+        float attenuation = window * window / (1.0f + distanceSquared);
+        float diffuse = std::max(glm::dot(normal, toLight / std::sqrt(std::max(distanceSquared, 1e-4f))), 0.0f);
+        lighting += light.color * attenuation * diffuse;
+    }
+
+    glm::vec3 result = ourColor * lighting;
+    uint8_t* pixel = &color[(static_cast<size_t>(y) * width + x) * 4];
+    pixel[0] = toUnorm8(result.r);
+    pixel[1] = toUnorm8(result.g);
+    pixel[2] = toUnorm8(result.b);
+    pixel[3] = 255;
+}
+
+bool SoftwareRenderer::savePNG(const std::string& path) const {
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    std::vector<unsigned char> topDown(color.size());
+    for (unsigned int row = 0; row < height; ++row)
+        std::memcpy(&topDown[row * rowBytes], &color[(height - 1 - row) * rowBytes], rowBytes);
+    return FrameCapture::writePNG(path, static_cast<int>(width), static_cast<int>(height), topDown);
+}
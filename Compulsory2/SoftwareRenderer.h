@@ -0,0 +1,180 @@
+#ifndef SOFTWARE_RENDERER_H
+#define SOFTWARE_RENDERER_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Camera.h"
+#include "ClusteredLighting.h"
+#include "MeshArena.h"
+#include "TransformBatch.h"
+
+class ThreadPool;
+
+// Counters and stage timings of one software frame, a CPU cost model of the scene
+struct SoftwareRenderStats {
+    unsigned int drawCalls{ 0 };
+    unsigned int instances{ 0 };
+    size_t triangles{ 0 };           // Submitted
+    size_t trianglesRasterized{ 0 }; // After frustum rejection, clipping and zero-area removal
+    size_t trianglesClipped{ 0 };    // Crossed the near, far or guard band planes
+    size_t binEntries{ 0 };          // Triangle references over all bins
+    size_t blocksTested{ 0 };        // 8x8 blocks a triangle's bounds touched
+    size_t blocksHiZRejected{ 0 };   // Of those, skipped because the block was already nearer
+    size_t pixelsShaded{ 0 };
+    float geometryMs{ 0.0f };        // Vertex transform, clipping, setup and binning
+    float rasterMs{ 0.0f };          // Coverage, depth and shading
+};
+
+// CPU backend with the Renderer submission API, for machines without a GPU.
+// Renders the Triangle.vs/Triangle.fs look: per-pixel key light plus windowed point lights, GL_LESS depth,
+// no face culling. The frame is split into 64x64 bins rendered in parallel; inside a bin, triangles are
+// walked in submission order over 8x8 blocks, each block first checked against its farthest depth (Hi-Z)
+// and then rasterized one 8-pixel row at a time with fixed-point edge functions (AVX2 when available).
+// Output only depends on the submissions, never on the thread count or instruction set.
+class SoftwareRenderer {
+public:
+    explicit SoftwareRenderer(unsigned int width = 800, unsigned int height = 600);
+
+    // Meshes go through MeshArena::cook so positions and normals are quantized exactly as on the GPU path.
+    // The returned allocations are only meaningful to this renderer.
+    MeshAllocation upload(const Mesh3D& mesh) { return upload(MeshArena::cook(mesh)); }
+    MeshAllocation upload(const CookedMesh& mesh);
+    void free(const MeshAllocation& allocation);
+
+    // Fills the color target and resets depth to the far plane, like glClear
+    void clear(const glm::vec4& color);
+
+    // Same contract as Renderer, everything is rasterized in endFrame in the order it was drawn
+    void beginFrame(const Camera& camera);
+    void submit(const MeshAllocation& mesh, const glm::mat4& modelMatrix, const glm::vec4& color);
+    void submit(const MeshAllocation& mesh, const TransformSoA& transforms, const glm::vec4& color);
+    void endFrame();
+
+    void setPositionStream(const Position* positions, size_t count);
+    void setStyleStream(const InstanceStyle* styles, size_t count);
+    void drawPositionRange(const MeshAllocation& mesh, size_t first, size_t count, const InstanceStyle& style);
+
+    void setLights(const std::vector<PointLight>& lights);
+
+    // Geometry jobs and bins run on ThreadPool::instance() unless another pool is set
+    void setThreadPool(ThreadPool* pool) { threadPool = pool; }
+    // AVX2 kernels when the CPU has them, off forces the scalar ones. The image is the same either way.
+    void setVectorized(bool enabled) { vectorized = enabled && TransformBatch::hasAVX2(); }
+    bool isVectorized() const { return vectorized; }
+
+    // Resizes the render target, contents are undefined until the next clear
+    void setAspect(unsigned int width, unsigned int height);
+    unsigned int getWidth() const { return width; }
+    unsigned int getHeight() const { return height; }
+
+    // RGBA8, rows bottom-up like glReadPixels
+    const std::vector<uint8_t>& getColorBuffer() const { return color; }
+    bool savePNG(const std::string& path) const;
+
+    const SoftwareRenderStats& getStats() const { return stats; }
+    glm::mat4 getViewProjection() const { return projectionMatrix * viewMatrix; }
+    const glm::mat4& getViewMatrix() const { return viewMatrix; }
+    const glm::mat4& getProjectionMatrix() const { return projectionMatrix; }
+
+    // Distant key light: lightPos is the direction towards it
+    glm::vec3 lightPos = glm::vec3(0.3f, 1.0f, 0.2f);
+    glm::vec3 lightColor = glm::vec3(0.8f, 0.8f, 0.8f);
+
+    static const unsigned int BinSize = 64;
+    static const unsigned int BlockSize = 8;
+    static const int SubpixelBits = 4;
+
+private:
+    // Mesh vertex decoded once at upload: Triangle.vs inputs before the instance transform
+    struct SourceVertex {
+        glm::vec3 position;
+        glm::vec3 normal;
+        glm::vec3 color;
+    };
+
+    // Triangle.vs output in clip space
+    struct ClipVertex {
+        glm::vec4 position;
+        glm::vec3 color;
+        glm::vec3 worldPosition;
+        glm::vec3 worldNormal;
+    };
+
+    // Screen-space triangle ready for any bin: edges in fixed point, everything else as planes
+    struct RasterTriangle {
+        int32_t edgeA[3], edgeB[3]; // E(x, y) = A * x + B * y + C in subpixels, inside when E >= 0
+        int64_t edgeC[3];           // Fill rule bias included
+        int minX, minY, maxX, maxY; // Pixel bounds, inclusive, clamped to the target
+        float originX, originY;     // Planes are relative to the first vertex
+        float depth[3];             // Value at origin, d/dx, d/dy
+        float minDepth;
+        static const int Varyings = 10; // 1/w, then color, world position and world normal divided by w
+        float varyings[Varyings][3];
+    };
+
+    // Consecutive instances of one draw. Each job bins its own triangles so geometry runs in parallel
+    // while bins still see triangles in submission order.
+    struct GeometryJob {
+        size_t draw{ 0 };
+        size_t firstInstance{ 0 }, instanceCount{ 0 };
+        std::vector<RasterTriangle> triangles;
+        std::vector<std::vector<uint32_t>> bins;
+        std::vector<ClipVertex> transformed; // Scratch for the instance being processed
+        size_t trianglesClipped{ 0 };
+    };
+
+    struct Draw {
+        MeshAllocation mesh;
+        size_t firstInstance{ 0 }, instanceCount{ 0 };
+    };
+
+    struct InstanceBucket {
+        MeshAllocation mesh;
+        std::vector<InstanceData> instances;
+    };
+
+    ThreadPool* threadPool{ nullptr };
+    bool vectorized{ TransformBatch::hasAVX2() };
+
+    unsigned int width{ 0 }, height{ 0 };
+    unsigned int binsX{ 0 }, binsY{ 0 };
+    std::vector<uint8_t> color;
+    std::vector<float> depth;
+    std::vector<float> blockMaxDepth; // Hi-Z, farthest depth stored in each 8x8 block
+
+    // Mesh storage, allocation offsets index these directly
+    FreeListAllocator vertexAllocator, indexAllocator;
+    std::vector<SourceVertex> vertices;
+    std::vector<uint32_t> indices;
+
+    glm::mat4 viewMatrix{ 1.0f }, projectionMatrix{ 1.0f };
+
+    std::vector<PointLight> lights; // Color premultiplied by intensity
+    glm::vec3 keyLightDirection{ 0.0f, 1.0f, 0.0f };
+    std::vector<std::vector<uint32_t>> binLights;
+
+    // Frame submissions
+    std::vector<Draw> draws;
+    std::vector<InstanceData> instances;
+    std::vector<InstanceBucket> buckets;
+    std::unordered_map<uint64_t, size_t> bucketLookup;
+    std::vector<Position> positionStream;
+    std::vector<InstanceStyle> styleStream;
+
+    std::vector<GeometryJob> jobs;
+    SoftwareRenderStats stats;
+
+    InstanceBucket& getBucket(const MeshAllocation& mesh);
+    void addDraw(const MeshAllocation& mesh, const InstanceData* first, size_t count);
+
+    void runGeometry(GeometryJob& job) const;
+    void setupTriangle(GeometryJob& job, const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2) const;
+    void binLightsToScreen();
+    void rasterizeBin(unsigned int binX, unsigned int binY, size_t jobCount, size_t& blocksTested, size_t& blocksRejected, size_t& pixelsShaded);
+    void shadePixel(const RasterTriangle& triangle, const std::vector<uint32_t>& lightList, int x, int y);
+};
+
+#endif
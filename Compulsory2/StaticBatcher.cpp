@@ -0,0 +1,147 @@
+#include "StaticBatcher.h"
+#include "DebugDraw.h"
+#include "Renderer.h"
+#include <algorithm>
+#include <cmath>
+
+void StaticBatcher::beginRebuild() {
+    building.clear();
+}
+
+void StaticBatcher::add(const Mesh3D& mesh, const glm::mat4& transform, unsigned int material) {
+    add(std::vector<Mesh3D>{ mesh }, transform, material);
+}
+
+void StaticBatcher::add(const std::vector<Mesh3D>& levels, const glm::mat4& transform, unsigned int material) {
+    if (levels.empty() || levels[0].vertices.empty())
+        return;
+
+    // Placed and bounded by the full-detail level
+    const Mesh3D& detail = levels[0];
+    glm::vec3 localMin = detail.vertices[0].position, localMax = localMin;
+    for (const Vertex3D& vertex : detail.vertices) {
+        localMin = glm::min(localMin, vertex.position);
+        localMax = glm::max(localMax, vertex.position);
+    }
+    glm::vec3 center = glm::vec3(transform * glm::vec4((localMin + localMax) * 0.5f, 1.0f));
+
+    Cell& cell = building[cellKey(center, material)];
+    if (cell.levels.empty())
+        cell.boundsMin = cell.boundsMax = glm::vec3(transform * glm::vec4(detail.vertices[0].position, 1.0f));
+    for (const Vertex3D& vertex : detail.vertices) {
+        glm::vec3 position = glm::vec3(transform * glm::vec4(vertex.position, 1.0f));
+        cell.boundsMin = glm::min(cell.boundsMin, position);
+        cell.boundsMax = glm::max(cell.boundsMax, position);
+    }
+
+    // New levels start from the coarsest geometry merged so far
+    if (cell.levels.size() < levels.size())
+        cell.levels.resize(levels.size(), cell.levels.empty() ? Mesh3D() : cell.levels.back());
+
+    // Normals go through the inverse transpose so non-uniform scale keeps them perpendicular
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+    // A mirroring transform flips the winding, swap two corners to keep triangles front facing
+    bool mirrored = glm::determinant(glm::mat3(transform)) < 0.0f;
+
+    for (size_t level = 0; level < cell.levels.size(); ++level) {
+        const Mesh3D& mesh = levels[std::min(level, levels.size() - 1)];
+        Mesh3D& merged = cell.levels[level];
+        unsigned int base = static_cast<unsigned int>(merged.vertices.size());
+
+        for (const Vertex3D& vertex : mesh.vertices) {
+            glm::vec3 position = glm::vec3(transform * glm::vec4(vertex.position, 1.0f));
+            glm::vec3 normal = normalMatrix * vertex.normal;
+            float length = glm::length(normal);
+            merged.addVertex(Vertex3D(position, vertex.color, length > 0.0f ? normal / length : normal));
+        }
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            merged.addIndex(base + mesh.indices[i]);
+            merged.addIndex(base + mesh.indices[mirrored ? i + 2 : i + 1]);
+            merged.addIndex(base + mesh.indices[mirrored ? i + 1 : i + 2]);
+        }
+    }
+}
+
+size_t StaticBatcher::commit() {
+    size_t uploaded = 0;
+    for (auto& entry : building) {
+        Cell& cell = entry.second;
+        cell.hash = hashGeometry(cell.levels);
+
+        auto existing = cells.find(entry.first);
+        if (existing != cells.end() && existing->second.hash == cell.hash) {
+            cell.mesh = std::move(existing->second.mesh);
+        }
+        else {
+            std::vector<std::shared_ptr<GPUMesh>> levels;
+            for (const Mesh3D& level : cell.levels)
+                levels.push_back(std::make_shared<GPUMesh>(level));
+            // World-space geometry, so the chain is bounded around the cell center rather than the origin
+            cell.mesh = std::make_unique<GPUMeshLOD>(levels, glm::length(cell.boundsMax - cell.boundsMin) * 0.5f);
+            ++uploaded;
+        }
+        cell.levels.clear();
+    }
+
+    // Cells missing from the new build are released with the old map
+    cells.swap(building);
+    building.clear();
+    return uploaded;
+}
+
+void StaticBatcher::draw(Renderer& renderer) {
+    // Visible cells with the same color and views share all draw state, so they are merged into one batch
+    size_t batchCount = 0;
+    for (const auto& entry : cells) {
+        const Cell& cell = entry.second;
+        // Tested against every split-screen view at once, drawn only in the views that see it
+        unsigned int views = renderer.visibleViews(cell.boundsMin, cell.boundsMax);
+        if (views == 0)
+            continue;
+        DebugDraw::box(cell.boundsMin, cell.boundsMax, glm::vec3(0.9f, 0.7f, 0.2f));
+        size_t level = renderer.selectLevel(*cell.mesh, (cell.boundsMin + cell.boundsMax) * 0.5f, 1.0f);
+        const GPUMesh& mesh = cell.mesh->getLevel(level);
+
+        size_t b = 0;
+        while (b < batchCount && (batchViews[b] != views || batches[b].color != mesh.getBaseColor()))
+            ++b;
+        if (b == batchCount) {
+            if (batchCount == batches.size()) {
+                batches.emplace_back();
+                batchViews.push_back(0);
+            }
+            batches[b].parts.clear();
+            batches[b].color = mesh.getBaseColor();
+            batchViews[b] = views;
+            ++batchCount;
+        }
+        batches[b].parts.push_back(mesh.getAllocation());
+    }
+
+    for (size_t b = 0; b < batchCount; ++b)
+        renderer.submit(batches[b], batchViews[b]);
+}
+
+uint64_t StaticBatcher::cellKey(const glm::vec3& position, unsigned int material) const {
+    // 24 bits per axis covers far more than any level, the material takes the top 16
+    uint64_t x = static_cast<uint32_t>(static_cast<int32_t>(std::floor(position.x / cellSize))) & 0xFFFFFF;
+    uint64_t z = static_cast<uint32_t>(static_cast<int32_t>(std::floor(position.z / cellSize))) & 0xFFFFFF;
+    return (static_cast<uint64_t>(material) << 48) | (x << 24) | z;
+}
+
+uint64_t StaticBatcher::hashGeometry(const std::vector<Mesh3D>& levels) {
+    // FNV-1a over the raw vertex and index data
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < bytes; ++i) {
+            hash ^= p[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const Mesh3D& mesh : levels) {
+        mix(mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex3D));
+        mix(mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+    }
+    return hash;
+}
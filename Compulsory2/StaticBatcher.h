@@ -0,0 +1,64 @@
+#ifndef STATIC_BATCHER_H
+#define STATIC_BATCHER_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Mesh.h"
+#include "MeshArena.h"
+#include "MeshLOD.h"
+
+class Renderer;
+
+// Static level geometry pre-transformed into world space and merged per spatial cell and material.
+// Cells are culled against the camera frustum as a whole and pick one LOD level from their projected size,
+// the visible cells of one material are one multi-draw.
+class StaticBatcher {
+public:
+    explicit StaticBatcher(float cellSize = 16.0f) : cellSize(cellSize) {}
+
+    // Rebuild: beginRebuild, add every static mesh, commit. Cells whose merged geometry
+    // did not change keep their uploaded mesh, so regenerating a level only re-uploads what moved.
+    void beginRebuild();
+
+    // Meshes are bucketed by the cell holding their transformed center; meshes only merge with the same material
+    void add(const Mesh3D& mesh, const glm::mat4& transform, unsigned int material = 0);
+
+    // Same for a LOD chain, level N of the cell merges level N of every chain in it. A cell has as many
+    // levels as its longest chain, shorter chains and single meshes repeat their last level.
+    void add(const std::vector<Mesh3D>& levels, const glm::mat4& transform, unsigned int material = 0);
+
+    // Uploads new or changed cells and drops cells left empty, returns the number uploaded
+    size_t commit();
+
+    // Submits the cells that intersect the renderer's view frustums, visible cells of one material and
+    // the same views go out as one MeshBatch
+    void draw(Renderer& renderer);
+
+    size_t getCellCount() const { return cells.size(); }
+
+private:
+    struct Cell {
+        std::vector<Mesh3D> levels; // Merged world-space geometry per LOD level, only kept while building
+        uint64_t hash{ 0 };         // Of the merged geometry, decides whether the upload can be reused
+        glm::vec3 boundsMin{ 0.0f }, boundsMax{ 0.0f };
+        std::unique_ptr<GPUMeshLOD> mesh;
+    };
+
+    // Packs the cell coordinates and material into one key
+    uint64_t cellKey(const glm::vec3& position, unsigned int material) const;
+
+    static uint64_t hashGeometry(const std::vector<Mesh3D>& levels);
+
+    float cellSize;
+    std::unordered_map<uint64_t, Cell> cells;    // Committed
+    std::unordered_map<uint64_t, Cell> building; // Collected since beginRebuild
+
+    // Reused every draw
+    std::vector<MeshBatch> batches;
+    std::vector<unsigned int> batchViews;
+};
+
+#endif
@@ -1 +1,85 @@
 #include "Systems.h"
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+
+const size_t TransformSystem::NoParentNode;
+
+void TransformSystem::rebuildOrder(ComponentManager& componentManager) {
+    const std::vector<Transform>& transforms = componentManager.transforms;
+    size_t count = transforms.size();
+
+    // Depth of every transform by walking up its parents, a missing or cyclic parent makes it a root
+    std::vector<size_t> parentIndex(count, NoParentNode);
+    std::vector<size_t> depth(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        auto it = componentManager.transformIndices.find(transforms[i].parent);
+        if (transforms[i].parent != Transform::NoParent && it != componentManager.transformIndices.end())
+            parentIndex[i] = it->second;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        size_t node = parentIndex[i];
+        while (node != NoParentNode && depth[i] <= count) {
+            ++depth[i];
+            node = parentIndex[node];
+        }
+        if (depth[i] > count) {
+            std::cerr << "Transform hierarchy cycle at entity " << componentManager.transformEntityIDs[i] << std::endl;
+            parentIndex[i] = NoParentNode;
+            depth[i] = 0;
+        }
+    }
+
+    std::vector<size_t> sorted(count);
+    for (size_t i = 0; i < count; ++i)
+        sorted[i] = i;
+    std::stable_sort(sorted.begin(), sorted.end(), [&](size_t a, size_t b) { return depth[a] < depth[b]; });
+
+    std::vector<size_t> nodeOf(count);
+    for (size_t n = 0; n < count; ++n)
+        nodeOf[sorted[n]] = n;
+
+    order.resize(count);
+    for (size_t n = 0; n < count; ++n) {
+        size_t index = sorted[n];
+        order[n].index = index;
+        order[n].parentNode = parentIndex[index] == NoParentNode ? NoParentNode : nodeOf[parentIndex[index]];
+    }
+    changed.assign(count, 0);
+    builtVersion = componentManager.transformHierarchyVersion;
+
+    // Indices shifted, so every world matrix is recomputed once
+    for (Transform& transform : componentManager.transforms)
+        transform.dirty = true;
+}
+
+void TransformSystem::Update(float /*deltaTime*/, ComponentManager& componentManager) {
+    // Roots of entities that also have a Position follow it on the ground plane
+    componentManager.view<Position, Transform>([](unsigned int, size_t, const Position& position, Transform& transform) {
+        if (transform.parent == Transform::NoParent && (transform.position.x != position.x || transform.position.z != position.z)) {
+            transform.position.x = position.x;
+            transform.position.z = position.z;
+            transform.dirty = true;
+        }
+    });
+
+    if (builtVersion != componentManager.transformHierarchyVersion)
+        rebuildOrder(componentManager);
+
+    std::vector<Transform>& transforms = componentManager.transforms;
+    updatedCount = 0;
+    for (size_t n = 0; n < order.size(); ++n) {
+        const Node& node = order[n];
+        Transform& transform = transforms[node.index];
+        bool parentChanged = node.parentNode != NoParentNode && changed[node.parentNode];
+
+        changed[n] = transform.dirty || parentChanged;
+        if (!changed[n])
+            continue;
+
+        glm::mat4 local = glm::translate(glm::mat4(1.f), transform.position) * glm::mat4_cast(transform.rotation);
+        local = glm::scale(local, transform.scale);
+        transform.world = node.parentNode == NoParentNode ? local : transforms[order[node.parentNode].index].world * local;
+        transform.dirty = false;
+        ++updatedCount;
+    }
+}
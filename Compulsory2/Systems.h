@@ -3,12 +3,18 @@
 
 #include "Components.h"
 #include "ComponentManager.h"
-#include "WorldObject.h"
+#include "Renderer.h"
+#include "GPUCulling.h"
+#include "ParticleSystem.h"
+#include "DebugDraw.h"
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <cmath>
 #include <iostream>
 
+// Debug shapes lie just above the ground plane
+const float DebugDrawHeight = -0.95f;
+
 // Base System class
 class System {
 public:
@@ -19,11 +25,17 @@ public:
 // Input System for player input
 class InputSystem : public System {
 public:
+    // Movement keys of one player, split-screen players each get their own set
+    struct KeyBindings {
+        int forward, back, left, right;
+    };
+
     GLFWwindow* window;
     unsigned int playerEntityID;
+    KeyBindings keys;
 
-    InputSystem(GLFWwindow* window, unsigned int playerEntityID)
-        : window(window), playerEntityID(playerEntityID) {}
+    InputSystem(GLFWwindow* window, unsigned int playerEntityID, const KeyBindings& keys = { GLFW_KEY_W, GLFW_KEY_S, GLFW_KEY_A, GLFW_KEY_D })
+        : window(window), playerEntityID(playerEntityID), keys(keys) {}
 
     void Update(float deltaTime, ComponentManager& componentManager) override {
         Velocity* velocity = componentManager.getVelocity(playerEntityID);
@@ -33,13 +45,13 @@ public:
 
             const float speed = 5.f;
 
-            if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+            if (glfwGetKey(window, keys.forward) == GLFW_PRESS)
                 velocity->vz -= speed;
-            if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+            if (glfwGetKey(window, keys.back) == GLFW_PRESS)
                 velocity->vz += speed;
-            if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+            if (glfwGetKey(window, keys.left) == GLFW_PRESS)
                 velocity->vx -= speed;
-            if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+            if (glfwGetKey(window, keys.right) == GLFW_PRESS)
                 velocity->vx += speed;
         }
     }
@@ -90,6 +102,9 @@ public:
                 float speed = 2.f;
                 enemyVel->vx = direction.x * speed;
                 enemyVel->vz = direction.y * speed;
+
+                glm::vec3 from(enemyPos->x, DebugDrawHeight, enemyPos->z);
+                DebugDraw::arrow(from, from + glm::vec3(direction.x, 0.f, direction.y) * 1.5f, glm::vec3(1.f, 1.f, 0.f));
             }
         }
     }
@@ -99,15 +114,10 @@ public:
 class CombatSystem : public System {
 public:
     unsigned int playerEntityID;
-    std::vector<unsigned int>& enemyEntities;
-    std::vector<std::shared_ptr<WorldObject>>& enemyObjects;
+    ParticleSystem* particles; // Optional, hit and death effects
 
-    CombatSystem(unsigned int playerEntityID,
-        std::vector<unsigned int>& enemyEntities,
-        std::vector<std::shared_ptr<WorldObject>>& enemyObjects)
-        : playerEntityID(playerEntityID),
-        enemyEntities(enemyEntities),
-        enemyObjects(enemyObjects) {}
+    CombatSystem(unsigned int playerEntityID, ParticleSystem* particles = nullptr)
+        : playerEntityID(playerEntityID), particles(particles) {}
 
     void Update(float deltaTime, ComponentManager& componentManager) override {
         // Get player components
@@ -117,9 +127,9 @@ public:
 
         if (!playerPos || !playerDamage || !playerHealth) return;
 
-        // For each enemy
-        for (size_t i = 0; i < enemyEntities.size(); /* increment inside */) {
-            unsigned int enemyEntityID = enemyEntities[i];
+        // For each enemy, every AI entity is one
+        for (size_t i = 0; i < componentManager.aiEntityIDs.size(); /* increment inside */) {
+            unsigned int enemyEntityID = componentManager.aiEntityIDs[i];
 
             Position* enemyPos = componentManager.getPosition(enemyEntityID);
             Velocity* enemyVelocity = componentManager.getVelocity(enemyEntityID);
@@ -137,6 +147,7 @@ public:
             float distance = sqrtf(dx * dx + dz * dz);
 
             float collisionRadius = 1.0f;
+            DebugDraw::circle(glm::vec3(enemyPos->x, DebugDrawHeight, enemyPos->z), collisionRadius, glm::vec3(1.f, 0.3f, 0.3f));
 
             if (distance < collisionRadius) {
                 // Apply damage to the player
@@ -146,19 +157,18 @@ public:
                     // Can continue playing regardless
                 }
 
+                // Sparks where the two meet
+                if (particles)
+                    particles->emit(ParticleEffectType::Hit, glm::vec3((playerPos->x + enemyPos->x) * 0.5f, 0.5f, (playerPos->z + enemyPos->z) * 0.5f));
+
                 // Apply damage to enemy
                 enemyHealth->currentHealth -= playerDamage->damageAmount;
                 if (enemyHealth->currentHealth <= 0) { // Enemy is dead
-                    // Remove components
-                    componentManager.removeHealth(enemyEntityID);
-                    componentManager.removeDamage(enemyEntityID);
-                    componentManager.removePosition(enemyEntityID);
-                    componentManager.removeVelocity(enemyEntityID);
-                    componentManager.removeAI(enemyEntityID);
+                    if (particles)
+                        particles->emit(ParticleEffectType::Death, glm::vec3(enemyPos->x, 0.5f, enemyPos->z));
 
-                    // Remove from enemyEntities and enemyObjects lists
-                    enemyEntities.erase(enemyEntities.begin() + i);
-                    enemyObjects.erase(enemyObjects.begin() + i);
+                    // Remove components, along with anything the enemy carried
+                    componentManager.removeEntity(enemyEntityID);
 
                     // Enemy removed, continue without incrementing i
                     continue;
@@ -187,15 +197,10 @@ public:
 class PickupSystem : public System {
 public:
     unsigned int playerEntityID;
-    std::vector<unsigned int>& pickupEntities;
-    std::vector<std::shared_ptr<WorldObject>>& pickupObjects;
+    ParticleSystem* particles; // Optional, pickup effect
 
-    PickupSystem(unsigned int playerEntityID,
-        std::vector<unsigned int>& pickupEntities,
-        std::vector<std::shared_ptr<WorldObject>>& pickupObjects)
-        : playerEntityID(playerEntityID),
-        pickupEntities(pickupEntities),
-        pickupObjects(pickupObjects) {}
+    PickupSystem(unsigned int playerEntityID, ParticleSystem* particles = nullptr)
+        : playerEntityID(playerEntityID), particles(particles) {}
 
     void Update(float deltaTime, ComponentManager& componentManager) override {
         Position* playerPos = componentManager.getPosition(playerEntityID);
@@ -220,22 +225,17 @@ public:
             float distance = sqrtf(dx * dx + dz * dz);
 
             float collisionRadius = 1.0f;
+            DebugDraw::circle(glm::vec3(pickupPos->x, DebugDrawHeight, pickupPos->z), collisionRadius, glm::vec3(0.3f, 1.f, 0.3f));
+            DebugDraw::text(glm::vec3(pickupPos->x, 0.5f, pickupPos->z), pickup->itemName.c_str(), glm::vec3(0.3f, 1.f, 0.3f));
 
             if (distance < collisionRadius) {
                 // Add item to player's inventory
                 playerInventory->items.push_back(pickup->itemName);
+                if (particles)
+                    particles->emit(ParticleEffectType::Pickup, glm::vec3(pickupPos->x, 0.5f, pickupPos->z));
 
                 // Remove the pickup entity components
-                componentManager.removePickup(pickupEntityID);
-                componentManager.removePosition(pickupEntityID);
-
-                // Remove from rendering lists
-                auto it = std::find(pickupEntities.begin(), pickupEntities.end(), pickupEntityID);
-                if (it != pickupEntities.end()) {
-                    size_t index = std::distance(pickupEntities.begin(), it);
-                    pickupEntities.erase(it);
-                    pickupObjects.erase(pickupObjects.begin() + index);
-                }
+                componentManager.removeEntity(pickupEntityID);
 
                 // Pickup removed, iterate on same index which contains next element
                 continue;
@@ -245,4 +245,189 @@ public:
     }
 };
 
+// Transform System: world matrices for the Transform hierarchy.
+// Nodes are kept in depth order so parents are always resolved before their children, and only nodes
+// that are dirty or below a changed parent are recomputed; a static hierarchy costs one flag test per node.
+class TransformSystem : public System {
+public:
+    void Update(float deltaTime, ComponentManager& componentManager) override;
+
+    // Nodes whose world matrix was recomputed in the last Update
+    size_t getUpdatedCount() const { return updatedCount; }
+
+private:
+    struct Node {
+        size_t index;       // Into ComponentManager::transforms
+        size_t parentNode;  // Into order, NoParentNode for roots
+    };
+    static const size_t NoParentNode = ~size_t(0);
+
+    std::vector<Node> order;
+    std::vector<unsigned char> changed; // Per node, world matrix recomputed this update
+    unsigned int builtVersion{ ~0u };
+    size_t updatedCount{ 0 };
+
+    void rebuildOrder(ComponentManager& componentManager);
+};
+
+// Render System: draws every entity with Position and Renderable straight from the Position pool.
+// With a GPUCulling they are kept as its objects instead and drawn through Renderer::drawCulled.
+// Call between Renderer::beginFrame and Renderer::endFrame.
+class RenderSystem : public System {
+public:
+    Renderer& renderer;
+    GPUCulling* culling; // Only given when GPUCulling::isSupported(), null keeps the 3.3 instanced path
+
+    RenderSystem(Renderer& renderer, GPUCulling* culling = nullptr)
+        : renderer(renderer), culling(culling) {}
+
+    void Update(float deltaTime, ComponentManager& componentManager) override {
+        // Lights first, the draws below are shaded with them
+        lights.clear();
+        componentManager.view<Position, LightEmitter>([&](unsigned int, size_t, const Position& position, const LightEmitter& emitter) {
+            lights.push_back({ glm::vec3(position.x, emitter.height, position.z), emitter.radius, emitter.color, emitter.intensity });
+        });
+        renderer.setLights(lights);
+
+        if (culling)
+            drawCulled(componentManager);
+        else
+            drawPositions(componentManager);
+
+        // Entities with a Transform use its cached world matrix on the instanced matrix path
+        componentManager.view<Transform, Renderable>([&](unsigned int, size_t, const Transform& transform, const Renderable& renderable) {
+            const GPUMeshLOD& mesh = *renderable.mesh;
+            glm::mat4 model = renderable.scale == 1.f ? transform.world : glm::scale(transform.world, glm::vec3(renderable.scale));
+            size_t level = renderer.selectLevel(mesh, glm::vec3(transform.world[3]), renderable.scale);
+            const GPUMesh& gpuMesh = mesh.getLevel(level);
+            renderer.submit(gpuMesh.getAllocation(), model, gpuMesh.getBaseColor() * renderable.tint);
+        });
+    }
+
+private:
+    struct Draw {
+        const MeshAllocation* mesh;
+        size_t first, count;
+    };
+
+    // One GPUCulling object, matched against the entity set every frame
+    struct CulledEntity {
+        unsigned int entity;
+        const GPUMeshLOD* mesh;
+        glm::vec4 color;
+        glm::mat4 model;
+    };
+
+    // Position entities without a Transform, instanced straight from the Position pool
+    void drawPositions(ComponentManager& componentManager) {
+        const std::vector<Position>& positions = componentManager.positions;
+        renderer.setPositionStream(positions.data(), positions.size());
+
+        // Scale and color parallel to the Position pool, entries without a Renderable are never drawn
+        styles.resize(positions.size());
+        // Split-screen: the views that culled each entry, in the same pass
+        bool multiView = renderer.isMultiView();
+        unsigned int allViews = (1u << renderer.getViewCount()) - 1u;
+        hiddenViews.resize(multiView ? positions.size() : 0);
+
+        // Pool entries that are adjacent and use the same mesh level form one instanced draw
+        const MeshAllocation* runMesh = nullptr;
+        size_t runStart = 0, runEnd = 0;
+        draws.clear();
+
+        bool hasTransforms = !componentManager.transforms.empty();
+        componentManager.view<Position, Renderable>([&](unsigned int entityID, size_t index, const Position& position, const Renderable& renderable) {
+            // Drawn below from the Transform instead
+            if (hasTransforms && componentManager.transformIndices.count(entityID))
+                return;
+
+            const GPUMeshLOD& mesh = *renderable.mesh;
+            glm::vec3 center(position.x, 0.f, position.z);
+            if (multiView) {
+                // Seen by no view: skipped, which also ends the run
+                unsigned int views = renderer.visibleViews(center, mesh.getBoundingRadius() * renderable.scale);
+                if (views == 0)
+                    return;
+                hiddenViews[index] = static_cast<uint8_t>(allViews & ~views);
+            }
+            size_t level = renderer.selectLevel(mesh, center, renderable.scale);
+            const GPUMesh& gpuMesh = mesh.getLevel(level);
+
+            styles[index].scale = renderable.scale;
+            styles[index].color = packColor(gpuMesh.getBaseColor() * renderable.tint);
+
+            const MeshAllocation* allocation = &gpuMesh.getAllocation();
+            if (allocation != runMesh || index != runEnd) {
+                if (runMesh)
+                    draws.push_back({ runMesh, runStart, runEnd - runStart });
+                runMesh = allocation;
+                runStart = index;
+            }
+            runEnd = index + 1;
+        });
+        if (runMesh)
+            draws.push_back({ runMesh, runStart, runEnd - runStart });
+
+        renderer.setStyleStream(styles.data(), styles.size());
+        renderer.setHiddenViewsStream(hiddenViews.data(), hiddenViews.size());
+        for (const Draw& draw : draws)
+            renderer.drawPositionRange(*draw.mesh, draw.first, draw.count, styles[draw.first]);
+    }
+
+    // The same entities as GPUCulling objects; culling and LOD selection run in its compute shader.
+    // Objects persist, only moved ones are re-uploaded and the set is rebuilt when entities come or go.
+    void drawCulled(ComponentManager& componentManager) {
+        frameEntities.clear();
+        bool hasTransforms = !componentManager.transforms.empty();
+        componentManager.view<Position, Renderable>([&](unsigned int entityID, size_t, const Position& position, const Renderable& renderable) {
+            if (hasTransforms && componentManager.transformIndices.count(entityID))
+                return;
+
+            glm::mat4 model = glm::translate(glm::mat4(1.f), glm::vec3(position.x, 0.f, position.z));
+            if (renderable.scale != 1.f)
+                model = glm::scale(model, glm::vec3(renderable.scale));
+            // Every level of a chain shares the base color
+            glm::vec4 color = renderable.mesh->getLevel(0).getBaseColor() * renderable.tint;
+            frameEntities.push_back({ entityID, renderable.mesh.get(), color, model });
+
+            // Registered once and kept alive, so the address cannot be reused by a different chain
+            if (!cullMeshIds.count(renderable.mesh.get())) {
+                cullMeshIds[renderable.mesh.get()] = culling->addMesh(*renderable.mesh);
+                cullMeshes.push_back(renderable.mesh);
+            }
+        });
+
+        bool sameSet = frameEntities.size() == culledEntities.size();
+        for (size_t i = 0; sameSet && i < frameEntities.size(); ++i) {
+            const CulledEntity& now = frameEntities[i];
+            const CulledEntity& before = culledEntities[i];
+            sameSet = now.entity == before.entity && now.mesh == before.mesh && now.color == before.color;
+        }
+
+        if (sameSet) {
+            for (size_t i = 0; i < frameEntities.size(); ++i) {
+                if (frameEntities[i].model != culledEntities[i].model)
+                    culling->setTransform(static_cast<unsigned int>(i), frameEntities[i].model);
+            }
+        }
+        else {
+            culling->clear();
+            for (const CulledEntity& entity : frameEntities)
+                culling->addObject(cullMeshIds[entity.mesh], entity.model, entity.color);
+        }
+        culledEntities.swap(frameEntities);
+
+        renderer.drawCulled(*culling);
+    }
+
+    // Reused every frame
+    std::vector<InstanceStyle> styles;
+    std::vector<uint8_t> hiddenViews;
+    std::vector<Draw> draws;
+    std::vector<PointLight> lights;
+    std::vector<CulledEntity> culledEntities, frameEntities;
+    std::unordered_map<const GPUMeshLOD*, unsigned int> cullMeshIds;
+    std::vector<std::shared_ptr<GPUMeshLOD>> cullMeshes;
+};
+
 #endif
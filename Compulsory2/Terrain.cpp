@@ -0,0 +1,282 @@
+#include "Terrain.h"
+#include "ThreadPool.h"
+#include "VertexLayout.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace {
+    // Fraction of each LOD range over which vertices morph into the next level
+    const float MorphRegion = 0.3f;
+
+    float latticeValue(int x, int z, unsigned int seed) {
+        unsigned int h = static_cast<unsigned int>(x) * 374761393u + static_cast<unsigned int>(z) * 668265263u + seed * 2246822519u;
+        h = (h ^ (h >> 13)) * 1274126177u;
+        h ^= h >> 16;
+        return static_cast<float>(h & 0xFFFFFF) / static_cast<float>(0xFFFFFF);
+    }
+
+    // Smoothly interpolated lattice noise in [0, 1]
+    float valueNoise(float x, float z, unsigned int seed) {
+        int x0 = static_cast<int>(std::floor(x)), z0 = static_cast<int>(std::floor(z));
+        float fx = x - x0, fz = z - z0;
+        fx = fx * fx * (3.0f - 2.0f * fx);
+        fz = fz * fz * (3.0f - 2.0f * fz);
+        float a = latticeValue(x0, z0, seed), b = latticeValue(x0 + 1, z0, seed);
+        float c = latticeValue(x0, z0 + 1, seed), d = latticeValue(x0 + 1, z0 + 1, seed);
+        return glm::mix(glm::mix(a, b, fx), glm::mix(c, d, fx), fz);
+    }
+}
+
+Terrain::Terrain(float spacing)
+    : spacing(spacing),
+    samples((GridResolution << (LODLevels - 1)) + 1),
+    extent(spacing * (GridResolution << (LODLevels - 1))),
+    origin(-0.5f * extent) {
+    // Each level reaches twice as far as the one below it
+    float range = 2.0f * GridResolution * spacing;
+    for (int level = 0; level < LODLevels; ++level) {
+        lodRanges[level] = range;
+        range *= 2.0f;
+    }
+}
+
+void Terrain::generate(unsigned int seed, float flatExtent, float flatHeight) {
+    heights.assign(static_cast<size_t>(samples) * samples, flatHeight);
+    ThreadPool::instance().parallelFor(static_cast<size_t>(samples), [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            for (int column = 0; column < samples; ++column) {
+                float x = origin.x + column * spacing;
+                float z = origin.y + row * spacing;
+
+                // Four octaves of hills, the first about 64 units across
+                float hills = 0.0f, amplitude = 12.0f, frequency = 1.0f / 64.0f;
+                for (int octave = 0; octave < 4; ++octave) {
+                    hills += valueNoise(x * frequency, z * frequency, seed + octave) * amplitude;
+                    amplitude *= 0.45f;
+                    frequency *= 2.0f;
+                }
+
+                // The arena stays flat and the hills rise over the 16 units around it
+                float distance = std::max(std::fabs(x), std::fabs(z));
+                float t = glm::clamp((distance - flatExtent) / 16.0f, 0.0f, 1.0f);
+                heights[row * samples + column] = flatHeight + hills * t * t * (3.0f - 2.0f * t);
+            }
+        }
+    });
+    buildNodeHeights();
+}
+
+void Terrain::buildNodeHeights() {
+    nodeHeights.assign(LODLevels, {});
+
+    // Leaves scan their samples, edges included since neighbours share them
+    int leaves = 1 << (LODLevels - 1);
+    std::vector<glm::vec2>& leafHeights = nodeHeights[0];
+    leafHeights.resize(static_cast<size_t>(leaves) * leaves);
+    for (int nodeZ = 0; nodeZ < leaves; ++nodeZ) {
+        for (int nodeX = 0; nodeX < leaves; ++nodeX) {
+            glm::vec2 range(heights[nodeZ * GridResolution * samples + nodeX * GridResolution]);
+            for (int z = 0; z <= GridResolution; ++z) {
+                const float* row = &heights[(nodeZ * GridResolution + z) * samples + nodeX * GridResolution];
+                for (int x = 0; x <= GridResolution; ++x) {
+                    range.x = std::min(range.x, row[x]);
+                    range.y = std::max(range.y, row[x]);
+                }
+            }
+            leafHeights[nodeZ * leaves + nodeX] = range;
+        }
+    }
+
+    // Parents combine their four children
+    for (int level = 1; level < LODLevels; ++level) {
+        int count = leaves >> level;
+        const std::vector<glm::vec2>& children = nodeHeights[level - 1];
+        std::vector<glm::vec2>& parents = nodeHeights[level];
+        parents.resize(static_cast<size_t>(count) * count);
+        for (int nodeZ = 0; nodeZ < count; ++nodeZ) {
+            for (int nodeX = 0; nodeX < count; ++nodeX) {
+                glm::vec2 range = children[(nodeZ * 2) * count * 2 + nodeX * 2];
+                for (int child = 1; child < 4; ++child) {
+                    const glm::vec2& other = children[(nodeZ * 2 + child / 2) * count * 2 + nodeX * 2 + child % 2];
+                    range.x = std::min(range.x, other.x);
+                    range.y = std::max(range.y, other.y);
+                }
+                parents[nodeZ * count + nodeX] = range;
+            }
+        }
+    }
+}
+
+bool Terrain::initialize() {
+    if (heights.empty()) {
+        std::cerr << "Terrain: generate must be called before initialize\n";
+        return false;
+    }
+
+    glGenTextures(1, &heightTexture);
+    glBindTexture(GL_TEXTURE_2D, heightTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, samples, samples, 0, GL_RED, GL_FLOAT, heights.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Shared grid: (u, v) in [0, 1], the vertex shader places and displaces it per node
+    std::vector<glm::vec2> grid;
+    grid.reserve((GridResolution + 1) * (GridResolution + 1));
+    for (int v = 0; v <= GridResolution; ++v) {
+        for (int u = 0; u <= GridResolution; ++u)
+            grid.emplace_back(static_cast<float>(u) / GridResolution, static_cast<float>(v) / GridResolution);
+    }
+    std::vector<unsigned int> indices;
+    indices.reserve(GridResolution * GridResolution * 6);
+    for (int v = 0; v < GridResolution; ++v) {
+        for (int u = 0; u < GridResolution; ++u) {
+            unsigned int i00 = v * (GridResolution + 1) + u, i10 = i00 + 1;
+            unsigned int i01 = i00 + GridResolution + 1, i11 = i01 + 1;
+            // Counter-clockwise seen from above
+            indices.insert(indices.end(), { i01, i11, i10, i01, i10, i00 });
+        }
+    }
+    gridIndexCount = static_cast<GLsizei>(indices.size());
+
+    glGenVertexArrays(1, &gridVAO);
+    glGenBuffers(1, &gridVBO);
+    glGenBuffers(1, &gridEBO);
+    glGenBuffers(1, &nodeVBO);
+
+    glBindVertexArray(gridVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, gridVBO);
+    glBufferData(GL_ARRAY_BUFFER, grid.size() * sizeof(glm::vec2), grid.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(PositionLocation);
+    glVertexAttribPointer(PositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gridEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, nodeVBO);
+    glEnableVertexAttribArray(TerrainNodeLocation);
+    glVertexAttribPointer(TerrainNodeLocation, 4, GL_FLOAT, GL_FALSE, sizeof(TerrainNode), nullptr);
+    glVertexAttribDivisor(TerrainNodeLocation, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void Terrain::cleanup() {
+    glDeleteTextures(1, &heightTexture);
+    glDeleteVertexArrays(1, &gridVAO);
+    glDeleteBuffers(1, &gridVBO);
+    glDeleteBuffers(1, &gridEBO);
+    glDeleteBuffers(1, &nodeVBO);
+    heightTexture = gridVAO = gridVBO = gridEBO = nodeVBO = 0;
+    nodeCapacity = 0;
+}
+
+float Terrain::getHeight(float x, float z) const {
+    if (heights.empty())
+        return 0.0f;
+    float fx = glm::clamp((x - origin.x) / spacing, 0.0f, static_cast<float>(samples - 1));
+    float fz = glm::clamp((z - origin.y) / spacing, 0.0f, static_cast<float>(samples - 1));
+    int x0 = std::min(static_cast<int>(fx), samples - 2);
+    int z0 = std::min(static_cast<int>(fz), samples - 2);
+    fx -= x0;
+    fz -= z0;
+    const float* row = &heights[z0 * samples + x0];
+    return glm::mix(glm::mix(row[0], row[1], fx), glm::mix(row[samples], row[samples + 1], fx), fz);
+}
+
+void Terrain::select(const Frustum& frustum, const glm::vec3& cameraPosition, std::vector<TerrainNode>& nodes) const {
+    nodes.clear();
+    if (nodeHeights.empty())
+        return;
+    // The root always covers whatever its children could not
+    if (!selectNode(LODLevels - 1, 0, 0, frustum, cameraPosition, nodes)) {
+        glm::vec3 boundsMin, boundsMax;
+        nodeBounds(LODLevels - 1, 0, 0, boundsMin, boundsMax);
+        if (frustum.intersectsBox(boundsMin, boundsMax))
+            nodes.push_back({ origin.x, origin.y, extent, static_cast<float>(LODLevels - 1) });
+    }
+}
+
+bool Terrain::selectNode(int level, int nodeX, int nodeZ, const Frustum& frustum, const glm::vec3& cameraPosition,
+    std::vector<TerrainNode>& nodes) const {
+    glm::vec3 boundsMin, boundsMax;
+    nodeBounds(level, nodeX, nodeZ, boundsMin, boundsMax);
+
+    if (!sphereIntersectsBox(cameraPosition, lodRanges[level], boundsMin, boundsMax))
+        return false;
+    if (!frustum.intersectsBox(boundsMin, boundsMax))
+        return true; // Handled: nothing to draw
+
+    float size = boundsMax.x - boundsMin.x;
+    if (level == 0 || !sphereIntersectsBox(cameraPosition, lodRanges[level - 1], boundsMin, boundsMax)) {
+        nodes.push_back({ boundsMin.x, boundsMin.z, size, static_cast<float>(level) });
+        return true;
+    }
+
+    // Children closer than their range refine further, the rest is drawn as a quarter of this node:
+    // child size, this level, and the vertex shader snaps it to this level's grid spacing
+    for (int child = 0; child < 4; ++child) {
+        int childX = nodeX * 2 + child % 2, childZ = nodeZ * 2 + child / 2;
+        if (!selectNode(level - 1, childX, childZ, frustum, cameraPosition, nodes)) {
+            glm::vec3 childMin, childMax;
+            nodeBounds(level - 1, childX, childZ, childMin, childMax);
+            if (frustum.intersectsBox(childMin, childMax))
+                nodes.push_back({ childMin.x, childMin.z, size * 0.5f, static_cast<float>(level) });
+        }
+    }
+    return true;
+}
+
+void Terrain::nodeBounds(int level, int nodeX, int nodeZ, glm::vec3& boundsMin, glm::vec3& boundsMax) const {
+    float size = spacing * (GridResolution << level);
+    const glm::vec2& range = nodeHeights[level][nodeZ * ((1 << (LODLevels - 1)) >> level) + nodeX];
+    boundsMin = glm::vec3(origin.x + nodeX * size, range.x, origin.y + nodeZ * size);
+    boundsMax = glm::vec3(boundsMin.x + size, range.y, boundsMin.z + size);
+}
+
+bool Terrain::sphereIntersectsBox(const glm::vec3& center, float radius, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    glm::vec3 closest = glm::clamp(center, boundsMin, boundsMax);
+    glm::vec3 offset = center - closest;
+    return glm::dot(offset, offset) <= radius * radius;
+}
+
+void Terrain::draw(const ShaderProgram& program, const std::vector<TerrainNode>& nodes, const glm::vec3& cameraPosition) {
+    if (nodes.empty() || !gridVAO)
+        return;
+
+    // Orphan and refill, same as the renderer's instance streams
+    size_t bytes = nodes.size() * sizeof(TerrainNode);
+    glBindBuffer(GL_ARRAY_BUFFER, nodeVBO);
+    if (bytes > nodeCapacity)
+        nodeCapacity = std::max(bytes, nodeCapacity * 2);
+    glBufferData(GL_ARRAY_BUFFER, nodeCapacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, nodes.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Morph over the last part of each level's range
+    glm::vec2 morphRanges[LODLevels];
+    float previous = 0.0f;
+    for (int level = 0; level < LODLevels; ++level) {
+        morphRanges[level] = glm::vec2(glm::mix(previous, lodRanges[level], 1.0f - MorphRegion), lodRanges[level]);
+        previous = lodRanges[level];
+    }
+
+    glUniform1i(program.getUniformLocation("heightmap"), HeightTextureUnit);
+    glUniform4f(program.getUniformLocation("heightmapArea"), origin.x, origin.y, 1.0f / extent, static_cast<float>(samples));
+    glUniform1f(program.getUniformLocation("sampleSpacing"), spacing);
+    glUniform1f(program.getUniformLocation("gridResolution"), static_cast<float>(GridResolution));
+    glUniform2fv(program.getUniformLocation("morphRanges"), LODLevels, glm::value_ptr(morphRanges[0]));
+    glUniform3fv(program.getUniformLocation("cameraPosition"), 1, glm::value_ptr(cameraPosition));
+
+    glActiveTexture(GL_TEXTURE0 + HeightTextureUnit);
+    glBindTexture(GL_TEXTURE_2D, heightTexture);
+    glBindVertexArray(gridVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, gridIndexCount, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(nodes.size()));
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+}
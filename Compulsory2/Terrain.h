@@ -0,0 +1,81 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "Components.h"
+#include "Frustum.h"
+#include "ShaderHelper.h"
+
+// One selected quadtree node, drawn as an instance of the shared grid mesh
+struct TerrainNode {
+    float x, z;  // World-space corner with the smallest coordinates
+    float size;  // Side length
+    float level; // LOD level, 0 is the finest
+};
+
+// Heightmap terrain rendered with CDLOD (Strugar): a quadtree over the heightmap picks nodes by distance to
+// the camera, every node is the same grid mesh with heights fetched in the vertex shader, and vertices morph
+// towards the next coarser grid before a LOD switch so there are no seams or pops.
+// The number of nodes drawn depends on the view ranges and the frustum, not on the size of the heightmap.
+class Terrain {
+public:
+    static const int GridResolution = 32; // Quads per side of the shared grid mesh and of a leaf node
+    static const int LODLevels = 6;       // Leaf nodes at level 0, the root at LODLevels - 1, matches morphRanges in Terrain.vs
+
+    // The heightmap covers a square of side spacing * GridResolution << (LODLevels - 1) centered on the origin
+    explicit Terrain(float spacing = 1.0f);
+
+    // Rolling hills from seed, flattened to flatHeight inside the square |x|, |z| < flatExtent
+    void generate(unsigned int seed, float flatExtent, float flatHeight);
+
+    // GL resources, call after generate
+    bool initialize();
+    void cleanup();
+
+    // Bilinear height at a world position, clamped at the edges. O(1), safe to call from gameplay code.
+    float getHeight(float x, float z) const;
+    float getHeight(const Position& position) const { return getHeight(position.x, position.z); }
+
+    // Quadtree nodes to draw this frame, culled against frustum and chosen by distance to cameraPosition
+    void select(const Frustum& frustum, const glm::vec3& cameraPosition, std::vector<TerrainNode>& nodes) const;
+
+    // Draws nodes with program, which must already be in use with the camera uniforms set
+    void draw(const ShaderProgram& program, const std::vector<TerrainNode>& nodes, const glm::vec3& cameraPosition);
+
+    size_t getTrianglesPerNode() const { return GridResolution * GridResolution * 2; }
+
+private:
+    float spacing;
+    int samples;          // Per side, one more than the quads it spans
+    float extent;         // World-space side length
+    glm::vec2 origin;     // World position of sample (0, 0)
+    std::vector<float> heights;
+
+    // Min/max height of every node, per level from the leaves up, row-major
+    std::vector<std::vector<glm::vec2>> nodeHeights;
+
+    // Distance each level is drawn up to, its vertices morph over the last part of it
+    float lodRanges[LODLevels];
+
+    GLuint heightTexture{ 0 };
+    GLuint gridVAO{ 0 }, gridVBO{ 0 }, gridEBO{ 0 };
+    GLuint nodeVBO{ 0 };
+    size_t nodeCapacity{ 0 }; // Bytes
+    GLsizei gridIndexCount{ 0 };
+
+    static const GLuint HeightTextureUnit = 3; // After the light buffer textures
+
+    void buildNodeHeights();
+
+    // False when the node is out of range for level and its parent has to cover it
+    bool selectNode(int level, int nodeX, int nodeZ, const Frustum& frustum, const glm::vec3& cameraPosition,
+        std::vector<TerrainNode>& nodes) const;
+
+    void nodeBounds(int level, int nodeX, int nodeZ, glm::vec3& boundsMin, glm::vec3& boundsMax) const;
+
+    static bool sphereIntersectsBox(const glm::vec3& center, float radius, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+};
+
+#endif
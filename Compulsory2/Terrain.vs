@@ -0,0 +1,63 @@
+#version 330 core
+layout (location = 0) in vec2 aGrid;  // Shared grid vertex in [0, 1]
+layout (location = 10) in vec4 aNode; // Per-node corner (x, z), size and LOD level
+
+out vec3 ourColor;
+out vec3 worldPosition;
+out vec3 worldNormal;
+out float viewDepth;
+flat out int viewIndex;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+uniform sampler2D heightmap;
+uniform vec4 heightmapArea;  // Origin (x, z), 1 / side length, samples per side
+uniform float sampleSpacing;
+uniform float gridResolution; // Quads per grid side
+uniform vec2 morphRanges[6];  // Per level: distance where morphing starts and where it completes
+uniform vec3 cameraPosition;
+uniform int currentView; // Split-screen view, terrain is selected and drawn per view
+
+float sampleHeight(vec2 world) {
+    // Texel centers sit on the samples
+    vec2 uv = (world - heightmapArea.xy) * heightmapArea.z * ((heightmapArea.w - 1.0) / heightmapArea.w) + 0.5 / heightmapArea.w;
+    return textureLod(heightmap, uv, 0.0).r;
+}
+
+void main() {
+    // Quarter nodes have twice the vertices their level needs, the extra ones collapse onto the level's grid
+    float levelSize = gridResolution * sampleSpacing * exp2(aNode.w);
+    float stride = levelSize / aNode.z;
+    vec2 grid = floor(floor(aGrid * gridResolution + 0.5) / stride) * stride;
+
+    vec2 world = aNode.xy + grid / gridResolution * aNode.z;
+    float height = sampleHeight(world);
+
+    // Odd vertices of the level's grid slide onto the next coarser grid as the node nears its range limit
+    vec2 range = morphRanges[int(aNode.w)];
+    float morph = clamp((distance(cameraPosition, vec3(world.x, height, world.y)) - range.x) / (range.y - range.x), 0.0, 1.0);
+    vec2 odd = mod(grid, 2.0 * stride);
+    world -= odd / gridResolution * aNode.z * morph;
+    height = sampleHeight(world);
+
+    // Central differences at the resolution of this node's grid
+    float step = max(aNode.z / gridResolution, sampleSpacing);
+    float left = sampleHeight(world - vec2(step, 0.0));
+    float right = sampleHeight(world + vec2(step, 0.0));
+    float back = sampleHeight(world - vec2(0.0, step));
+    float front = sampleHeight(world + vec2(0.0, step));
+    worldNormal = normalize(vec3(left - right, 2.0 * step, back - front));
+
+    // Grass on the flats, rock on the slopes
+    vec3 grass = vec3(0.3, 0.5, 0.22);
+    vec3 rock = vec3(0.45, 0.42, 0.38);
+    ourColor = mix(rock, grass, smoothstep(0.6, 0.85, worldNormal.y));
+
+    vec4 worldPos = vec4(world.x, height, world.y, 1.0);
+    worldPosition = worldPos.xyz;
+    vec4 viewPos = view * worldPos;
+    viewDepth = -viewPos.z;
+    gl_Position = projection * viewPos;
+    viewIndex = currentView;
+}
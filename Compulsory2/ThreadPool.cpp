@@ -0,0 +1,79 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+ThreadPool::ThreadPool(size_t workerCount) {
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0)
+        return;
+    if (workers.empty() || count == 1) {
+        fn(0, count);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    job = &fn;
+    jobCount = count;
+    // A few chunks per thread so uneven ranges still balance
+    chunkTotal = std::min(count, getThreadCount() * 4);
+    chunkSize = (count + chunkTotal - 1) / chunkTotal;
+    chunkTotal = (count + chunkSize - 1) / chunkSize;
+    nextChunk = 0;
+    chunksFinished = 0;
+    ++generation;
+    wake.notify_all();
+
+    runChunks(lock);
+    done.wait(lock, [this] { return chunksFinished == chunkTotal; });
+    job = nullptr;
+}
+
+size_t ThreadPool::runChunks(std::unique_lock<std::mutex>& lock) {
+    size_t ran = 0;
+    while (job && nextChunk < chunkTotal) {
+        size_t chunk = nextChunk++;
+        const std::function<void(size_t, size_t)>& fn = *job;
+        size_t begin = chunk * chunkSize;
+        size_t end = std::min(jobCount, begin + chunkSize);
+
+        lock.unlock();
+        fn(begin, end);
+        lock.lock();
+
+        ++ran;
+        if (++chunksFinished == chunkTotal)
+            done.notify_all();
+    }
+    return ran;
+}
+
+void ThreadPool::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    unsigned int seen = generation;
+    while (true) {
+        wake.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping)
+            return;
+        seen = generation;
+        runChunks(lock);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker threads for splitting per-frame loops, the calling thread takes a share too
+class ThreadPool {
+public:
+    static ThreadPool& instance();
+
+    explicit ThreadPool(size_t workerCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Calls fn(begin, end) on disjoint ranges covering [0, count) and returns once all of them finished
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn);
+
+    // Workers plus the calling thread
+    size_t getThreadCount() const { return workers.size() + 1; }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    // Current job, guarded by mutex
+    const std::function<void(size_t, size_t)>* job{ nullptr };
+    size_t jobCount{ 0 };
+    size_t chunkSize{ 0 };
+    size_t nextChunk{ 0 };
+    size_t chunkTotal{ 0 };
+    size_t chunksFinished{ 0 };
+    unsigned int generation{ 0 };
+    bool stopping{ false };
+
+    void workerLoop();
+    // Claims chunks of the current job until none are left, returns how many it ran
+    size_t runChunks(std::unique_lock<std::mutex>& lock);
+};
+
+#endif
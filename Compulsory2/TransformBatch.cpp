@@ -0,0 +1,223 @@
+#include "TransformBatch.h"
+#include <cmath>
+#include <cstddef>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define TRANSFORM_BATCH_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TRANSFORM_BATCH_AVX2
+#else
+#include <cpuid.h>
+#define TRANSFORM_BATCH_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+static_assert(offsetof(InstanceData, model1) == offsetof(InstanceData, model0) + 4 * sizeof(float) &&
+    offsetof(InstanceData, model2) == offsetof(InstanceData, model0) + 8 * sizeof(float) &&
+    offsetof(InstanceData, model3) == offsetof(InstanceData, model0) + 12 * sizeof(float),
+    "Matrix columns are stored as 16 consecutive floats");
+
+namespace {
+    float* columnPointer(InstanceData& instance, size_t column) {
+        return &instance.model0.x + column * 4;
+    }
+
+    // Rotation part of the matrix, column major
+    struct Rotation {
+        float m[9];
+    };
+
+    Rotation rotationAt(const TransformSoA& input, size_t i) {
+        if (input.qx) {
+            float x = input.qx[i], y = input.qy[i], z = input.qz[i], w = input.qw[i];
+            return { {
+                1.f - 2.f * (y * y + z * z), 2.f * (x * y + w * z), 2.f * (x * z - w * y),
+                2.f * (x * y - w * z), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + w * x),
+                2.f * (x * z + w * y), 2.f * (y * z - w * x), 1.f - 2.f * (x * x + y * y) } };
+        }
+        if (input.yaw) {
+            float c = std::cos(input.yaw[i]), s = std::sin(input.yaw[i]);
+            return { { c, 0.f, -s, 0.f, 1.f, 0.f, s, 0.f, c } };
+        }
+        return { { 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f } };
+    }
+}
+
+void TransformBatch::composeScalar(const TransformSoA& input, size_t first, size_t count, InstanceData* output, ColorRGBA8 color) {
+    for (size_t i = first; i < first + count; ++i) {
+        Rotation r = rotationAt(input, i);
+        float sx = 1.f, sy = 1.f, sz = 1.f;
+        if (input.sx) {
+            sx = input.sx[i];
+            sy = input.sy[i];
+            sz = input.sz[i];
+        }
+        else if (input.scale) {
+            sx = sy = sz = input.scale[i];
+        }
+
+        InstanceData& instance = output[i];
+        instance.model0 = glm::vec4(r.m[0] * sx, r.m[1] * sx, r.m[2] * sx, 0.f);
+        instance.model1 = glm::vec4(r.m[3] * sy, r.m[4] * sy, r.m[5] * sy, 0.f);
+        instance.model2 = glm::vec4(r.m[6] * sz, r.m[7] * sz, r.m[8] * sz, 0.f);
+        instance.model3 = glm::vec4(input.x[i], input.y ? input.y[i] : 0.f, input.z[i], 1.f);
+        instance.color = input.colors ? input.colors[i] : color;
+    }
+}
+
+#ifdef TRANSFORM_BATCH_X86
+
+bool TransformBatch::hasAVX2() {
+    static const bool supported = [] {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+            return false; // OS does not save YMM registers
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }();
+    return supported;
+}
+
+namespace {
+    // sin and cos of 8 angles: Cody-Waite reduction to [-pi/4, pi/4] and minimax polynomials (Cephes sinf/cosf)
+    TRANSFORM_BATCH_AVX2 void sinCos8(__m256 x, __m256& sinOut, __m256& cosOut) {
+        __m256 quadrant = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(0.63661977236f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(quadrant, _mm256_set1_ps(1.5703125f)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(quadrant, _mm256_set1_ps(4.837512969970703125e-4f)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(quadrant, _mm256_set1_ps(7.54978995489188216e-8f)));
+        __m256 r2 = _mm256_mul_ps(r, r);
+
+        __m256 s = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-1.9515295891e-4f), r2), _mm256_set1_ps(8.3321608736e-3f));
+        s = _mm256_add_ps(_mm256_mul_ps(s, r2), _mm256_set1_ps(-1.6666654611e-1f));
+        s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(s, r2), r), r);
+
+        __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.443315711809948e-5f), r2), _mm256_set1_ps(-1.388731625493765e-3f));
+        c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(4.166664568298827e-2f));
+        c = _mm256_mul_ps(_mm256_mul_ps(c, r2), r2);
+        c = _mm256_add_ps(_mm256_sub_ps(c, _mm256_mul_ps(r2, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.f));
+
+        // Odd quadrants swap sin and cos, quadrants 2-3 negate sin, 1-2 negate cos
+        __m256i q = _mm256_cvtps_epi32(quadrant);
+        __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+        __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, _mm256_set1_epi32(2)), 30));
+        __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+
+        sinOut = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sinSign);
+        cosOut = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosSign);
+    }
+
+    // Transposes one matrix column of 8 objects and stores it to each object's InstanceData
+    TRANSFORM_BATCH_AVX2 void storeColumn8(InstanceData* output, size_t column, __m256 x, __m256 y, __m256 z, __m256 w) {
+        __m256 t0 = _mm256_unpacklo_ps(x, y);
+        __m256 t1 = _mm256_unpackhi_ps(x, y);
+        __m256 t2 = _mm256_unpacklo_ps(z, w);
+        __m256 t3 = _mm256_unpackhi_ps(z, w);
+        __m256 lanes[4] = {
+            _mm256_shuffle_ps(t0, t2, 0x44), // Objects 0 and 4
+            _mm256_shuffle_ps(t0, t2, 0xEE), // 1 and 5
+            _mm256_shuffle_ps(t1, t3, 0x44), // 2 and 6
+            _mm256_shuffle_ps(t1, t3, 0xEE)  // 3 and 7
+        };
+        for (int k = 0; k < 4; ++k) {
+            _mm_storeu_ps(columnPointer(output[k], column), _mm256_castps256_ps128(lanes[k]));
+            _mm_storeu_ps(columnPointer(output[k + 4], column), _mm256_extractf128_ps(lanes[k], 1));
+        }
+    }
+
+    TRANSFORM_BATCH_AVX2 void composeAVX2(const TransformSoA& input, size_t count, InstanceData* output, ColorRGBA8 color) {
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.f);
+        const __m256 two = _mm256_set1_ps(2.f);
+
+        for (size_t i = 0; i < count; i += 8) {
+            __m256 r00 = one, r01 = zero, r02 = zero;
+            __m256 r10 = zero, r11 = one, r12 = zero;
+            __m256 r20 = zero, r21 = zero, r22 = one;
+
+            if (input.qx) {
+                __m256 x = _mm256_loadu_ps(input.qx + i), y = _mm256_loadu_ps(input.qy + i);
+                __m256 z = _mm256_loadu_ps(input.qz + i), w = _mm256_loadu_ps(input.qw + i);
+                __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+                __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+                __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+                r00 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz)));
+                r01 = _mm256_mul_ps(two, _mm256_add_ps(xy, wz));
+                r02 = _mm256_mul_ps(two, _mm256_sub_ps(xz, wy));
+                r10 = _mm256_mul_ps(two, _mm256_sub_ps(xy, wz));
+                r11 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz)));
+                r12 = _mm256_mul_ps(two, _mm256_add_ps(yz, wx));
+                r20 = _mm256_mul_ps(two, _mm256_add_ps(xz, wy));
+                r21 = _mm256_mul_ps(two, _mm256_sub_ps(yz, wx));
+                r22 = _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy)));
+            }
+            else if (input.yaw) {
+                __m256 s, c;
+                sinCos8(_mm256_loadu_ps(input.yaw + i), s, c);
+                r00 = c;
+                r02 = _mm256_sub_ps(zero, s);
+                r20 = s;
+                r22 = c;
+            }
+
+            if (input.sx) {
+                __m256 sx = _mm256_loadu_ps(input.sx + i), sy = _mm256_loadu_ps(input.sy + i), sz = _mm256_loadu_ps(input.sz + i);
+                r00 = _mm256_mul_ps(r00, sx); r01 = _mm256_mul_ps(r01, sx); r02 = _mm256_mul_ps(r02, sx);
+                r10 = _mm256_mul_ps(r10, sy); r11 = _mm256_mul_ps(r11, sy); r12 = _mm256_mul_ps(r12, sy);
+                r20 = _mm256_mul_ps(r20, sz); r21 = _mm256_mul_ps(r21, sz); r22 = _mm256_mul_ps(r22, sz);
+            }
+            else if (input.scale) {
+                __m256 s = _mm256_loadu_ps(input.scale + i);
+                r00 = _mm256_mul_ps(r00, s); r01 = _mm256_mul_ps(r01, s); r02 = _mm256_mul_ps(r02, s);
+                r10 = _mm256_mul_ps(r10, s); r11 = _mm256_mul_ps(r11, s); r12 = _mm256_mul_ps(r12, s);
+                r20 = _mm256_mul_ps(r20, s); r21 = _mm256_mul_ps(r21, s); r22 = _mm256_mul_ps(r22, s);
+            }
+
+            __m256 tx = _mm256_loadu_ps(input.x + i);
+            __m256 ty = input.y ? _mm256_loadu_ps(input.y + i) : zero;
+            __m256 tz = _mm256_loadu_ps(input.z + i);
+
+            InstanceData* out = output + i;
+            storeColumn8(out, 0, r00, r01, r02, zero);
+            storeColumn8(out, 1, r10, r11, r12, zero);
+            storeColumn8(out, 2, r20, r21, r22, zero);
+            storeColumn8(out, 3, tx, ty, tz, one);
+            if (input.colors) {
+                for (int k = 0; k < 8; ++k)
+                    out[k].color = input.colors[i + k];
+            }
+            else {
+                for (int k = 0; k < 8; ++k)
+                    out[k].color = color;
+            }
+        }
+    }
+}
+
+void TransformBatch::compose(const TransformSoA& input, InstanceData* output, ColorRGBA8 color) {
+    size_t vectorCount = hasAVX2() ? input.count / 8 * 8 : 0;
+    if (vectorCount > 0)
+        composeAVX2(input, vectorCount, output, color);
+    composeScalar(input, vectorCount, input.count - vectorCount, output, color);
+}
+
+#else
+
+bool TransformBatch::hasAVX2() {
+    return false;
+}
+
+void TransformBatch::compose(const TransformSoA& input, InstanceData* output, ColorRGBA8 color) {
+    composeScalar(input, 0, input.count, output, color);
+}
+
+#endif
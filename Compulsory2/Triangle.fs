@@ -2,7 +2,54 @@
 out vec4 FragColor;
 
 in vec3 ourColor;
+in vec3 worldPosition;
+in vec3 worldNormal;
+in float viewDepth;
+flat in int viewIndex; // Split-screen view, 0 when there is only one
+
+// Distant key light, lightPos is the direction towards it
+uniform vec3 lightPos;
+uniform vec3 lightColor;
+
+// Clustered point lights, see ClusteredLighting
+uniform samplerBuffer lightData;     // Two texels per light: (position, radius), (color * intensity, 0)
+uniform usamplerBuffer clusterData;  // (first index, count) per cluster
+uniform usamplerBuffer lightIndices; // Compact light lists of all clusters
+uniform ivec3 clusterGrid;
+uniform vec2 clusterDepth[4];        // Per view: slice = log(depth) * x + y
+uniform vec4 viewports[4];           // Per view: x, y, width, height in pixels
+
+const vec3 ambient = vec3(0.25);
 
 void main() {
-    FragColor = vec4(ourColor, 1.0);
+    vec3 normal = normalize(worldNormal);
+    vec3 lighting = ambient + lightColor * max(dot(normal, normalize(lightPos)), 0.0);
+
+    // Every view has its own grid of clusters, stored one after the other
+    vec4 viewport = viewports[viewIndex];
+    vec2 slice = clusterDepth[viewIndex];
+    ivec3 cell = ivec3((gl_FragCoord.xy - viewport.xy) / viewport.zw * vec2(clusterGrid.xy), log(max(viewDepth, 1e-4)) * slice.x + slice.y);
+    cell = clamp(cell, ivec3(0), clusterGrid - 1);
+    int cluster = ((viewIndex * clusterGrid.z + cell.z) * clusterGrid.y + cell.y) * clusterGrid.x + cell.x;
+    uvec2 range = texelFetch(clusterData, cluster).xy;
+
+    for (uint i = 0u; i < range.y; ++i) {
+        int light = int(texelFetch(lightIndices, int(range.x + i)).r);
+        vec4 positionRadius = texelFetch(lightData, light * 2);
+        vec3 color = texelFetch(lightData, light * 2 + 1).rgb;
+
+        vec3 toLight = positionRadius.xyz - worldPosition;
+        float distanceSquared = dot(toLight, toLight);
+        float radiusSquared = positionRadius.w * positionRadius.w;
+        if (distanceSquared >= radiusSquared)
+            continue;
+
+        // Inverse square falloff windowed to reach exactly zero at the radius
+        float window = 1.0 - distanceSquared / radiusSquared;
+        float attenuation = window * window / (1.0 + distanceSquared);
+        float diffuse = max(dot(normal, toLight * inversesqrt(max(distanceSquared, 1e-4))), 0.0);
+        lighting += color * attenuation * diffuse;
+    }
+
+    FragColor = vec4(ourColor * lighting, 1.0);
 }
@@ -1,14 +1,38 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;   // Vertex position
-layout (location = 1) in vec3 aColor; // Vertex color
+layout (location = 0) in vec3 aPos;           // Vertex position
+layout (location = 1) in vec4 aColor;         // Vertex color, white for formats without one
+layout (location = 2) in vec3 aNormal;        // Vertex normal
+layout (location = 3) in vec4 aInstanceColor; // Per-instance color
+layout (location = 4) in mat4 aModel;         // Per-instance model matrix, locations 4-7
+layout (location = 8) in vec2 aPositionXZ;    // Per-instance ECS position, (0, 0) on the matrix path
+layout (location = 9) in float aScale;        // Per-instance scale, 1 on the matrix path
+layout (location = 11) in uint aHiddenViews;  // Per-instance bit per split-screen view that culled it, 0 when not streamed
 
 out vec3 ourColor;
+out vec3 worldPosition;
+out vec3 worldNormal;
+out float viewDepth;  // Distance in front of the camera, selects the cluster slice
+flat out int viewIndex;
+
+uniform int currentView; // Split-screen view drawn one at a time, -1 for a single view
 
-uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
 void main() {
-    ourColor = aColor;
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    ourColor = aColor.rgb * aInstanceColor.rgb;
+    // Either aModel carries the whole transform or it is identity and the top-down stream does
+    vec4 worldPos = aModel * vec4(aPos * aScale, 1.0) + vec4(aPositionXZ.x, 0.0, aPositionXZ.y, 0.0);
+    // Exact for rotation and uniform scale, which is all the scene uses
+    worldNormal = mat3(aModel) * aNormal;
+    worldPosition = worldPos.xyz;
+
+    vec4 viewPos = view * worldPos;
+    viewDepth = -viewPos.z;
+    gl_Position = projection * viewPos;
+
+    // Instances the view culled are moved outside the clip volume
+    viewIndex = max(currentView, 0);
+    if (currentView >= 0 && (aHiddenViews & (1u << uint(currentView))) != 0u)
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
 }
@@ -38,6 +38,10 @@ void UIManager::endFrame() {
 
 void UIManager::render() {
     buildUI();
+    if (dynamicResolution || framePacer || multiViewStats)
+        buildRenderingUI();
+    if (GLTrace::isInstalled())
+        buildGLTraceUI();
 }
 
 void UIManager::buildUI() {
@@ -96,3 +100,93 @@ void UIManager::buildUI() {
     }
     ImGui::End();
 }
+
+void UIManager::buildRenderingUI() {
+    ImGui::SetNextWindowPos(ImVec2(10, 170), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(300, 330), ImGuiCond_FirstUseEver);
+    ImGui::Begin("Rendering");
+
+    if (dynamicResolution) {
+        // Metrics
+        ImGuiIO& io = ImGui::GetIO();
+        float scale = dynamicResolution->getScale();
+        ImGui::Text("GPU frame: %.2f ms (last %.2f ms)", dynamicResolution->getGpuTimeMs(), dynamicResolution->getLastGpuTimeMs());
+        ImGui::Text("Render scale: %.0f%% (%.0f x %.0f)", scale * 100.0f,
+            io.DisplaySize.x * io.DisplayFramebufferScale.x * scale, io.DisplaySize.y * io.DisplayFramebufferScale.y * scale);
+
+        // Settings
+        ImGui::Separator();
+        ImGui::Checkbox("Dynamic resolution", &dynamicResolution->enabled);
+        ImGui::SliderFloat("Target (ms)", &dynamicResolution->targetMs, 4.0f, 50.0f, "%.1f");
+        ImGui::SliderFloat("Min scale", &dynamicResolution->minScale, 0.25f, 1.0f, "%.2f");
+        ImGui::SliderFloat("Max scale", &dynamicResolution->maxScale, 0.25f, 1.0f, "%.2f");
+        if (dynamicResolution->minScale > dynamicResolution->maxScale)
+            dynamicResolution->maxScale = dynamicResolution->minScale;
+    }
+
+    if (framePacer) {
+        ImGui::Separator();
+        ImGui::Text("Frames: %.0f / s of %.0f loops / s", framePacer->getFramesPerSecond(), framePacer->getLoopsPerSecond());
+        ImGui::Checkbox("Render on demand", &framePacer->onDemand);
+        ImGui::SliderFloat("Unfocused FPS", &framePacer->unfocusedFps, 0.0f, 60.0f, "%.0f");
+    }
+
+    // Split-screen: culling, upload and draws are shared, the rest is paid per view
+    if (multiViewStats && !multiViewStats->views.empty()) {
+        ImGui::Separator();
+        ImGui::Text("Views: %zu, %s", multiViewStats->views.size(), multiViewStats->singlePass ? "single pass" : "one pass per view");
+        ImGui::Text("Shared: %u draws, %u instances, %zu cull tests", multiViewStats->drawCalls, multiViewStats->instances, multiViewStats->cullTests);
+        ImGui::Text("Scene CPU: %.2f ms", multiViewStats->cpuMs);
+        for (size_t v = 0; v < multiViewStats->views.size(); ++v) {
+            const ViewStats& view = multiViewStats->views[v];
+            ImGui::Text("P%zu: %u inst, %zu tris, %zu nodes, %zu lights", v + 1, view.instances, view.triangles, view.terrainNodes, view.visibleLights);
+        }
+        if (singlePassViews)
+            ImGui::Checkbox("Single-pass views", singlePassViews);
+    }
+    ImGui::End();
+}
+
+void UIManager::buildGLTraceUI() {
+    ImGui::SetNextWindowPos(ImVec2(320, 10), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(320, 330), ImGuiCond_FirstUseEver);
+    ImGui::Begin("GL Calls");
+
+    // Totals of the last finished frame
+    const GLFrameStats& stats = GLTrace::getLastFrame();
+    ImGui::Text("Frame %zu: %zu calls", stats.frame, stats.calls);
+    ImGui::Text("Draws: %zu, program binds: %zu", stats.drawCalls, stats.programBinds);
+    ImGui::Text("Uniform writes: %zu, binds: %zu", stats.uniformWrites, stats.bindCalls);
+    ImGui::Text("Uploaded: %.1f KB", stats.bytesUploaded / 1024.0f);
+
+    if (ImGui::CollapsingHeader("Entry points")) {
+        for (const std::pair<const char*, size_t>& entry : stats.entryPoints)
+            ImGui::Text("%6zu  %s", entry.second, entry.first);
+    }
+    if (ImGui::CollapsingHeader("Uploads per target")) {
+        for (const std::pair<unsigned int, size_t>& entry : stats.bytesPerTarget)
+            ImGui::Text("%8.1f KB  %s", entry.second / 1024.0f, GLTrace::getTargetName(entry.first));
+    }
+    if (ImGui::CollapsingHeader("Draws per program")) {
+        for (const std::pair<unsigned int, size_t>& entry : stats.drawsPerProgram)
+            ImGui::Text("%6zu  program %u", entry.second, entry.first);
+    }
+
+    // Files go next to the executable
+    ImGui::Separator();
+    if (ImGui::Button("Export stats"))
+        GLTrace::exportStats("gl_stats.txt");
+    ImGui::SameLine();
+    if (GLTrace::isRecordingFrame())
+        ImGui::TextUnformatted("Recording...");
+    else if (ImGui::Button("Record frame"))
+        GLTrace::recordFrame("gl_frame.txt");
+    bool logging = GLTrace::isLogging();
+    if (ImGui::Checkbox("Log every frame to gl_stats.csv", &logging)) {
+        if (logging)
+            GLTrace::startLog("gl_stats.csv");
+        else
+            GLTrace::stopLog();
+    }
+    ImGui::End();
+}
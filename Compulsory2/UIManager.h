@@ -6,6 +6,10 @@
 #include <GLFW/glfw3.h>
 #include "ImGui/imgui_impl_opengl3.h"
 #include "ComponentManager.h"
+#include "DynamicResolution.h"
+#include "GLTrace.h"
+#include "FramePacer.h"
+#include "MultiView.h"
 
 class UIManager {
 public:
@@ -16,10 +20,26 @@ public:
     void endFrame();
     void render();
 
+    // Adds a rendering window with the scaling settings and metrics, nullptr hides it
+    void setDynamicResolution(DynamicResolution* dynamicResolution) { this->dynamicResolution = dynamicResolution; }
+    // Adds the render on demand settings to the same window
+    void setFramePacer(FramePacer* framePacer) { this->framePacer = framePacer; }
+    // Adds shared and per-view split-screen costs, singlePassViews becomes a toggle when given
+    void setMultiViewStats(const MultiViewStats* multiViewStats, bool* singlePassViews = nullptr) {
+        this->multiViewStats = multiViewStats;
+        this->singlePassViews = singlePassViews;
+    }
+
 private:
     GLFWwindow* window;
     ComponentManager& componentManager;
     unsigned int playerEntity;
+    DynamicResolution* dynamicResolution{ nullptr };
+    FramePacer* framePacer{ nullptr };
+    const MultiViewStats* multiViewStats{ nullptr };
+    bool* singlePassViews{ nullptr };
 
     void buildUI();
+    void buildRenderingUI();
+    void buildGLTraceUI();
 };
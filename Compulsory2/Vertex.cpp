@@ -1 +1,25 @@
 #include "Vertex.h"
+#include <glm/gtc/packing.hpp>
+#include <cstring>
+
+HalfVec4 packPosition(const glm::vec3& position) {
+    glm::uint64 bits = glm::packHalf4x16(glm::vec4(position, 1.0f));
+    HalfVec4 packed;
+    std::memcpy(&packed, &bits, sizeof(packed));
+    return packed;
+}
+
+PackedNormal packNormal(const glm::vec3& normal) {
+    return PackedNormal{ glm::packSnorm3x10_1x2(glm::vec4(normal, 0.0f)) };
+}
+
+ColorRGBA8 packColor(const glm::vec3& color) {
+    return packColor(glm::vec4(color, 1.0f));
+}
+
+ColorRGBA8 packColor(const glm::vec4& color) {
+    glm::uint32 bits = glm::packUnorm4x8(color);
+    ColorRGBA8 packed;
+    std::memcpy(&packed, &bits, sizeof(packed));
+    return packed;
+}
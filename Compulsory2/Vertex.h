@@ -2,16 +2,126 @@
 #define VERTEX_H
 
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include "VertexLayout.h"
+#include "Components.h"
 
 class Vertex3D {
 public:
     glm::vec3 position;
     glm::vec3 color;
+    glm::vec3 normal; // Zero when the mesh has no normals, they are then computed on upload
+
+    static constexpr VertexFormat format = VertexFormat::Float;
 
     // Default constructor
-    Vertex3D() : position(0.0f), color(0.0f) {}
+    Vertex3D() : position(0.0f), color(0.0f), normal(0.0f) {}
+
+    // Constructor for position, color and optionally normal
+    Vertex3D(const glm::vec3& pos, const glm::vec3& col, const glm::vec3& norm = glm::vec3(0.0f)) : position(pos), color(col), normal(norm) {}
+};
+
+template <> struct VertexLayout<Vertex3D> {
+    static constexpr std::array<VertexAttribute, 3> attributes() {
+        return { {
+            VERTEX_ATTRIBUTE(Vertex3D, position, PositionLocation),
+            VERTEX_ATTRIBUTE(Vertex3D, color, ColorLocation),
+            VERTEX_ATTRIBUTE(Vertex3D, normal, NormalLocation)
+        } };
+    }
+};
+static_assert(layoutMatchesVertex<Vertex3D>(), "Vertex3D layout does not match the struct");
+
+// GPU vertex for meshes with a single color, the color is supplied per instance
+struct PackedVertex {
+    HalfVec4 position;   // w is padding
+    PackedNormal normal; // snorm 10:10:10:2
+
+    static constexpr VertexFormat format = VertexFormat::Packed;
+};
+
+template <> struct VertexLayout<PackedVertex> {
+    static constexpr std::array<VertexAttribute, 2> attributes() {
+        return { {
+            VERTEX_ATTRIBUTE(PackedVertex, position, PositionLocation),
+            VERTEX_ATTRIBUTE(PackedVertex, normal, NormalLocation)
+        } };
+    }
+};
+static_assert(layoutMatchesVertex<PackedVertex>(), "PackedVertex layout does not match the struct");
+static_assert(sizeof(PackedVertex) == 12, "PackedVertex should stay 12 bytes");
+
+// GPU vertex for meshes whose color varies per vertex
+struct PackedColorVertex {
+    HalfVec4 position;
+    PackedNormal normal;
+    ColorRGBA8 color;
+
+    static constexpr VertexFormat format = VertexFormat::PackedColor;
+};
+
+template <> struct VertexLayout<PackedColorVertex> {
+    static constexpr std::array<VertexAttribute, 3> attributes() {
+        return { {
+            VERTEX_ATTRIBUTE(PackedColorVertex, position, PositionLocation),
+            VERTEX_ATTRIBUTE(PackedColorVertex, normal, NormalLocation),
+            VERTEX_ATTRIBUTE(PackedColorVertex, color, ColorLocation)
+        } };
+    }
+};
+static_assert(layoutMatchesVertex<PackedColorVertex>(), "PackedColorVertex layout does not match the struct");
+static_assert(sizeof(PackedColorVertex) == 16, "PackedColorVertex should stay 16 bytes");
+
+// Per-instance stream: model matrix columns and RGBA8 color
+struct InstanceData {
+    glm::vec4 model0, model1, model2, model3;
+    ColorRGBA8 color;
+};
+
+template <> struct VertexLayout<InstanceData> {
+    static constexpr std::array<VertexAttribute, 5> attributes() {
+        return { {
+            VERTEX_ATTRIBUTE(InstanceData, model0, InstanceModelLocation),
+            VERTEX_ATTRIBUTE(InstanceData, model1, InstanceModelLocation + 1),
+            VERTEX_ATTRIBUTE(InstanceData, model2, InstanceModelLocation + 2),
+            VERTEX_ATTRIBUTE(InstanceData, model3, InstanceModelLocation + 3),
+            VERTEX_ATTRIBUTE(InstanceData, color, InstanceColorLocation)
+        } };
+    }
+};
+static_assert(layoutMatchesVertex<InstanceData>(), "InstanceData layout does not match the struct");
+
+// Top-down instance stream: the ECS Position array is used as-is, 8 bytes per object
+template <> struct VertexLayout<Position> {
+    static constexpr std::array<VertexAttribute, 1> attributes() {
+        // x and z are adjacent floats, read together as a vec2
+        return { {
+            VertexAttribute{ InstancePositionLocation, 2, GL_FLOAT, GL_FALSE, offsetof(Position, x), 2 * sizeof(float) }
+        } };
+    }
+};
+static_assert(offsetof(Position, z) == offsetof(Position, x) + sizeof(float), "Position x and z must be adjacent");
+static_assert(layoutMatchesVertex<Position>(), "Position must be exactly x and z to be uploaded directly");
 
-    // Constructor for position and color
-    Vertex3D(const glm::vec3& pos, const glm::vec3& col) : position(pos), color(col) {}
+// Optional per-instance scale and color next to the Position stream
+struct InstanceStyle {
+    float scale;
+    ColorRGBA8 color;
 };
+
+template <> struct VertexLayout<InstanceStyle> {
+    static constexpr std::array<VertexAttribute, 2> attributes() {
+        return { {
+            VERTEX_ATTRIBUTE(InstanceStyle, scale, InstanceScaleLocation),
+            VERTEX_ATTRIBUTE(InstanceStyle, color, InstanceColorLocation)
+        } };
+    }
+};
+static_assert(layoutMatchesVertex<InstanceStyle>(), "InstanceStyle layout does not match the struct");
+
+// Quantization helpers
+HalfVec4 packPosition(const glm::vec3& position);
+PackedNormal packNormal(const glm::vec3& normal);
+ColorRGBA8 packColor(const glm::vec3& color);
+ColorRGBA8 packColor(const glm::vec4& color);
 #endif
@@ -0,0 +1,126 @@
+#ifndef VERTEX_LAYOUT_H
+#define VERTEX_LAYOUT_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Attribute locations shared by every vertex format and the shaders
+enum AttributeLocation : GLuint {
+    PositionLocation = 0,
+    ColorLocation = 1,
+    NormalLocation = 2,
+    InstanceColorLocation = 3,
+    InstanceModelLocation = 4,    // mat4, occupies locations 4-7
+    InstancePositionLocation = 8, // ECS Position (x, z), translation added after the model matrix
+    InstanceScaleLocation = 9,    // Uniform scale applied before the model matrix
+    TerrainNodeLocation = 10,     // Terrain grid instance: corner (x, z), size and LOD level
+    HiddenViewsLocation = 11      // Split-screen: uint8 with a bit per view that culled the instance
+};
+
+// Vertex formats stored in the mesh arena, one VAO each
+enum class VertexFormat {
+    Float,       // Vertex3D: float position, color and normal (36 bytes)
+    Packed,      // PackedVertex: half position + 10:10:10:2 normal (12 bytes)
+    PackedColor, // PackedColorVertex: PackedVertex + RGBA8 color (16 bytes)
+    Count
+};
+
+// Compact attribute storage types
+struct HalfVec4 { uint16_t x, y, z, w; };
+struct PackedNormal { uint32_t bits; };
+struct ColorRGBA8 { uint8_t r, g, b, a; };
+
+// Maps an attribute's C++ type to its GL description
+template <typename A> struct AttributeTraits;
+
+template <> struct AttributeTraits<float> {
+    static constexpr GLint components = 1;
+    static constexpr GLenum type = GL_FLOAT;
+    static constexpr GLboolean normalized = GL_FALSE;
+};
+
+template <> struct AttributeTraits<glm::vec3> {
+    static constexpr GLint components = 3;
+    static constexpr GLenum type = GL_FLOAT;
+    static constexpr GLboolean normalized = GL_FALSE;
+};
+
+template <> struct AttributeTraits<glm::vec4> {
+    static constexpr GLint components = 4;
+    static constexpr GLenum type = GL_FLOAT;
+    static constexpr GLboolean normalized = GL_FALSE;
+};
+
+template <> struct AttributeTraits<HalfVec4> {
+    static constexpr GLint components = 4;
+    static constexpr GLenum type = GL_HALF_FLOAT;
+    static constexpr GLboolean normalized = GL_FALSE;
+};
+
+template <> struct AttributeTraits<PackedNormal> {
+    static constexpr GLint components = 4;
+    static constexpr GLenum type = GL_INT_2_10_10_10_REV;
+    static constexpr GLboolean normalized = GL_TRUE;
+};
+
+template <> struct AttributeTraits<ColorRGBA8> {
+    static constexpr GLint components = 4;
+    static constexpr GLenum type = GL_UNSIGNED_BYTE;
+    static constexpr GLboolean normalized = GL_TRUE;
+};
+
+struct VertexAttribute {
+    GLuint location;
+    GLint components;
+    GLenum type;
+    GLboolean normalized;
+    size_t offset;
+    size_t size;
+};
+
+// Builds an attribute description straight from a struct member
+#define VERTEX_ATTRIBUTE(Type, member, location)                            \
+    VertexAttribute{ location,                                              \
+        AttributeTraits<decltype(Type::member)>::components,                \
+        AttributeTraits<decltype(Type::member)>::type,                      \
+        AttributeTraits<decltype(Type::member)>::normalized,                \
+        offsetof(Type, member), sizeof(decltype(Type::member)) }
+
+// Specialized next to each vertex type with an attributes() list built from VERTEX_ATTRIBUTE
+template <typename T> struct VertexLayout;
+
+// True when the attributes tile the struct exactly: no gaps, no overlap, no reads past the end
+template <typename T>
+constexpr bool layoutMatchesVertex() {
+    size_t covered = 0;
+    const auto attributes = VertexLayout<T>::attributes();
+    for (size_t i = 0; i < attributes.size(); ++i) {
+        if (attributes[i].offset + attributes[i].size > sizeof(T))
+            return false;
+        for (size_t j = 0; j < i; ++j) {
+            bool disjoint = attributes[i].offset >= attributes[j].offset + attributes[j].size ||
+                attributes[j].offset >= attributes[i].offset + attributes[i].size;
+            if (!disjoint)
+                return false;
+        }
+        covered += attributes[i].size;
+    }
+    return covered == sizeof(T);
+}
+
+// Points the attributes of T at the currently bound GL_ARRAY_BUFFER, divisor 1 makes them per-instance
+template <typename T>
+void applyVertexLayout(GLuint divisor = 0, size_t baseOffset = 0) {
+    const auto attributes = VertexLayout<T>::attributes();
+    for (const VertexAttribute& attribute : attributes) {
+        glEnableVertexAttribArray(attribute.location);
+        glVertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+            sizeof(T), reinterpret_cast<const void*>(baseOffset + attribute.offset));
+        glVertexAttribDivisor(attribute.location, divisor);
+    }
+}
+
+#endif
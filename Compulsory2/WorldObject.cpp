@@ -4,5 +4,16 @@
 WorldObject::WorldObject(Mesh3D& model, const glm::vec3& pos, const glm::vec3& scale, const glm::vec3& rotAxis, float rotAngle)
     : position(pos), scale(scale), rotationAxis(rotAxis), rotationAngle(rotAngle), model(model)
 {
-    ShaderHelper::setupObjects(VAO, VBO, EBO, model.getVertices(), model.getIndices());
-} 
\ No newline at end of file
+    gpuMesh = std::make_shared<GPUMesh>(model);
+    color = gpuMesh->getBaseColor();
+}
+
+WorldObject::WorldObject(const std::shared_ptr<GPUMesh>& gpuMesh, const glm::vec3& pos, const glm::vec3& scale, const glm::vec3& rotAxis, float rotAngle)
+    : position(pos), scale(scale), rotationAxis(rotAxis), rotationAngle(rotAngle), color(gpuMesh->getBaseColor()), gpuMesh(gpuMesh)
+{
+}
+
+WorldObject::WorldObject(const std::shared_ptr<GPUMeshLOD>& lod, const glm::vec3& pos, const glm::vec3& scale, const glm::vec3& rotAxis, float rotAngle)
+    : position(pos), scale(scale), rotationAxis(rotAxis), rotationAngle(rotAngle), color(lod->getLevel(0).getBaseColor()), lod(lod)
+{
+}
\ No newline at end of file
@@ -5,45 +5,35 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <memory>
 #include "Mesh.h"
+#include "MeshArena.h"
+#include "MeshLOD.h"
 
 class Renderer;
 
-enum GLObjectEnum {
-    VAOtype,
-    VBOtype,
-    EBOtype
-};
-
 class WorldObject { // Not part of ECS/DOD implementation
 public:
     glm::vec3 position;
     glm::vec3 scale;
     glm::vec3 rotationAxis; // Axis for rotation
     float rotationAngle;    // Rotation angle in euler
+    glm::vec4 color;        // Per-instance color, starts as the mesh's base color
     Mesh3D model;
 
     WorldObject(Mesh3D& model, const glm::vec3& pos = glm::vec3(0.0f), const glm::vec3& scale = glm::vec3(1.f), const glm::vec3& rotAxis = glm::vec3(0.f, 1.f, 0.f), float rotAngle = 0.0f);
 
-    virtual ~WorldObject() {
-        glDeleteVertexArrays(1, &VAO);
-        glDeleteBuffers(1, &VBO);
-        glDeleteBuffers(1, &EBO);
-    }
+    // Shares an already uploaded mesh instead of allocating a new copy in the arena
+    WorldObject(const std::shared_ptr<GPUMesh>& gpuMesh, const glm::vec3& pos = glm::vec3(0.0f), const glm::vec3& scale = glm::vec3(1.f), const glm::vec3& rotAxis = glm::vec3(0.f, 1.f, 0.f), float rotAngle = 0.0f);
 
-    GLuint getGLObject(GLObjectEnum object) const {
-        switch (object) {
-        case VAOtype:
-            return VAO;
-        case VBOtype:
-            return VBO;
-        case EBOtype:
-            return EBO;
-        default:
-            std::cerr << "Unknown GLObjectEnum value." << std::endl;
-            return 0;
-        }
-    }
+    // Draws one level of the chain, picked by projected size every frame
+    WorldObject(const std::shared_ptr<GPUMeshLOD>& lod, const glm::vec3& pos = glm::vec3(0.0f), const glm::vec3& scale = glm::vec3(1.f), const glm::vec3& rotAxis = glm::vec3(0.f, 1.f, 0.f), float rotAngle = 0.0f);
+
+    virtual ~WorldObject() = default;
+
+    // Full-detail mesh, level 0 for LOD objects
+    const MeshAllocation& getMeshAllocation() const { return lod ? lod->getLevel(0).getAllocation() : gpuMesh->getAllocation(); }
+    const std::shared_ptr<GPUMeshLOD>& getLOD() const { return lod; }
 
     glm::mat4 getModelMatrix() const {
         glm::mat4 model = glm::mat4(1.0f);
@@ -54,6 +44,7 @@ public:
     }
 
 private:
-    GLuint VAO{ 0 }, VBO{ 0 }, EBO{ 0 };
+    std::shared_ptr<GPUMesh> gpuMesh;
+    std::shared_ptr<GPUMeshLOD> lod;
 };
 #endif